@@ -0,0 +1,111 @@
+#include "graph_fixtures.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+	constexpr auto query_count = std::size_t{1024};
+} // namespace
+
+template<typename N, typename E>
+static void find(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+	auto const g = bench::make_graph(input);
+	auto const queries = bench::make_queries(input, query_count);
+
+	for (auto _ : state) {
+		for (auto const& [from, to, weight] : queries) {
+			benchmark::DoNotOptimize(g.find(from, to, weight));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(query_count));
+}
+GDWG_GRAPH_BENCHMARK(find);
+
+template<typename N, typename E>
+static void is_connected(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+	auto const g = bench::make_graph(input);
+	auto const queries = bench::make_queries(input, query_count);
+
+	for (auto _ : state) {
+		for (auto const& query : queries) {
+			benchmark::DoNotOptimize(g.is_connected(query.from, query.to));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(query_count));
+}
+GDWG_GRAPH_BENCHMARK(is_connected);
+
+template<typename N, typename E>
+static void connections(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+	auto const g = bench::make_graph(input);
+	auto const queries = bench::make_queries(input, query_count);
+
+	for (auto _ : state) {
+		for (auto const& query : queries) {
+			benchmark::DoNotOptimize(g.connections(query.from));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(query_count));
+}
+GDWG_GRAPH_BENCHMARK(connections);
+
+template<typename N, typename E>
+static void weights(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+	auto const g = bench::make_graph(input);
+	auto const queries = bench::make_queries(input, query_count);
+
+	for (auto _ : state) {
+		for (auto const& query : queries) {
+			benchmark::DoNotOptimize(g.weights(query.from, query.to));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(query_count));
+}
+GDWG_GRAPH_BENCHMARK(weights);
+
+// Same queries as connections and weights, through the allocation-free views
+template<typename N, typename E>
+static void out_edges(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+	auto const g = bench::make_graph(input);
+	auto const queries = bench::make_queries(input, query_count);
+
+	for (auto _ : state) {
+		for (auto const& query : queries) {
+			for (auto const& edge : g.out_edges(query.from)) {
+				benchmark::DoNotOptimize(&edge.to);
+			}
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(query_count));
+}
+GDWG_GRAPH_BENCHMARK(out_edges);
+
+template<typename N, typename E>
+static void weights_view(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+	auto const g = bench::make_graph(input);
+	auto const queries = bench::make_queries(input, query_count);
+
+	for (auto _ : state) {
+		for (auto const& query : queries) {
+			for (auto const& weight : g.weights_view(query.from, query.to)) {
+				benchmark::DoNotOptimize(&weight);
+			}
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(query_count));
+}
+GDWG_GRAPH_BENCHMARK(weights_view);
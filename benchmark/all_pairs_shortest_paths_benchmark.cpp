@@ -0,0 +1,76 @@
+#include "gdwg/all_pairs_shortest_paths.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// Distance matrices over random graphs with 2^state.range(0) nodes and 2^state.range(1) edges per
+// node, reported as node pairs per second. Floyd-Warshall's time depends only on the node count,
+// Dijkstra's grows with the edges, which is where the automatic choice switches between them.
+namespace {
+	auto random_csr(benchmark::State const& state) -> gdwg::csr_graph<int, int> {
+		auto const n = std::size_t{1} << state.range(0);
+		auto const degree = std::size_t{1} << state.range(1);
+		return gdwg::csr_graph<int, int>(gdwg::erdos_renyi<int, int>(n, n * degree, 42));
+	}
+
+	auto pair_count(gdwg::csr_graph<int, int> const& g) -> std::int64_t {
+		return static_cast<std::int64_t>(g.node_count() * g.node_count());
+	}
+} // namespace
+
+static void floyd_warshall(benchmark::State& state) {
+	auto const g = random_csr(state);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::all_pairs_shortest_paths(g, gdwg::floyd_warshall));
+
+	state.SetItemsProcessed(state.iterations() * pair_count(g));
+}
+BENCHMARK(floyd_warshall)
+   ->ArgsProduct({{8, 10}, {1, 3, 5}})
+   ->Unit(benchmark::kMillisecond)
+   ->UseRealTime();
+
+static void repeated_dijkstra(benchmark::State& state) {
+	auto const g = random_csr(state);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::all_pairs_shortest_paths(g, gdwg::repeated_dijkstra));
+
+	state.SetItemsProcessed(state.iterations() * pair_count(g));
+}
+BENCHMARK(repeated_dijkstra)
+   ->ArgsProduct({{8, 10}, {1, 3, 5}})
+   ->Unit(benchmark::kMillisecond)
+   ->UseRealTime();
+
+static void all_pairs_shortest_paths(benchmark::State& state) {
+	auto const g = random_csr(state);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::all_pairs_shortest_paths(g));
+
+	state.SetItemsProcessed(state.iterations() * pair_count(g));
+}
+BENCHMARK(all_pairs_shortest_paths)
+   ->ArgsProduct({{8, 10}, {1, 3, 5}})
+   ->Unit(benchmark::kMillisecond)
+   ->UseRealTime();
+
+// A 1024 node graph with 32 edges per node over state.range(0) threads
+static void floyd_warshall_threads(benchmark::State& state) {
+	auto const g = gdwg::csr_graph<int, int>(gdwg::erdos_renyi<int, int>(1 << 10, 1 << 15, 42));
+	auto const threads = static_cast<std::size_t>(state.range(0));
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(gdwg::all_pairs_shortest_paths(g, gdwg::floyd_warshall, threads));
+	}
+
+	state.SetItemsProcessed(state.iterations() * pair_count(g));
+}
+BENCHMARK(floyd_warshall_threads)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
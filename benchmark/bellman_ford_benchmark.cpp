@@ -0,0 +1,110 @@
+#include "gdwg/bellman_ford.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include "graph_fixtures.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Road-like graphs with state.range(0) points, each joined both ways to its 3 nearest
+// neighbours, and R-MAT graphs, whose few rounds suit relaxing every edge at once. Signed
+// weights come from shifting every weight by the difference of random potentials at its ends,
+// which leaves cycles no cheaper, so there are no negative cycles and the shortest paths are
+// those of the unshifted weights.
+namespace {
+	auto with_potentials(gdwg::graph<int, int> const& g) -> gdwg::graph<int, int> {
+		auto const nodes = g.nodes();
+		auto rng = std::mt19937{6771};
+		auto potential = std::uniform_int_distribution<int>{0, 1000};
+		auto potentials = std::vector<int>(nodes.size());
+		for (auto& p : potentials)
+			p = potential(rng);
+
+		auto result = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+		for (auto const& [from, to, weight] : g) {
+			auto const shift = potentials[static_cast<std::size_t>(from)]
+			                   - potentials[static_cast<std::size_t>(to)];
+			result.insert_edge(from, to, weight + shift);
+		}
+		return result;
+	}
+
+	auto signed_road_graph(benchmark::State const& state) -> gdwg::graph<int, int> {
+		return with_potentials(bench::road_graph(state));
+	}
+
+	// 2^16 nodes with 8 edges each
+	auto signed_rmat_csr() -> gdwg::csr_graph<int, int> const& {
+		static auto const g =
+		   gdwg::csr_graph<int, int>(with_potentials(gdwg::rmat<int, int>(16, 8, 42)));
+		return g;
+	}
+
+} // namespace
+
+static void bellman_ford(benchmark::State& state) {
+	auto const g = signed_road_graph(state);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::bellman_ford(g, 0));
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(bellman_ford)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+static void bellman_ford_csr(benchmark::State& state) {
+	auto const g = gdwg::csr_graph<int, int>(signed_road_graph(state));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::bellman_ford(g, 0));
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(bellman_ford_csr)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+static void bellman_ford_rmat(benchmark::State& state) {
+	auto const& g = signed_rmat_csr();
+	auto const src = bench::busiest_node(g);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::bellman_ford(g, src));
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+}
+BENCHMARK(bellman_ford_rmat)->Unit(benchmark::kMillisecond);
+
+// Rounds over every edge, over state.range(0) threads
+static void bellman_ford_rounds_rmat(benchmark::State& state) {
+	auto const& g = signed_rmat_csr();
+	auto const src = bench::busiest_node(g);
+	auto const threads = static_cast<std::size_t>(state.range(0));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::bellman_ford(g, src, threads));
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.edge_count()));
+}
+BENCHMARK(bellman_ford_rounds_rmat)
+   ->Arg(1)
+   ->Arg(2)
+   ->Arg(4)
+   ->Unit(benchmark::kMillisecond)
+   ->UseRealTime();
+
+// Dijkstra on the unshifted distances, for what allowing negative weights costs
+static void dijkstra_csr(benchmark::State& state) {
+	auto const g = gdwg::csr_graph<int, int>(bench::road_graph(state));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::shortest_paths(g, 0));
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(dijkstra_csr)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
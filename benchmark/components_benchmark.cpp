@@ -0,0 +1,119 @@
+#include "gdwg/components.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+// Components of an R-MAT graph with 2^state.range(0) nodes and 16 edges per node, reported as
+// edges per second
+namespace {
+	auto rmat_graph(benchmark::State const& state) -> gdwg::graph<int, int> {
+		return gdwg::rmat<int, int>(static_cast<std::size_t>(state.range(0)), 16, 42);
+	}
+} // namespace
+
+static void strongly_connected_components(benchmark::State& state) {
+	auto const g = rmat_graph(state);
+	auto const edges = static_cast<std::int64_t>(gdwg::csr_graph<int, int>(g).edge_count());
+
+	for (auto _ : state) {
+		auto scc = gdwg::strongly_connected_components(g);
+		benchmark::DoNotOptimize(scc.count());
+	}
+
+	state.SetItemsProcessed(state.iterations() * edges);
+}
+BENCHMARK(strongly_connected_components)->DenseRange(10, 18, 4)->Unit(benchmark::kMillisecond);
+
+static void strongly_connected_components_csr(benchmark::State& state) {
+	auto const g = gdwg::csr_graph<int, int>(rmat_graph(state));
+	auto const edges = static_cast<std::int64_t>(g.edge_count());
+
+	for (auto _ : state) {
+		auto scc = gdwg::strongly_connected_components(g);
+		benchmark::DoNotOptimize(scc.count());
+	}
+
+	state.SetItemsProcessed(state.iterations() * edges);
+}
+BENCHMARK(strongly_connected_components_csr)->DenseRange(10, 18, 4)->Unit(benchmark::kMillisecond);
+
+static void condensation(benchmark::State& state) {
+	auto const g = rmat_graph(state);
+	auto const scc = gdwg::strongly_connected_components(g);
+	auto const edges = static_cast<std::int64_t>(gdwg::csr_graph<int, int>(g).edge_count());
+
+	for (auto _ : state) {
+		auto dag = gdwg::condensation(g, scc);
+		benchmark::DoNotOptimize(dag.empty());
+	}
+
+	state.SetItemsProcessed(state.iterations() * edges);
+}
+BENCHMARK(condensation)->DenseRange(10, 18, 4)->Unit(benchmark::kMillisecond);
+
+static void weak_components(benchmark::State& state) {
+	auto const g = rmat_graph(state);
+	auto const edges = static_cast<std::int64_t>(gdwg::csr_graph<int, int>(g).edge_count());
+
+	for (auto _ : state) {
+		auto weak = gdwg::weak_components(g);
+		benchmark::DoNotOptimize(weak.count());
+	}
+
+	state.SetItemsProcessed(state.iterations() * edges);
+}
+BENCHMARK(weak_components)->DenseRange(10, 18, 4)->Unit(benchmark::kMillisecond);
+
+static void weak_components_csr(benchmark::State& state) {
+	auto const g = gdwg::csr_graph<int, int>(rmat_graph(state));
+	auto const edges = static_cast<std::int64_t>(g.edge_count());
+
+	for (auto _ : state) {
+		auto weak = gdwg::weak_components(g);
+		benchmark::DoNotOptimize(weak.count());
+	}
+
+	state.SetItemsProcessed(state.iterations() * edges);
+}
+BENCHMARK(weak_components_csr)->DenseRange(10, 18, 4)->Unit(benchmark::kMillisecond);
+
+// Same-component queries between random pairs of nodes, reported as queries per second
+static void incremental_components_connected(benchmark::State& state) {
+	auto const g = rmat_graph(state);
+	auto tracker = gdwg::incremental_components<int, int>(g);
+	auto const n = 1 << state.range(0);
+	auto rng = std::mt19937{42};
+	auto pick = std::uniform_int_distribution<int>{0, n - 1};
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(tracker.connected(pick(rng), pick(rng)));
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(incremental_components_connected)->DenseRange(10, 18, 4);
+
+// Growing the graph one edge at a time while keeping the components current, reported as edges
+// per second
+static void incremental_components_insert_edge(benchmark::State& state) {
+	auto const g = rmat_graph(state);
+	auto const nodes = g.nodes();
+
+	for (auto _ : state) {
+		auto tracker = gdwg::incremental_components<int, int>{};
+		for (auto const n : nodes)
+			tracker.insert_node(n);
+		for (auto const& [from, to, weight] : g)
+			tracker.insert_edge(from, to, weight);
+		benchmark::DoNotOptimize(tracker.count());
+	}
+
+	state.SetItemsProcessed(state.iterations()
+	                        * static_cast<std::int64_t>(gdwg::csr_graph<int, int>(g).edge_count()));
+}
+BENCHMARK(incremental_components_insert_edge)->DenseRange(10, 18, 4)->Unit(benchmark::kMillisecond);
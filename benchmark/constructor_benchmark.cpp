@@ -0,0 +1,32 @@
+#include "graph_fixtures.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+template<typename N, typename E>
+static void copy(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+	auto const g = bench::make_graph(input);
+
+	for (auto _ : state) {
+		auto copy = g;
+		benchmark::DoNotOptimize(copy);
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(input.edges.size()));
+}
+GDWG_GRAPH_BENCHMARK(copy);
+
+template<typename N, typename E>
+static void range_construct(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+
+	for (auto _ : state) {
+		auto g = bench::make_graph(input);
+		benchmark::DoNotOptimize(g);
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(input.edges.size()));
+}
+GDWG_GRAPH_BENCHMARK(range_construct);
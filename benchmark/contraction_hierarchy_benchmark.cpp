@@ -0,0 +1,93 @@
+#include "gdwg/contraction_hierarchy.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include "graph_fixtures.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+// Road-like graphs with state.range(0) points and double weights
+namespace {
+	auto road_graph(benchmark::State const& state) -> gdwg::csr_graph<int, double> {
+		return gdwg::csr_graph<int, double>(bench::road_graph<double>(state));
+	}
+} // namespace
+
+// Preprocessing over state.range(1) threads, which only share out the first round of priorities
+static void contraction_hierarchy_build(benchmark::State& state) {
+	auto const g = road_graph(state);
+	auto const threads = static_cast<std::size_t>(state.range(1));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::contraction_hierarchy<int, double>(g, threads));
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	auto const ch = gdwg::contraction_hierarchy<int, double>(g, threads);
+	state.counters["shortcuts"] = static_cast<double>(ch.shortcut_count());
+}
+BENCHMARK(contraction_hierarchy_build)
+   ->ArgsProduct({{1 << 10, 1 << 13, 1 << 16}, {1, 4}})
+   ->Unit(benchmark::kMillisecond)
+   ->UseRealTime();
+
+static void contraction_hierarchy_query(benchmark::State& state) {
+	auto const ch = gdwg::contraction_hierarchy<int, double>(road_graph(state));
+	auto const pairs = bench::random_pairs(static_cast<std::size_t>(state.range(0)), 64);
+
+	auto settled = 0.0;
+	for (auto _ : state) {
+		settled = 0.0;
+		for (auto const& [src, dst] : pairs) {
+			auto const result = ch.shortest_path(src, dst);
+			settled += static_cast<double>(result.settled());
+			benchmark::DoNotOptimize(result);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(pairs.size()));
+	state.counters["settled"] = settled / static_cast<double>(pairs.size());
+}
+BENCHMARK(contraction_hierarchy_query)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+// The same queries without preprocessing, for what the hierarchy saves
+static void bidirectional_dijkstra_query(benchmark::State& state) {
+	auto const g = road_graph(state);
+	auto const reverse = g.transposed();
+	auto const pairs = bench::random_pairs(static_cast<std::size_t>(state.range(0)), 64);
+
+	auto settled = 0.0;
+	for (auto _ : state) {
+		settled = 0.0;
+		for (auto const& [src, dst] : pairs) {
+			auto const result = gdwg::shortest_path(g, reverse, src, dst);
+			settled += static_cast<double>(result.settled());
+			benchmark::DoNotOptimize(result);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(pairs.size()));
+	state.counters["settled"] = settled / static_cast<double>(pairs.size());
+}
+BENCHMARK(bidirectional_dijkstra_query)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+static void contraction_hierarchy_load(benchmark::State& state) {
+	auto saved = std::stringstream{};
+	gdwg::contraction_hierarchy<int, double>(road_graph(state)).save(saved);
+	auto const bytes = saved.str();
+
+	for (auto _ : state) {
+		auto is = std::istringstream(bytes);
+		benchmark::DoNotOptimize(gdwg::contraction_hierarchy<int, double>::load(is));
+	}
+
+	state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes.size()));
+}
+BENCHMARK(contraction_hierarchy_load)->Arg(1 << 16)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,97 @@
+#include "gdwg/dag.hpp"
+
+#include "gdwg/generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// A pipeline built up one edge at a time: state.range(0) nodes and four times as many edges, each
+// going forwards in a hidden random order, inserted in random order. Reported as edges inserted
+// per second.
+namespace {
+	struct edge {
+		int from;
+		int to;
+	};
+
+	auto pipeline_edges(benchmark::State const& state) -> std::vector<edge> {
+		auto const n = static_cast<int>(state.range(0));
+		auto rng = std::mt19937_64{42};
+		auto hidden = std::vector<int>(static_cast<std::size_t>(n));
+		std::iota(hidden.begin(), hidden.end(), 0);
+		std::shuffle(hidden.begin(), hidden.end(), rng);
+
+		auto pick = std::uniform_int_distribution<int>{0, n - 1};
+		auto edges = std::vector<edge>{};
+		while (edges.size() < 4 * static_cast<std::size_t>(n)) {
+			auto a = pick(rng);
+			auto b = pick(rng);
+			if (a == b)
+				continue;
+			if (a > b)
+				std::swap(a, b);
+			edges.push_back(edge{hidden[static_cast<std::size_t>(a)],
+			                     hidden[static_cast<std::size_t>(b)]});
+		}
+		return edges;
+	}
+
+	auto node_range(benchmark::State const& state) -> std::vector<int> {
+		auto nodes = std::vector<int>(static_cast<std::size_t>(state.range(0)));
+		std::iota(nodes.begin(), nodes.end(), 0);
+		return nodes;
+	}
+} // namespace
+
+static void dag_insert_edge(benchmark::State& state) {
+	auto const edges = pipeline_edges(state);
+	auto const nodes = node_range(state);
+
+	for (auto _ : state) {
+		auto d = gdwg::dag<int, int>(gdwg::graph<int, int>(nodes.begin(), nodes.end()));
+		for (auto const& e : edges)
+			d.insert_edge(e.from, e.to, 1);
+		benchmark::DoNotOptimize(d);
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+}
+BENCHMARK(dag_insert_edge)->RangeMultiplier(4)->Range(1 << 8, 1 << 12);
+
+// What the scheduler did before: insert, then check the whole graph again
+static void insert_edge_and_revalidate(benchmark::State& state) {
+	auto const edges = pipeline_edges(state);
+	auto const nodes = node_range(state);
+
+	for (auto _ : state) {
+		auto g = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+		for (auto const& e : edges) {
+			g.insert_edge(e.from, e.to, 1);
+			benchmark::DoNotOptimize(gdwg::topological_order(g));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edges.size()));
+}
+BENCHMARK(insert_edge_and_revalidate)->RangeMultiplier(4)->Range(1 << 8, 1 << 10);
+
+// One full sort of the finished graph, reported as nodes per second
+static void topological_order(benchmark::State& state) {
+	auto const edges = pipeline_edges(state);
+	auto const nodes = node_range(state);
+	auto g = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+	for (auto const& e : edges)
+		g.insert_edge(e.from, e.to, 1);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::topological_order(g));
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(topological_order)->RangeMultiplier(8)->Range(1 << 8, 1 << 17);
@@ -0,0 +1,75 @@
+#include "gdwg/delta_stepping.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include "graph_fixtures.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// Whole graph searches, reported as edges in the graph per second. Power-law R-MAT graphs are
+// shallow, so few buckets hold many nodes each; grids are deep, with many small buckets.
+namespace {
+	auto power_law_graph() -> bench::rooted_csr const& {
+		static auto const g = bench::freeze(gdwg::rmat<int, int>(17, 16, 42));
+		return g;
+	}
+
+	auto grid_graph() -> bench::rooted_csr const& {
+		static auto const g = bench::freeze(gdwg::grid<int, int>(512, 512, 42));
+		return g;
+	}
+
+	auto dijkstra(benchmark::State& state, bench::rooted_csr const& g) -> void {
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::shortest_paths(g.graph, g.source));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.graph.edge_count()));
+	}
+
+	// state.range(0) threads, and a delta of state.range(1), where 0 picks one from the graph
+	auto delta_stepping(benchmark::State& state, bench::rooted_csr const& g) -> void {
+		auto const options = gdwg::delta_stepping_options<int>{
+		   .delta = static_cast<int>(state.range(1)),
+		   .threads = static_cast<std::size_t>(state.range(0)),
+		};
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::delta_stepping(g.graph, g.source, options));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.graph.edge_count()));
+	}
+} // namespace
+
+static void dijkstra_power_law(benchmark::State& state) {
+	dijkstra(state, power_law_graph());
+}
+BENCHMARK(dijkstra_power_law)->Unit(benchmark::kMillisecond);
+
+static void delta_stepping_power_law(benchmark::State& state) {
+	delta_stepping(state, power_law_graph());
+}
+BENCHMARK(delta_stepping_power_law)
+   ->ArgNames({"threads", "delta"})
+   ->ArgsProduct({{1, 2, 4, 8, 16}, {0}})
+   ->ArgsProduct({{4}, {1, 10, 100, 1000}})
+   ->UseRealTime()
+   ->Unit(benchmark::kMillisecond);
+
+static void dijkstra_grid(benchmark::State& state) {
+	dijkstra(state, grid_graph());
+}
+BENCHMARK(dijkstra_grid)->Unit(benchmark::kMillisecond);
+
+static void delta_stepping_grid(benchmark::State& state) {
+	delta_stepping(state, grid_graph());
+}
+BENCHMARK(delta_stepping_grid)
+   ->ArgNames({"threads", "delta"})
+   ->ArgsProduct({{1, 2, 4, 8, 16}, {0}})
+   ->ArgsProduct({{4}, {1, 10, 100, 1000}})
+   ->UseRealTime()
+   ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,37 @@
+#include "graph_fixtures.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <sstream>
+
+// Compares two equal graphs, so every node and edge is visited
+template<typename N, typename E>
+static void equal(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+	auto const g = bench::make_graph(input);
+	auto const h = g;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(g == h);
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(input.edges.size()));
+}
+GDWG_GRAPH_BENCHMARK(equal);
+
+template<typename N, typename E>
+static void print(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+	auto const g = bench::make_graph(input);
+	auto out = std::ostringstream{};
+
+	for (auto _ : state) {
+		out.str("");
+		out << g;
+		benchmark::DoNotOptimize(out);
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(input.edges.size()));
+}
+GDWG_GRAPH_BENCHMARK(print);
@@ -0,0 +1,59 @@
+#include "gdwg/generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// Generated edges per second. Unless noted, graphs have state.range(0) nodes and 8 edges per node.
+static void erdos_renyi(benchmark::State& state) {
+	auto const nodes = static_cast<std::size_t>(state.range(0));
+	for (auto _ : state) {
+		auto g = gdwg::erdos_renyi<int, int>(nodes, nodes * 8, 42);
+		benchmark::DoNotOptimize(g);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0) * 8);
+}
+BENCHMARK(erdos_renyi)->RangeMultiplier(8)->Range(1 << 12, 1 << 18)->Unit(benchmark::kMillisecond);
+
+static void barabasi_albert(benchmark::State& state) {
+	auto const nodes = static_cast<std::size_t>(state.range(0));
+	for (auto _ : state) {
+		auto g = gdwg::barabasi_albert<int, int>(nodes, 8, 42);
+		benchmark::DoNotOptimize(g);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0) * 8);
+}
+BENCHMARK(barabasi_albert)->RangeMultiplier(8)->Range(1 << 12, 1 << 18)->Unit(benchmark::kMillisecond);
+
+static void rmat(benchmark::State& state) {
+	auto const scale = static_cast<std::size_t>(state.range(0));
+	for (auto _ : state) {
+		auto g = gdwg::rmat<int, int>(scale, 8, 42);
+		benchmark::DoNotOptimize(g);
+	}
+	state.SetItemsProcessed(state.iterations() * (std::int64_t{8} << state.range(0)));
+}
+BENCHMARK(rmat)->DenseRange(12, 18, 3)->Unit(benchmark::kMillisecond);
+
+// A square grid has about 4 edges per node
+static void grid(benchmark::State& state) {
+	auto const side = static_cast<std::size_t>(state.range(0));
+	for (auto _ : state) {
+		auto g = gdwg::grid<int, int>(side, side, 42);
+		benchmark::DoNotOptimize(g);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0) * 4);
+}
+BENCHMARK(grid)->RangeMultiplier(4)->Range(1 << 6, 1 << 9)->Unit(benchmark::kMillisecond);
+
+// k = 3 nearest points in both directions gives at most 6 edges per node
+static void geometric(benchmark::State& state) {
+	auto const nodes = static_cast<std::size_t>(state.range(0));
+	for (auto _ : state) {
+		auto g = gdwg::geometric<int, int>(nodes, 3, 42);
+		benchmark::DoNotOptimize(g);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0) * 6);
+}
+BENCHMARK(geometric)->RangeMultiplier(8)->Range(1 << 12, 1 << 18)->Unit(benchmark::kMillisecond);
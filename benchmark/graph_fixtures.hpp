@@ -0,0 +1,182 @@
+#ifndef GDWG_BENCHMARK_GRAPH_FIXTURES_HPP
+#define GDWG_BENCHMARK_GRAPH_FIXTURES_HPP
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Inputs shared by the graph benchmarks.
+// Every benchmark registered through GDWG_GRAPH_BENCHMARK is run for each node count in
+// graph_args, with edges spread either uniformly or skewed onto a few hub nodes, and for each
+// of the N/E pairs below. graph<int, int> uses flat storage, the others the shared_ptr tree.
+namespace bench {
+	enum class degree { uniform = 0, skewed = 1 };
+
+	inline constexpr auto edges_per_node = 8;
+	// Weights are drawn from a small pool, so insert_edge mostly shares an existing weight
+	inline constexpr auto weight_pool = 64;
+
+	template<typename T>
+	auto make_value(int i) -> T;
+
+	template<>
+	inline auto make_value<int>(int i) -> int {
+		return i;
+	}
+
+	// Long enough to be heap allocated rather than kept in the small string buffer
+	template<>
+	inline auto make_value<std::string>(int i) -> std::string {
+		auto digits = std::to_string(i);
+		return std::string(24 - digits.size(), 'n') + digits;
+	}
+
+	template<>
+	inline auto make_value<std::vector<int>>(int i) -> std::vector<int> {
+		return {i / 1024, i % 1024, i};
+	}
+
+	template<typename N, typename E>
+	struct graph_input {
+		std::vector<N> nodes;
+		std::vector<typename gdwg::graph<N, E>::value_type> edges;
+	};
+
+	template<typename N, typename E>
+	auto make_input(int node_count, degree distribution) -> graph_input<N, E> {
+		auto rng = std::mt19937{6771};
+		auto unit = std::uniform_real_distribution<double>{0.0, 1.0};
+		auto weight = std::uniform_int_distribution<int>{0, weight_pool - 1};
+
+		// Cubing the sample puts roughly 40% of the edge ends on the first 8% of nodes
+		auto pick = [&] {
+			auto u = unit(rng);
+			if (distribution == degree::skewed)
+				u = u * u * u;
+			return std::min(static_cast<int>(u * node_count), node_count - 1);
+		};
+
+		auto input = graph_input<N, E>{};
+		input.nodes.reserve(static_cast<std::size_t>(node_count));
+		for (auto i = 0; i < node_count; ++i) {
+			input.nodes.push_back(make_value<N>(i));
+		}
+
+		auto const edge_count = node_count * edges_per_node;
+		input.edges.reserve(static_cast<std::size_t>(edge_count));
+		for (auto e = 0; e < edge_count; ++e) {
+			auto const from = pick();
+			auto const to = pick();
+			input.edges.emplace_back(input.nodes[static_cast<std::size_t>(from)],
+			                         input.nodes[static_cast<std::size_t>(to)],
+			                         make_value<E>(weight(rng)));
+		}
+		return input;
+	}
+
+	template<typename N, typename E>
+	auto make_input(benchmark::State const& state) -> graph_input<N, E> {
+		return make_input<N, E>(static_cast<int>(state.range(0)), static_cast<degree>(state.range(1)));
+	}
+
+	template<typename N, typename E>
+	auto make_graph(graph_input<N, E> const& input) -> gdwg::graph<N, E> {
+		auto g = gdwg::graph<N, E>(input.nodes.begin(), input.nodes.end());
+		g.insert_edges(input.edges.begin(), input.edges.end());
+		return g;
+	}
+
+	// Lookups for the accessor benchmarks: even entries are edges in the graph, odd entries have
+	// their dst swapped for a random node, so most of them miss
+	template<typename N, typename E>
+	auto make_queries(graph_input<N, E> const& input, std::size_t count)
+	   -> std::vector<typename gdwg::graph<N, E>::value_type> {
+		auto rng = std::mt19937{1337};
+		auto edge = std::uniform_int_distribution<std::size_t>{0, input.edges.size() - 1};
+		auto node = std::uniform_int_distribution<std::size_t>{0, input.nodes.size() - 1};
+
+		auto queries = std::vector<typename gdwg::graph<N, E>::value_type>{};
+		queries.reserve(count);
+		for (auto i = std::size_t{0}; i < count; ++i) {
+			queries.push_back(input.edges[edge(rng)]);
+			if (i % 2 == 1)
+				queries.back().to = input.nodes[node(rng)];
+		}
+		return queries;
+	}
+
+	// Road-like graphs for the algorithm benchmarks: node_count points, each joined both ways to
+	// its 3 nearest neighbours, with distances as weights
+	template<typename E = int>
+	auto road_graph(std::size_t node_count) -> gdwg::graph<int, E> {
+		return gdwg::geometric<int, E>(node_count, 3, 42);
+	}
+
+	template<typename E = int>
+	auto road_graph(benchmark::State const& state) -> gdwg::graph<int, E> {
+		return road_graph<E>(static_cast<std::size_t>(state.range(0)));
+	}
+
+	// The node with the most out-edges, which reaches most of a skewed graph
+	template<typename E>
+	auto busiest_node(gdwg::csr_graph<int, E> const& g) -> int {
+		auto const offsets = g.offsets();
+		auto busiest = std::size_t{0};
+		for (auto u = std::size_t{1}; u < g.node_count(); ++u) {
+			if (offsets[u + 1] - offsets[u] > offsets[busiest + 1] - offsets[busiest])
+				busiest = u;
+		}
+		return g.node(busiest);
+	}
+
+	// A graph in CSR form with its busiest node, for whole graph searches
+	struct rooted_csr {
+		gdwg::csr_graph<int, int> graph;
+		int source;
+	};
+
+	inline auto freeze(gdwg::graph<int, int> const& g) -> rooted_csr {
+		auto csr = gdwg::csr_graph<int, int>(g);
+		auto const source = busiest_node(csr);
+		return rooted_csr{std::move(csr), source};
+	}
+
+	// Query pairs for the point to point benchmarks
+	inline auto random_pairs(std::size_t node_count, std::size_t count)
+	   -> std::vector<std::pair<int, int>> {
+		auto rng = std::mt19937{6771};
+		auto node = std::uniform_int_distribution<int>{0, static_cast<int>(node_count) - 1};
+		auto pairs = std::vector<std::pair<int, int>>(count);
+		for (auto& [src, dst] : pairs) {
+			src = node(rng);
+			dst = node(rng);
+		}
+		return pairs;
+	}
+
+	inline auto graph_args(benchmark::internal::Benchmark* b) -> void {
+		b->ArgNames({"nodes", "skewed"});
+		for (auto nodes : {1 << 10, 1 << 13, 1 << 16}) {
+			for (auto distribution : {degree::uniform, degree::skewed}) {
+				b->Args({nodes, static_cast<int>(distribution)});
+			}
+		}
+	}
+} // namespace bench
+
+#define GDWG_GRAPH_BENCHMARK(fn)                                                                  \
+	BENCHMARK_TEMPLATE(fn, int, int)->Apply(bench::graph_args);                                   \
+	BENCHMARK_TEMPLATE(fn, std::string, int)->Apply(bench::graph_args);                           \
+	BENCHMARK_TEMPLATE(fn, std::string, std::string)->Apply(bench::graph_args);                   \
+	BENCHMARK_TEMPLATE(fn, std::vector<int>, std::vector<int>)->Apply(bench::graph_args)
+
+#endif // GDWG_BENCHMARK_GRAPH_FIXTURES_HPP
@@ -0,0 +1,57 @@
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+	auto make_edges(int edge_count, int node_count) -> std::vector<gdwg::graph<int, int>::value_type> {
+		auto rng = std::mt19937{6771};
+		auto node_dist = std::uniform_int_distribution<int>{0, node_count - 1};
+		auto edges = std::vector<gdwg::graph<int, int>::value_type>{};
+		edges.reserve(static_cast<std::size_t>(edge_count));
+		for (auto i = 0; i < edge_count; ++i) {
+			edges.emplace_back(node_dist(rng), node_dist(rng), i);
+		}
+		return edges;
+	}
+} // namespace
+
+// Inserts state.range(0) edges with mostly distinct weights into a graph with a quarter as many
+// nodes. Every insert_edge looks for an existing equal weight to share, so the items/s counter
+// should stay flat as the graph grows.
+static void insert_edge_distinct_weights(benchmark::State& state) {
+	auto const edge_count = static_cast<int>(state.range(0));
+	auto const node_count = std::max(edge_count / 4, 1);
+	auto const edges = make_edges(edge_count, node_count);
+
+	for (auto _ : state) {
+		auto g = gdwg::graph<int, int>{};
+		for (auto n = 0; n < node_count; ++n) {
+			g.insert_node(n);
+		}
+		for (auto const& [from, to, weight] : edges) {
+			g.insert_edge(from, to, weight);
+		}
+		benchmark::DoNotOptimize(g);
+	}
+
+	state.SetItemsProcessed(state.iterations() * edge_count);
+}
+BENCHMARK(insert_edge_distinct_weights)->RangeMultiplier(4)->Range(1 << 8, 1 << 16);
+
+// Same input as above, loaded through the sort-and-build constructor
+static void insert_edges_bulk_load(benchmark::State& state) {
+	auto const edge_count = static_cast<int>(state.range(0));
+	auto const edges = make_edges(edge_count, std::max(edge_count / 4, 1));
+
+	for (auto _ : state) {
+		auto g = gdwg::graph<int, int>(gdwg::from_edges, edges);
+		benchmark::DoNotOptimize(g);
+	}
+
+	state.SetItemsProcessed(state.iterations() * edge_count);
+}
+BENCHMARK(insert_edges_bulk_load)->RangeMultiplier(4)->Range(1 << 8, 1 << 16);
@@ -0,0 +1,36 @@
+#include "graph_fixtures.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <iterator>
+
+template<typename N, typename E>
+static void iterate(benchmark::State& state) {
+	auto const g = bench::make_graph(bench::make_input<N, E>(state));
+	auto const edge_count = std::distance(g.begin(), g.end());
+
+	for (auto _ : state) {
+		for (auto const& edge : g) {
+			benchmark::DoNotOptimize(edge);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edge_count));
+}
+GDWG_GRAPH_BENCHMARK(iterate);
+
+template<typename N, typename E>
+static void iterate_reverse(benchmark::State& state) {
+	auto const g = bench::make_graph(bench::make_input<N, E>(state));
+	auto const edge_count = std::distance(g.begin(), g.end());
+
+	for (auto _ : state) {
+		for (auto it = g.end(); it != g.begin();) {
+			benchmark::DoNotOptimize(*--it);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(edge_count));
+}
+GDWG_GRAPH_BENCHMARK(iterate_reverse);
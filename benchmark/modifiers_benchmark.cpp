@@ -0,0 +1,127 @@
+#include "graph_fixtures.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// The erase and replace benchmarks modify an eighth of the nodes of a fresh copy of the graph per
+// iteration. Copying is excluded from the timings.
+namespace {
+	template<typename N, typename E>
+	auto every_eighth_node(bench::graph_input<N, E> const& input) -> std::vector<N> {
+		auto nodes = std::vector<N>{};
+		for (auto i = std::size_t{0}; i < input.nodes.size(); i += 8) {
+			nodes.push_back(input.nodes[i]);
+		}
+		return nodes;
+	}
+} // namespace
+
+// Nodes arrive in random order, which is the worst case for storage that keeps them sorted
+template<typename N, typename E>
+static void insert_node(benchmark::State& state) {
+	auto nodes = bench::make_input<N, E>(state).nodes;
+	std::shuffle(nodes.begin(), nodes.end(), std::mt19937{6771});
+
+	for (auto _ : state) {
+		auto g = gdwg::graph<N, E>{};
+		for (auto const& node : nodes) {
+			g.insert_node(node);
+		}
+		benchmark::DoNotOptimize(g);
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(nodes.size()));
+}
+GDWG_GRAPH_BENCHMARK(insert_node);
+
+// Inserts every edge one at a time. Weights come from a small pool, so this includes the cost of
+// finding an existing weight to share.
+template<typename N, typename E>
+static void insert_edge(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+
+	for (auto _ : state) {
+		auto g = gdwg::graph<N, E>(input.nodes.begin(), input.nodes.end());
+		for (auto const& [from, to, weight] : input.edges) {
+			g.insert_edge(from, to, weight);
+		}
+		benchmark::DoNotOptimize(g);
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(input.edges.size()));
+}
+GDWG_GRAPH_BENCHMARK(insert_edge);
+
+template<typename N, typename E>
+static void erase_node(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+	auto const original = bench::make_graph(input);
+	auto const nodes = every_eighth_node(input);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto g = original;
+		state.ResumeTiming();
+
+		for (auto const& node : nodes) {
+			g.erase_node(node);
+		}
+		benchmark::DoNotOptimize(g);
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(nodes.size()));
+}
+GDWG_GRAPH_BENCHMARK(erase_node);
+
+template<typename N, typename E>
+static void replace_node(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+	auto const original = bench::make_graph(input);
+	auto const nodes = every_eighth_node(input);
+
+	auto replacements = std::vector<N>{};
+	for (auto i = std::size_t{0}; i < nodes.size(); ++i) {
+		replacements.push_back(bench::make_value<N>(static_cast<int>(input.nodes.size() + i)));
+	}
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto g = original;
+		state.ResumeTiming();
+
+		for (auto i = std::size_t{0}; i < nodes.size(); ++i) {
+			g.replace_node(nodes[i], replacements[i]);
+		}
+		benchmark::DoNotOptimize(g);
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(nodes.size()));
+}
+GDWG_GRAPH_BENCHMARK(replace_node);
+
+// Merges each chosen node into the node after it
+template<typename N, typename E>
+static void merge_replace_node(benchmark::State& state) {
+	auto const input = bench::make_input<N, E>(state);
+	auto const original = bench::make_graph(input);
+	auto const nodes = every_eighth_node(input);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto g = original;
+		state.ResumeTiming();
+
+		for (auto i = std::size_t{0}; i < nodes.size(); ++i) {
+			g.merge_replace_node(nodes[i], input.nodes[i * 8 + 1]);
+		}
+		benchmark::DoNotOptimize(g);
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(nodes.size()));
+}
+GDWG_GRAPH_BENCHMARK(merge_replace_node);
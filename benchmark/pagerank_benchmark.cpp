@@ -0,0 +1,67 @@
+#include "gdwg/pagerank.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// Twenty power iterations over an R-MAT graph with 2^18 nodes and 16 edges per node, reported as
+// edges per second summed over the iterations. state.range(0) is the thread count.
+namespace {
+	auto skewed_graph() -> gdwg::graph<int, int> const& {
+		static auto const g = gdwg::rmat<int, int>(18, 16, 42);
+		return g;
+	}
+
+	auto skewed_csr() -> gdwg::csr_graph<int, int> const& {
+		static auto const g = gdwg::csr_graph<int, int>(skewed_graph());
+		return g;
+	}
+
+	auto twenty_iterations(benchmark::State const& state) -> gdwg::pagerank_options<int> {
+		auto options = gdwg::pagerank_options<int>{};
+		options.tolerance = 0.0;
+		options.max_iterations = 20;
+		options.threads = static_cast<std::size_t>(state.range(0));
+		return options;
+	}
+} // namespace
+
+static void pagerank_csr(benchmark::State& state) {
+	auto const& g = skewed_csr();
+	auto const options = twenty_iterations(state);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::pagerank(g, options));
+
+	state.SetItemsProcessed(state.iterations() * 20 * static_cast<std::int64_t>(g.edge_count()));
+}
+BENCHMARK(pagerank_csr)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void pagerank_unweighted_csr(benchmark::State& state) {
+	auto const& g = skewed_csr();
+	auto options = twenty_iterations(state);
+	options.weighted = false;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::pagerank(g, options));
+
+	state.SetItemsProcessed(state.iterations() * 20 * static_cast<std::int64_t>(g.edge_count()));
+}
+BENCHMARK(pagerank_unweighted_csr)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Including the conversion to compressed-sparse-row form
+static void pagerank(benchmark::State& state) {
+	auto const& g = skewed_graph();
+	auto const options = twenty_iterations(state);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::pagerank(g, options));
+
+	state.SetItemsProcessed(state.iterations() * 20
+	                        * static_cast<std::int64_t>(skewed_csr().edge_count()));
+}
+BENCHMARK(pagerank)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,95 @@
+#include "gdwg/parallel_bfs.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+#include "gdwg/traversal.hpp"
+
+#include "graph_fixtures.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Whole graph searches, reported as edges in the graph per second. Skewed R-MAT graphs have few,
+// wide levels where bottom-up steps pay off; road-like graphs have many narrow ones.
+namespace {
+	// Bottom-up steps walk in-edges, so the graph is kept reversed as well
+	struct frozen_graph {
+		gdwg::csr_graph<int, int> graph;
+		gdwg::csr_graph<int, int> reverse;
+		int source;
+	};
+
+	auto freeze(gdwg::graph<int, int> const& g) -> frozen_graph {
+		auto [csr, source] = bench::freeze(g);
+		auto reverse = csr.transposed();
+		return frozen_graph{std::move(csr), std::move(reverse), source};
+	}
+
+	auto skewed_graph() -> frozen_graph const& {
+		static auto const g = freeze(gdwg::rmat<int, int>(18, 16, 42));
+		return g;
+	}
+
+	auto road_graph() -> frozen_graph const& {
+		static auto const g = freeze(bench::road_graph(1 << 18));
+		return g;
+	}
+
+	struct counter {
+		std::int64_t discovered = 0;
+
+		auto discover(int) -> void {
+			++discovered;
+		}
+	};
+
+	auto sequential(benchmark::State& state, frozen_graph const& g) -> void {
+		for (auto _ : state) {
+			auto vis = counter{};
+			gdwg::bfs(g.graph, g.source, vis);
+			benchmark::DoNotOptimize(vis.discovered);
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.graph.edge_count()));
+	}
+
+	auto parallel(benchmark::State& state, frozen_graph const& g) -> void {
+		auto const threads = static_cast<std::size_t>(state.range(0));
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(gdwg::parallel_bfs(g.graph, g.reverse, g.source, threads));
+		}
+		state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(g.graph.edge_count()));
+	}
+} // namespace
+
+static void sequential_skewed(benchmark::State& state) {
+	sequential(state, skewed_graph());
+}
+BENCHMARK(sequential_skewed)->Unit(benchmark::kMillisecond);
+
+static void parallel_skewed(benchmark::State& state) {
+	parallel(state, skewed_graph());
+}
+BENCHMARK(parallel_skewed)
+   ->ArgName("threads")
+   ->RangeMultiplier(2)
+   ->Range(1, 16)
+   ->UseRealTime()
+   ->Unit(benchmark::kMillisecond);
+
+static void sequential_road(benchmark::State& state) {
+	sequential(state, road_graph());
+}
+BENCHMARK(sequential_road)->Unit(benchmark::kMillisecond);
+
+static void parallel_road(benchmark::State& state) {
+	parallel(state, road_graph());
+}
+BENCHMARK(parallel_road)
+   ->ArgName("threads")
+   ->RangeMultiplier(2)
+   ->Range(1, 16)
+   ->UseRealTime()
+   ->Unit(benchmark::kMillisecond);
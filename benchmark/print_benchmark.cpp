@@ -0,0 +1,52 @@
+#include "gdwg/graph.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <sstream>
+
+namespace {
+	// A graph with state.range(0) nodes and four times as many edges
+	auto make_graph(int node_count) -> gdwg::graph<int, int> {
+		auto rng = std::mt19937{6771};
+		auto node_dist = std::uniform_int_distribution<int>{0, node_count - 1};
+		auto g = gdwg::graph<int, int>{};
+		for (auto n = 0; n < node_count; ++n) {
+			g.insert_node(n);
+		}
+		for (auto e = 0; e < node_count * 4; ++e) {
+			g.insert_edge(node_dist(rng), node_dist(rng), e % 1024);
+		}
+		return g;
+	}
+} // namespace
+
+static void print_ostream(benchmark::State& state) {
+	auto const g = make_graph(static_cast<int>(state.range(0)));
+	auto out = std::ostringstream{};
+
+	for (auto _ : state) {
+		out.str("");
+		out << g;
+		benchmark::DoNotOptimize(out);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0) * 4);
+}
+BENCHMARK(print_ostream)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+
+static void print_buffered_writer(benchmark::State& state) {
+	auto const g = make_graph(static_cast<int>(state.range(0)));
+	auto out = std::ostringstream{};
+	auto writer = gdwg::buffered_writer(out);
+
+	for (auto _ : state) {
+		out.str("");
+		g.write(writer);
+		writer.flush();
+		benchmark::DoNotOptimize(out);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0) * 4);
+}
+BENCHMARK(print_buffered_writer)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
@@ -0,0 +1,131 @@
+#include "gdwg/shortest_paths.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+#include "gdwg/heaps.hpp"
+
+#include "graph_fixtures.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Road-like graphs with state.range(0) points
+
+template<template<typename> class Heap>
+static void single_source(benchmark::State& state) {
+	auto const g = bench::road_graph(state);
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(gdwg::shortest_paths<Heap>(g, 0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(single_source, gdwg::binary_heap)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(single_source, gdwg::pairing_heap)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(single_source, gdwg::radix_heap)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+template<template<typename> class Heap>
+static void single_source_csr(benchmark::State& state) {
+	auto const g = gdwg::csr_graph<int, int>(bench::road_graph(state));
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(gdwg::shortest_paths<Heap>(g, 0));
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(single_source_csr, gdwg::binary_heap)
+   ->RangeMultiplier(8)
+   ->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(single_source_csr, gdwg::radix_heap)
+   ->RangeMultiplier(8)
+   ->Range(1 << 10, 1 << 19);
+
+// Random src/dst queries that stop once dst is settled, reported as queries per second. The
+// settled counter is the average number of nodes each query settles.
+static void single_pair(benchmark::State& state) {
+	auto const g = bench::road_graph(state);
+	auto const pairs = bench::random_pairs(static_cast<std::size_t>(state.range(0)), 64);
+
+	for (auto _ : state) {
+		for (auto const& [src, dst] : pairs) {
+			benchmark::DoNotOptimize(gdwg::shortest_paths(g, src, dst));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(pairs.size()));
+	auto settled = 0.0;
+	for (auto const& [src, dst] : pairs) {
+		auto const tree = gdwg::shortest_paths(g, src, dst);
+		for (auto i = std::size_t{0}; i < tree.nodes().size(); ++i)
+			settled += tree.reached(i) ? 1.0 : 0.0;
+	}
+	state.counters["settled"] = settled / static_cast<double>(pairs.size());
+}
+BENCHMARK(single_pair)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+static void single_pair_bidirectional(benchmark::State& state) {
+	auto const g = bench::road_graph(state);
+	auto const pairs = bench::random_pairs(static_cast<std::size_t>(state.range(0)), 64);
+
+	auto settled = 0.0;
+	for (auto _ : state) {
+		settled = 0.0;
+		for (auto const& [src, dst] : pairs) {
+			auto const result = gdwg::shortest_path(g, src, dst);
+			settled += static_cast<double>(result.settled());
+			benchmark::DoNotOptimize(result);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(pairs.size()));
+	state.counters["settled"] = settled / static_cast<double>(pairs.size());
+}
+BENCHMARK(single_pair_bidirectional)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+static void single_pair_bidirectional_csr(benchmark::State& state) {
+	auto const g = gdwg::csr_graph<int, int>(bench::road_graph(state));
+	auto const reverse = g.transposed();
+	auto const pairs = bench::random_pairs(static_cast<std::size_t>(state.range(0)), 64);
+
+	for (auto _ : state) {
+		for (auto const& [src, dst] : pairs) {
+			benchmark::DoNotOptimize(gdwg::shortest_path(g, reverse, src, dst));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(pairs.size()));
+}
+BENCHMARK(single_pair_bidirectional_csr)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+// A* guided by the straight line distance to dst, which the rounded up weights never undercut
+static void single_pair_a_star_csr(benchmark::State& state) {
+	auto const points = gdwg::random_points(static_cast<std::size_t>(state.range(0)), 42);
+	auto const g = gdwg::csr_graph<int, int>(gdwg::geometric<int, int>(points, 3));
+	auto const pairs = bench::random_pairs(static_cast<std::size_t>(state.range(0)), 64);
+
+	auto settled = 0.0;
+	for (auto _ : state) {
+		settled = 0.0;
+		for (auto const& [src, dst] : pairs) {
+			auto const& to = points[static_cast<std::size_t>(dst)];
+			auto const straight_line = [&](int v) {
+				auto const& from = points[static_cast<std::size_t>(v)];
+				return static_cast<int>(std::hypot(from.x - to.x, from.y - to.y) * 1e6);
+			};
+			auto const result = gdwg::shortest_path(g, src, dst, straight_line);
+			settled += static_cast<double>(result.settled());
+			benchmark::DoNotOptimize(result);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(pairs.size()));
+	state.counters["settled"] = settled / static_cast<double>(pairs.size());
+}
+BENCHMARK(single_pair_a_star_csr)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
@@ -0,0 +1,94 @@
+#include "gdwg/spanning_forest.hpp"
+
+#include "gdwg/components.hpp"
+#include "gdwg/generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+// Minimum spanning forests, reported as edges in the graph per second. Sensor networks join
+// every point to its 6 nearest neighbours; dense graphs have 2^state.range(0) nodes and a
+// quarter of all possible edges.
+namespace {
+	auto sensor_network(benchmark::State const& state) -> gdwg::graph<int, double> {
+		return gdwg::geometric<int, double>(static_cast<std::size_t>(state.range(0)), 6, 42);
+	}
+
+	auto dense_graph(benchmark::State const& state) -> gdwg::graph<int, double> {
+		auto const n = std::size_t{1} << state.range(0);
+		return gdwg::erdos_renyi<int, double>(n, n * n / 4, 42);
+	}
+
+	auto edge_count(gdwg::graph<int, double> const& g) -> std::int64_t {
+		return static_cast<std::int64_t>(std::distance(g.begin(), g.end()));
+	}
+} // namespace
+
+static void kruskal_sensor_network(benchmark::State& state) {
+	auto const g = sensor_network(state);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::minimum_spanning_edges(g, gdwg::kruskal));
+
+	state.SetItemsProcessed(state.iterations() * edge_count(g));
+}
+BENCHMARK(kruskal_sensor_network)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+static void prim_sensor_network(benchmark::State& state) {
+	auto const g = sensor_network(state);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::minimum_spanning_edges(g, gdwg::prim));
+
+	state.SetItemsProcessed(state.iterations() * edge_count(g));
+}
+BENCHMARK(prim_sensor_network)->RangeMultiplier(8)->Range(1 << 10, 1 << 13);
+
+static void kruskal_dense(benchmark::State& state) {
+	auto const g = dense_graph(state);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::minimum_spanning_edges(g, gdwg::kruskal));
+
+	state.SetItemsProcessed(state.iterations() * edge_count(g));
+}
+BENCHMARK(kruskal_dense)->DenseRange(8, 11, 1);
+
+static void prim_dense(benchmark::State& state) {
+	auto const g = dense_graph(state);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(gdwg::minimum_spanning_edges(g, gdwg::prim));
+
+	state.SetItemsProcessed(state.iterations() * edge_count(g));
+}
+BENCHMARK(prim_dense)->DenseRange(8, 11, 1);
+
+// What callers wrote before: copy every edge out through begin() / end(), sort all of them and
+// run Kruskal's algorithm over node values
+static void kruskal_by_copying_edges(benchmark::State& state) {
+	auto const g = sensor_network(state);
+	auto const nodes = g.nodes();
+
+	for (auto _ : state) {
+		auto edges = std::vector<gdwg::graph<int, double>::value_type>(g.begin(), g.end());
+		std::sort(edges.begin(), edges.end(), [](auto const& a, auto const& b) {
+			return a.weight < b.weight;
+		});
+		auto forest = gdwg::incremental_components<int, double>(
+		   gdwg::graph<int, double>(nodes.begin(), nodes.end()));
+		for (auto const& edge : edges) {
+			if (!forest.connected(edge.from, edge.to))
+				forest.insert_edge(edge.from, edge.to, edge.weight);
+		}
+		benchmark::DoNotOptimize(forest.as_graph());
+	}
+
+	state.SetItemsProcessed(state.iterations() * edge_count(g));
+}
+BENCHMARK(kruskal_by_copying_edges)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
@@ -0,0 +1,84 @@
+#include "gdwg/traversal.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+
+#include "graph_fixtures.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+// Full traversals from node 0 of a road-like graph with state.range(0) nodes, reported as nodes
+// visited per second
+namespace {
+	struct counter {
+		std::int64_t discovered = 0;
+
+		auto discover(int) -> void {
+			++discovered;
+		}
+	};
+} // namespace
+
+static void bfs(benchmark::State& state) {
+	auto const g = bench::road_graph(state);
+
+	for (auto _ : state) {
+		auto vis = counter{};
+		gdwg::bfs(g, 0, vis);
+		benchmark::DoNotOptimize(vis.discovered);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(bfs)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+static void bfs_csr(benchmark::State& state) {
+	auto const g = gdwg::csr_graph<int, int>(bench::road_graph(state));
+
+	for (auto _ : state) {
+		auto vis = counter{};
+		gdwg::bfs(g, 0, vis);
+		benchmark::DoNotOptimize(vis.discovered);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(bfs_csr)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+static void dfs(benchmark::State& state) {
+	auto const g = bench::road_graph(state);
+
+	for (auto _ : state) {
+		auto vis = counter{};
+		gdwg::dfs(g, 0, vis);
+		benchmark::DoNotOptimize(vis.discovered);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(dfs)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+// What callers wrote before bfs existed: a queue over connections() and a std::set of visited nodes
+static void bfs_by_connections(benchmark::State& state) {
+	auto const g = bench::road_graph(state);
+
+	for (auto _ : state) {
+		auto visited = std::set<int>{0};
+		auto queue = std::vector<int>{0};
+		for (auto head = std::size_t{0}; head < queue.size(); ++head) {
+			for (auto const& to : g.connections(queue[head])) {
+				if (visited.insert(to).second)
+					queue.push_back(to);
+			}
+		}
+		benchmark::DoNotOptimize(queue.size());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(bfs_by_connections)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
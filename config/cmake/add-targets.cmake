@@ -48,10 +48,11 @@ endfunction()
 # Builds an executable that can be run as a more reliable benchmark.
 # Accepts the same parameters as `cxx_executable`.
 # Depends on Google Benchmark being imported.
+# The library is header-only, so benchmarks are built with inlining left on; use
+# benchmark::DoNotOptimize to keep results from being optimised away.
 function(cxx_benchmark)
    cxx_executable(${ARGN})
 
    PROJECT_TEMPLATE_EXTRACT_ADD_TARGET_ARGS(${ARGN})
-   target_compile_options("${add_target_args_TARGET}" PRIVATE -fno-inline)
    target_link_libraries("${add_target_args_TARGET}" PRIVATE benchmark::benchmark benchmark::benchmark_main)
 endfunction()
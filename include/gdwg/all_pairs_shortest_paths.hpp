@@ -0,0 +1,362 @@
+#ifndef GDWG_ALL_PAIRS_SHORTEST_PATHS_HPP
+#define GDWG_ALL_PAIRS_SHORTEST_PATHS_HPP
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/heaps.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+	// Picks the algorithm for all_pairs_shortest_paths. Floyd-Warshall takes O(nodes^3) whatever
+	// the edges, in small cache sized blocks whose inner loops the compiler vectorises; it allows
+	// negative weights. Repeated Dijkstra takes O(nodes * edges * log nodes) and wins on sparse
+	// graphs.
+	struct floyd_warshall_t {
+		explicit floyd_warshall_t() = default;
+	};
+	inline constexpr floyd_warshall_t floyd_warshall{};
+
+	struct repeated_dijkstra_t {
+		explicit repeated_dijkstra_t() = default;
+	};
+	inline constexpr repeated_dijkstra_t repeated_dijkstra{};
+
+	namespace detail {
+		// Infinity where E has one. Integral weights use half their maximum, so that adding two
+		// can't overflow; their distances must stay within a quarter of the maximum either way.
+		template<typename E>
+		inline constexpr E unreachable_distance = std::numeric_limits<E>::has_infinity
+		                                             ? std::numeric_limits<E>::infinity()
+		                                             : std::numeric_limits<E>::max() / 2;
+
+		// Integral distances that an addition pushed below unreachable still count as none
+		template<typename E>
+		[[nodiscard]] constexpr auto finite_distance(E value) noexcept -> bool {
+			if constexpr (std::numeric_limits<E>::has_infinity)
+				return value != unreachable_distance<E>;
+			else
+				return value < unreachable_distance<E> / 2;
+		}
+	} // namespace detail
+
+	// Distances between every pair of nodes found by gdwg::all_pairs_shortest_paths, as one
+	// row-major matrix by index in nodes(), the sorted node list of the graph. Pairs without a
+	// path hold unreachable.
+	template<typename N, typename E>
+	class distance_matrix {
+	public:
+		using size_type = std::size_t;
+		static constexpr size_type npos = std::numeric_limits<size_type>::max();
+		// Infinity where E has one, otherwise half of E's maximum. Integral distances must stay
+		// within a quarter of E's range.
+		static constexpr E unreachable = detail::unreachable_distance<E>;
+
+		distance_matrix(std::vector<N> nodes, std::vector<E> distances)
+		: nodes_(std::move(nodes))
+		, distances_(std::move(distances)) {}
+
+		[[nodiscard]] auto reachable(N const& src, N const& dst) const noexcept -> bool {
+			auto const i = index_of(src);
+			auto const j = index_of(dst);
+			return i != npos && j != npos && at(i, j) != unreachable;
+		}
+
+		[[nodiscard]] auto distance(N const& src, N const& dst) const -> E {
+			auto const i = index_of(src);
+			auto const j = index_of(dst);
+			if (i == npos || j == npos || at(i, j) == unreachable) {
+				throw std::runtime_error("Cannot call gdwg::distance_matrix<N, E>::distance if there "
+				                         "is no path from src to dst");
+			}
+			return at(i, j);
+		}
+
+		[[nodiscard]] auto nodes() const noexcept -> std::span<N const> {
+			return nodes_;
+		}
+		[[nodiscard]] auto size() const noexcept -> size_type {
+			return nodes_.size();
+		}
+		[[nodiscard]] auto index_of(N const& value) const noexcept -> size_type {
+			auto it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			return (it != nodes_.end() && !(value < *it)) ? static_cast<size_type>(it - nodes_.begin())
+			                                              : npos;
+		}
+		[[nodiscard]] auto at(size_type src, size_type dst) const noexcept -> E {
+			return distances_[src * nodes_.size() + dst];
+		}
+		// Distances from the src-th node to every node
+		[[nodiscard]] auto row(size_type src) const noexcept -> std::span<E const> {
+			return std::span<E const>(distances_).subspan(src * nodes_.size(), nodes_.size());
+		}
+		[[nodiscard]] auto data() const noexcept -> std::span<E const> {
+			return distances_;
+		}
+
+	private:
+		std::vector<N> nodes_;
+		std::vector<E> distances_;
+	};
+
+	namespace detail {
+		// Floyd-Warshall over a row-major matrix, a block of rows and columns at a time: first the
+		// block on the diagonal, then the rest of its block row and column, which only depend on
+		// it, then every other block, which only depends on those. Each phase's blocks are
+		// independent of each other, so threads share them out and meet at a barrier between
+		// phases. The matrix is padded to whole blocks, so the innermost loop is always a min-plus
+		// of block contiguous weights against a local copy of the row it goes through, which the
+		// compiler can vectorise without checking for overlap.
+		template<typename E>
+		class blocked_floyd_warshall {
+		public:
+			using size_type = std::size_t;
+			// Three blocks of 64 x 64 four byte weights fit in a 48K L1 cache
+			static constexpr size_type block = 64;
+
+			[[nodiscard]] static constexpr auto padded(size_type n) noexcept -> size_type {
+				return (n + block - 1) / block * block;
+			}
+
+			// d is stride x stride, where stride is padded(node count)
+			blocked_floyd_warshall(std::vector<E>& d, size_type stride)
+			: d_{d.data()}
+			, stride_{stride}
+			, blocks_{stride / block} {}
+
+			auto run(size_type threads) -> void {
+				if (blocks_ == 0)
+					return;
+				relax(0, 0, 0);
+
+				auto sync = std::barrier(static_cast<std::ptrdiff_t>(threads), [this]() noexcept {
+					if (phase_ == 2 && ++round_ < blocks_)
+						relax(round_, round_, round_);
+					phase_ = phase_ == 1 ? 2 : 1;
+					next_.store(0, std::memory_order_relaxed);
+				});
+				auto work = [&] {
+					while (round_ < blocks_) {
+						if (phase_ == 1)
+							cross();
+						else
+							rest();
+						sync.arrive_and_wait();
+					}
+				};
+
+				{
+					auto helpers = std::vector<std::jthread>{};
+					helpers.reserve(threads - 1);
+					for (auto t = size_type{1}; t < threads; ++t)
+						helpers.emplace_back(work);
+					work();
+				}
+			}
+
+		private:
+			E* d_;
+			size_type stride_;
+			size_type blocks_;
+			size_type round_ = 0;
+			int phase_ = 1;
+			std::atomic<size_type> next_ = 0;
+
+			// Paths within block (bi, bj) through the nodes of block bk
+			auto relax(size_type bi, size_type bj, size_type bk) noexcept -> void {
+				E through[block];
+				for (auto k = bk * block; k < (bk + 1) * block; ++k) {
+					std::copy_n(d_ + k * stride_ + bj * block, block, through);
+					for (auto i = bi * block; i < (bi + 1) * block; ++i) {
+						auto const to_k = d_[i * stride_ + k];
+						if (!finite_distance(to_k))
+							continue;
+						E* row = d_ + i * stride_ + bj * block;
+						for (auto j = size_type{0}; j < block; ++j) {
+							auto const candidate = static_cast<E>(to_k + through[j]);
+							row[j] = candidate < row[j] ? candidate : row[j];
+						}
+					}
+				}
+			}
+
+			// The blocks in the current block row and column
+			auto cross() noexcept -> void {
+				for (auto b = next_.fetch_add(1, std::memory_order_relaxed); b < 2 * blocks_;
+				     b = next_.fetch_add(1, std::memory_order_relaxed))
+				{
+					auto const other = b / 2;
+					if (other == round_)
+						continue;
+					if (b % 2 == 0)
+						relax(round_, other, round_);
+					else
+						relax(other, round_, round_);
+				}
+			}
+
+			// Every other block, a block row at a time
+			auto rest() noexcept -> void {
+				for (auto bi = next_.fetch_add(1, std::memory_order_relaxed); bi < blocks_;
+				     bi = next_.fetch_add(1, std::memory_order_relaxed))
+				{
+					if (bi == round_)
+						continue;
+					for (auto bj = size_type{0}; bj < blocks_; ++bj) {
+						if (bj != round_)
+							relax(bi, bj, round_);
+					}
+				}
+			}
+		};
+
+		template<typename N, typename E>
+		auto all_pairs(csr_graph<N, E> const& g, floyd_warshall_t, std::size_t threads)
+		   -> distance_matrix<N, E> {
+			using matrix = distance_matrix<N, E>;
+			auto const n = g.node_count();
+			auto const offsets = g.offsets();
+			auto const targets = g.targets();
+			auto const weights = g.edge_weights();
+
+			using search = blocked_floyd_warshall<E>;
+			auto const stride = search::padded(n);
+			auto padded = std::vector<E>(stride * stride, matrix::unreachable);
+			for (auto u = std::size_t{0}; u < n; ++u) {
+				padded[u * stride + u] = E{};
+				for (auto e = offsets[u]; e < offsets[u + 1]; ++e) {
+					auto& entry = padded[u * stride + targets[e]];
+					entry = std::min(entry, weights[e]);
+				}
+			}
+
+			search(padded, stride).run(worker_count(threads, stride / search::block));
+
+			auto d = std::vector<E>(n * n);
+			for (auto u = std::size_t{0}; u < n; ++u) {
+				if (padded[u * stride + u] < E{}) {
+					throw std::runtime_error("Cannot call gdwg::all_pairs_shortest_paths on a graph "
+					                         "with a negative cycle");
+				}
+				for (auto v = std::size_t{0}; v < n; ++v) {
+					auto const entry = padded[u * stride + v];
+					d[u * n + v] = finite_distance(entry) ? entry : matrix::unreachable;
+				}
+			}
+			return matrix(g.nodes(), std::move(d));
+		}
+
+		template<typename N, typename E>
+		auto all_pairs(csr_graph<N, E> const& g, repeated_dijkstra_t, std::size_t threads)
+		   -> distance_matrix<N, E> {
+			using matrix = distance_matrix<N, E>;
+			constexpr auto npos = std::numeric_limits<std::size_t>::max();
+			auto const n = g.node_count();
+			auto const offsets = g.offsets();
+			auto const targets = g.targets();
+			auto const weights = g.edge_weights();
+			if (std::any_of(weights.begin(), weights.end(), [](E const& w) { return w < E{}; })) {
+				throw std::runtime_error("Cannot call gdwg::all_pairs_shortest_paths with "
+				                         "repeated_dijkstra on a graph with negative weights");
+			}
+
+			auto d = std::vector<E>(n * n, matrix::unreachable);
+			auto for_each_edge = [&](std::size_t u, auto&& relax) {
+				for (auto e = offsets[u]; e < offsets[u + 1]; ++e)
+					relax(targets[e], weights[e]);
+			};
+			// Sources are handed out one at a time, and each fills its own row
+			auto next = std::atomic<std::size_t>{0};
+			auto work = [&] {
+				for (auto src = next.fetch_add(1, std::memory_order_relaxed); src < n;
+				     src = next.fetch_add(1, std::memory_order_relaxed))
+				{
+					auto const state = dijkstra<binary_heap, E>(n, src, npos, for_each_edge);
+					for (auto v = std::size_t{0}; v < n; ++v) {
+						if (state.settled[v])
+							d[src * n + v] = state.distances[v];
+					}
+				}
+			};
+
+			{
+				auto const count = worker_count(threads, n);
+				auto helpers = std::vector<std::jthread>{};
+				helpers.reserve(count - 1);
+				for (auto t = std::size_t{1}; t < count; ++t)
+					helpers.emplace_back(work);
+				work();
+			}
+			return matrix(g.nodes(), std::move(d));
+		}
+
+		// Floyd-Warshall does a vectorised min-plus per node triple, against Dijkstra's heap
+		// operations per edge per source. Measured on random graphs, the heap costs about as much
+		// as a hundred min-pluses, so Dijkstra only wins below an average degree of around
+		// nodes / 128. Negative weights always need Floyd-Warshall.
+		inline constexpr std::size_t dense_ratio = 128;
+
+		template<typename N, typename E>
+		auto all_pairs(csr_graph<N, E> const& g, std::size_t threads) -> distance_matrix<N, E> {
+			auto const n = g.node_count();
+			auto const weights = g.edge_weights();
+			auto const negative =
+			   std::any_of(weights.begin(), weights.end(), [](E const& w) { return w < E{}; });
+			if (negative || g.edge_count() * dense_ratio >= n * n)
+				return all_pairs(g, floyd_warshall, threads);
+			return all_pairs(g, repeated_dijkstra, threads);
+		}
+	} // namespace detail
+
+	// Shortest path distances between every pair of nodes, choosing between Floyd-Warshall and
+	// repeated Dijkstra by how dense g is. A thread count of 0 means
+	// std::thread::hardware_concurrency(). The matrix takes nodes^2 weights, so this is meant for
+	// graphs of up to a few thousand nodes.
+	template<typename N, typename E>
+	requires arithmetic<E>
+	auto all_pairs_shortest_paths(graph<N, E> const& g, std::size_t threads = 1)
+	   -> distance_matrix<N, E> {
+		return detail::all_pairs(csr_graph<N, E>(g), threads);
+	}
+
+	template<typename N, typename E, typename Algorithm>
+	requires arithmetic<E>
+	         && (std::same_as<Algorithm, floyd_warshall_t>
+	             || std::same_as<Algorithm, repeated_dijkstra_t>)
+	auto all_pairs_shortest_paths(graph<N, E> const& g, Algorithm algorithm, std::size_t threads = 1)
+	   -> distance_matrix<N, E> {
+		return detail::all_pairs(csr_graph<N, E>(g), algorithm, threads);
+	}
+
+	template<typename N, typename E>
+	requires arithmetic<E>
+	auto all_pairs_shortest_paths(csr_graph<N, E> const& g, std::size_t threads = 1)
+	   -> distance_matrix<N, E> {
+		return detail::all_pairs(g, threads);
+	}
+
+	template<typename N, typename E, typename Algorithm>
+	requires arithmetic<E>
+	         && (std::same_as<Algorithm, floyd_warshall_t>
+	             || std::same_as<Algorithm, repeated_dijkstra_t>)
+	auto all_pairs_shortest_paths(csr_graph<N, E> const& g,
+	                              Algorithm algorithm,
+	                              std::size_t threads = 1) -> distance_matrix<N, E> {
+		return detail::all_pairs(g, algorithm, threads);
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_ALL_PAIRS_SHORTEST_PATHS_HPP
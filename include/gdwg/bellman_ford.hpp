@@ -0,0 +1,420 @@
+#ifndef GDWG_BELLMAN_FORD_HPP
+#define GDWG_BELLMAN_FORD_HPP
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <algorithm>
+#include <barrier>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+	// Found by gdwg::bellman_ford: either the shortest paths from the source, or, when a negative
+	// cycle can be reached from it and there are none, the edges of one such cycle
+	template<typename N, typename E>
+	class bellman_ford_result {
+	public:
+		using value_type = graph_value_type<N, E>;
+
+		explicit bellman_ford_result(shortest_paths_result<N, E> paths)
+		: paths_(std::move(paths)) {}
+
+		explicit bellman_ford_result(std::vector<value_type> cycle)
+		: cycle_(std::move(cycle)) {}
+
+		[[nodiscard]] auto has_negative_cycle() const noexcept -> bool {
+			return !paths_.has_value();
+		}
+
+		// Each edge leads on from the one before, and the last back to the first. Empty if there
+		// is no negative cycle.
+		[[nodiscard]] auto negative_cycle() const noexcept -> std::vector<value_type> const& {
+			return cycle_;
+		}
+
+		[[nodiscard]] auto paths() const -> shortest_paths_result<N, E> const& {
+			if (!paths_) {
+				throw std::runtime_error("Cannot call gdwg::bellman_ford_result<N, E>::paths when "
+				                         "there is a negative cycle");
+			}
+			return *paths_;
+		}
+
+	private:
+		std::optional<shortest_paths_result<N, E>> paths_;
+		std::vector<value_type> cycle_;
+	};
+
+	namespace detail {
+		template<typename E>
+		struct relaxation_state {
+			std::vector<E> distances;
+			std::vector<std::size_t> predecessors;
+			std::vector<bool> reached;
+			// Nodes of a negative cycle, each the predecessor of the next
+			std::vector<std::size_t> cycle;
+		};
+
+		// A cycle among the predecessor links, each node the predecessor of the next, or nothing
+		// if they form a forest. Relaxing an edge only ever lowers distances, so any such cycle
+		// has negative weight. Linear in the number of nodes.
+		inline auto predecessor_cycle(std::span<std::size_t const> predecessors)
+		   -> std::vector<std::size_t> {
+			constexpr auto npos = std::numeric_limits<std::size_t>::max();
+			// The node each node was first walked from
+			auto walk = std::vector<std::size_t>(predecessors.size(), npos);
+			for (auto start = std::size_t{0}; start < predecessors.size(); ++start) {
+				auto v = start;
+				while (v != npos && walk[v] == npos) {
+					walk[v] = start;
+					v = predecessors[v];
+				}
+				if (v == npos || walk[v] != start)
+					continue;
+
+				auto cycle = std::vector<std::size_t>{};
+				auto u = v;
+				do {
+					cycle.push_back(u);
+					u = predecessors[u];
+				} while (u != v);
+				std::reverse(cycle.begin(), cycle.end());
+				return cycle;
+			}
+			return {};
+		}
+
+		// Queue-based Bellman-Ford (SPFA): only nodes whose distance dropped have their edges
+		// relaxed again, and the search ends as soon as none are left. for_each_edge(u, f) calls
+		// f(v, weight) for every edge out of node u.
+		// A node whose path has node_count edges repeats a node, so only a negative cycle can have
+		// shortened it. The cycle is then usually already among the predecessor links; if not,
+		// full passes over the edges put it there within node_count passes.
+		template<typename E, typename ForEachEdge>
+		auto spfa(std::size_t node_count, std::size_t source, ForEachEdge&& for_each_edge)
+		   -> relaxation_state<E> {
+			using size_type = std::size_t;
+			constexpr auto npos = std::numeric_limits<size_type>::max();
+
+			auto state = relaxation_state<E>{std::vector<E>(node_count),
+			                                 std::vector<size_type>(node_count, npos),
+			                                 std::vector<bool>(node_count, false),
+			                                 {}};
+			auto& dist = state.distances;
+			auto& pred = state.predecessors;
+			auto& reached = state.reached;
+			auto negative = false;
+			auto relax = [&](size_type u, size_type v, E const& weight) {
+				auto const candidate = static_cast<E>(dist[u] + weight);
+				if (reached[v] && !(candidate < dist[v]))
+					return false;
+				dist[v] = candidate;
+				pred[v] = u;
+				reached[v] = true;
+				return true;
+			};
+
+			// Edges on the path that last lowered each distance
+			auto length = std::vector<size_type>(node_count, 0);
+			// A ring buffer, as no node is queued twice at once
+			auto queue = std::vector<size_type>(node_count);
+			auto queued = std::vector<bool>(node_count, false);
+			auto head = size_type{0};
+			auto count = size_type{0};
+			auto push = [&](size_type v) {
+				queue[(head + count++) % node_count] = v;
+				queued[v] = true;
+			};
+
+			dist[source] = E{};
+			reached[source] = true;
+			push(source);
+			while (count > 0 && !negative) {
+				auto const u = queue[head];
+				head = (head + 1) % node_count;
+				--count;
+				queued[u] = false;
+
+				for_each_edge(u, [&](size_type v, E const& weight) {
+					if (negative || !relax(u, v, weight))
+						return;
+					length[v] = length[u] + 1;
+					negative = length[v] >= node_count;
+					if (!queued[v])
+						push(v);
+				});
+			}
+			if (!negative)
+				return state;
+
+			state.cycle = predecessor_cycle(pred);
+			while (state.cycle.empty()) {
+				for (auto u = size_type{0}; u < node_count; ++u) {
+					if (reached[u])
+						for_each_edge(u, [&](size_type v, E const& weight) { relax(u, v, weight); });
+				}
+				state.cycle = predecessor_cycle(pred);
+			}
+			return state;
+		}
+
+		// Bellman-Ford in rounds, pulling along in-edges so that every node's distance is written
+		// by one thread and nothing needs to be atomic. Each round reads the distances the last
+		// one left and only relaxes edges out of nodes that it lowered. Without a negative cycle
+		// it settles within node_count rounds; with one, a cycle shows among the predecessor
+		// links by then. They are searched after each power of two rounds and the last.
+		template<typename E>
+		class relaxation_rounds {
+		public:
+			using size_type = std::size_t;
+
+			// in_offsets, in_sources and in_weights are the transposed graph
+			relaxation_rounds(std::span<size_type const> in_offsets,
+			                  std::span<size_type const> in_sources,
+			                  std::span<E const> in_weights)
+			: in_offsets_{in_offsets}
+			, in_sources_{in_sources}
+			, in_weights_{in_weights} {}
+
+			auto run(size_type source, size_type threads) -> relaxation_state<E> {
+				constexpr auto npos = std::numeric_limits<size_type>::max();
+				auto const n = in_offsets_.size() - 1;
+				dist_.assign(n, E{});
+				next_dist_.assign(n, E{});
+				pred_.assign(n, npos);
+				reached_.assign(n, 0);
+				lowered_.assign(n, 0);
+				next_lowered_.assign(n, 0);
+				reached_[source] = 1;
+				lowered_[source] = 1;
+				rounds_ = 0;
+				done_ = false;
+				cycle_.clear();
+
+				// Blocks of nodes with about the same number of in-edges each
+				blocks_ = balanced_blocks(in_offsets_, threads);
+				changed_.assign(threads, 0);
+
+				auto sync = std::barrier(static_cast<std::ptrdiff_t>(threads),
+				                         [this]() noexcept { end_round(); });
+				auto work = [&](size_type t) {
+					while (!done_) {
+						round(t);
+						sync.arrive_and_wait();
+					}
+				};
+
+				{
+					auto helpers = std::vector<std::jthread>{};
+					helpers.reserve(threads - 1);
+					for (auto t = size_type{1}; t < threads; ++t)
+						helpers.emplace_back(work, t);
+					work(0);
+				}
+
+				auto state = relaxation_state<E>{std::move(dist_),
+				                                 std::move(pred_),
+				                                 std::vector<bool>(n, false),
+				                                 std::move(cycle_)};
+				for (auto v = size_type{0}; v < n; ++v)
+					state.reached[v] = reached_[v] != 0;
+				return state;
+			}
+
+		private:
+			std::span<size_type const> in_offsets_;
+			std::span<size_type const> in_sources_;
+			std::span<E const> in_weights_;
+
+			std::vector<E> dist_;
+			std::vector<E> next_dist_;
+			std::vector<size_type> pred_;
+			// Bytes rather than bits, so that threads can write neighbouring nodes
+			std::vector<unsigned char> reached_;
+			std::vector<unsigned char> lowered_;
+			std::vector<unsigned char> next_lowered_;
+			std::vector<size_type> blocks_;
+			// Whether each thread lowered anything this round
+			std::vector<unsigned char> changed_;
+			std::vector<size_type> cycle_;
+			size_type rounds_ = 0;
+			bool done_ = false;
+
+			auto round(size_type t) noexcept -> void {
+				auto changed = false;
+				for (auto v = blocks_[t]; v < blocks_[t + 1]; ++v) {
+					auto best = dist_[v];
+					auto lowered = false;
+					for (auto e = in_offsets_[v]; e < in_offsets_[v + 1]; ++e) {
+						auto const u = in_sources_[e];
+						if (!lowered_[u])
+							continue;
+						auto const candidate = static_cast<E>(dist_[u] + in_weights_[e]);
+						if ((!reached_[v] && !lowered) || candidate < best) {
+							best = candidate;
+							pred_[v] = u;
+							lowered = true;
+						}
+					}
+					next_dist_[v] = best;
+					next_lowered_[v] = lowered ? 1 : 0;
+					if (lowered) {
+						reached_[v] = 1;
+						changed = true;
+					}
+				}
+				changed_[t] = changed ? 1 : 0;
+			}
+
+			// Runs on one thread while the others wait at the barrier
+			auto end_round() noexcept -> void {
+				std::swap(dist_, next_dist_);
+				std::swap(lowered_, next_lowered_);
+				++rounds_;
+				auto const n = dist_.size();
+				if (std::none_of(changed_.begin(), changed_.end(), [](auto c) { return c != 0; })) {
+					done_ = true;
+				}
+				else if (std::has_single_bit(rounds_) || rounds_ >= n) {
+					cycle_ = predecessor_cycle(pred_);
+					done_ = !cycle_.empty() || rounds_ >= n;
+				}
+			}
+		};
+
+		template<typename N>
+		auto find_source(std::vector<N> const& nodes, N const& src) -> std::size_t {
+			auto it = std::lower_bound(nodes.begin(), nodes.end(), src);
+			if (it == nodes.end() || src < *it) {
+				throw std::runtime_error("Cannot call gdwg::bellman_ford if src doesn't exist in the "
+				                         "graph");
+			}
+			return static_cast<std::size_t>(it - nodes.begin());
+		}
+
+		// Edges to the same dst are sorted by weight, so the first is the lightest
+		template<typename N, typename E>
+		auto lightest_weight(csr_graph<N, E> const& g, N const& src, N const& dst) -> E {
+			auto const v = g.index_of(dst);
+			auto e = g.offsets()[g.index_of(src)];
+			while (g.targets()[e] != v)
+				++e;
+			return g.edge_weights()[e];
+		}
+
+		// lightest(src, dst) is the lightest weight of an edge from src to dst
+		template<typename N, typename E, typename Lightest>
+		auto make_result(std::vector<N> nodes,
+		                 std::size_t source,
+		                 relaxation_state<E> state,
+		                 Lightest&& lightest) -> bellman_ford_result<N, E> {
+			if (state.cycle.empty()) {
+				auto paths = shortest_paths_result<N, E>(std::move(nodes),
+				                                         source,
+				                                         std::move(state.distances),
+				                                         std::move(state.predecessors),
+				                                         std::move(state.reached));
+				return bellman_ford_result<N, E>(std::move(paths));
+			}
+
+			auto const& cycle = state.cycle;
+			auto edges = std::vector<graph_value_type<N, E>>{};
+			edges.reserve(cycle.size());
+			for (auto i = std::size_t{0}; i < cycle.size(); ++i) {
+				auto const& from = nodes[cycle[i]];
+				auto const& to = nodes[cycle[(i + 1) % cycle.size()]];
+				edges.emplace_back(from, to, lightest(from, to));
+			}
+			return bellman_ford_result<N, E>(std::move(edges));
+		}
+
+		template<typename N, typename E>
+		auto bellman_ford(csr_graph<N, E> const& g, N const& src, std::size_t threads)
+		   -> bellman_ford_result<N, E> {
+			auto nodes = g.nodes();
+			auto const source = find_source(nodes, src);
+			threads = worker_count(threads, nodes.size());
+
+			auto const reverse = g.transposed();
+			auto rounds =
+			   relaxation_rounds<E>(reverse.offsets(), reverse.targets(), reverse.edge_weights());
+			auto state = rounds.run(source, threads);
+			auto lightest = [&](N const& from, N const& to) { return lightest_weight(g, from, to); };
+			return make_result(std::move(nodes), source, std::move(state), lightest);
+		}
+	} // namespace detail
+
+	// Single source shortest paths that allow negative weights, with queue-based Bellman-Ford
+	// (SPFA). Takes O(nodes * edges) at worst, but usually little more than a few passes over the
+	// edges. If a negative cycle can be reached from src, the result holds one instead.
+	// The graph's edges are relaxed where they are stored; only their dst positions are worked
+	// out beforehand.
+	template<typename N, typename E>
+	requires arithmetic<E>
+	auto bellman_ford(graph<N, E> const& g, N const& src) -> bellman_ford_result<N, E> {
+		auto nodes = g.nodes();
+		auto const source = detail::find_source(nodes, src);
+		auto const [offsets, targets] = detail::adjacency(g, std::span<N const>(nodes));
+
+		auto for_each_edge = [&](std::size_t u, auto&& relax) {
+			auto e = offsets[u];
+			for (auto const& [to, weight] : g.out_edges(nodes[u]))
+				relax(targets[e++], weight);
+		};
+		auto state = detail::spfa<E>(nodes.size(), source, for_each_edge);
+		auto lightest = [&](N const& from, N const& to) { return g.weights(from, to).front(); };
+		return detail::make_result(std::move(nodes), source, std::move(state), lightest);
+	}
+
+	template<typename N, typename E>
+	requires arithmetic<E>
+	auto bellman_ford(csr_graph<N, E> const& g, N const& src) -> bellman_ford_result<N, E> {
+		auto nodes = g.nodes();
+		auto const source = detail::find_source(nodes, src);
+		auto const offsets = g.offsets();
+		auto const targets = g.targets();
+		auto const weights = g.edge_weights();
+
+		auto for_each_edge = [&](std::size_t u, auto&& relax) {
+			for (auto e = offsets[u]; e < offsets[u + 1]; ++e)
+				relax(targets[e], weights[e]);
+		};
+		auto state = detail::spfa<E>(nodes.size(), source, for_each_edge);
+		auto lightest = [&](N const& from, N const& to) {
+			return detail::lightest_weight(g, from, to);
+		};
+		return detail::make_result(std::move(nodes), source, std::move(state), lightest);
+	}
+
+	// As above, but in rounds that each look at every edge, shared out over threads. There are
+	// as many rounds as edges on the longest shortest path, so this only pays off with several
+	// threads on graphs where every node is a few edges from src, such as power-law ones; on
+	// road-like graphs the queue wins. A thread count of 0 means
+	// std::thread::hardware_concurrency().
+	template<typename N, typename E>
+	requires arithmetic<E>
+	auto bellman_ford(graph<N, E> const& g, N const& src, std::size_t threads)
+	   -> bellman_ford_result<N, E> {
+		return detail::bellman_ford(csr_graph<N, E>(g), src, threads);
+	}
+
+	template<typename N, typename E>
+	requires arithmetic<E>
+	auto bellman_ford(csr_graph<N, E> const& g, N const& src, std::size_t threads)
+	   -> bellman_ford_result<N, E> {
+		return detail::bellman_ford(g, src, threads);
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_BELLMAN_FORD_HPP
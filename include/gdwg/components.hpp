@@ -0,0 +1,463 @@
+#ifndef GDWG_COMPONENTS_HPP
+#define GDWG_COMPONENTS_HPP
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+	// A partition of the nodes of a graph into numbered components. Nodes are kept sorted, as in
+	// graph<N, E>::nodes(), and ids()[i] is the component of the i-th of them.
+	template<typename N>
+	class components {
+	public:
+		using size_type = std::size_t;
+
+		static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+		components() = default;
+		components(std::vector<N> nodes, std::vector<size_type> ids, size_type count);
+
+		[[nodiscard]] auto count() const noexcept -> size_type {
+			return member_offsets_.size() - 1;
+		}
+		[[nodiscard]] auto nodes() const noexcept -> std::span<N const> {
+			return nodes_;
+		}
+		[[nodiscard]] auto ids() const noexcept -> std::span<size_type const> {
+			return ids_;
+		}
+		[[nodiscard]] auto index_of(N const& value) const noexcept -> size_type;
+		[[nodiscard]] auto component(N const& value) const -> size_type;
+		// The nodes in component id, sorted
+		[[nodiscard]] auto members(size_type id) const -> std::vector<N>;
+
+		[[nodiscard]] auto operator==(components const& other) const noexcept -> bool = default;
+
+	private:
+		std::vector<N> nodes_;
+		std::vector<size_type> ids_;
+		// Node indices grouped by component, with member_offsets_[id] .. member_offsets_[id + 1]
+		// delimiting component id
+		std::vector<size_type> member_offsets_ = std::vector<size_type>(1, 0);
+		std::vector<size_type> members_;
+	};
+
+	template<typename N>
+	components<N>::components(std::vector<N> nodes, std::vector<size_type> ids, size_type count)
+	: nodes_(std::move(nodes))
+	, ids_(std::move(ids)) {
+		member_offsets_.assign(count + 1, 0);
+		for (auto const id : ids_)
+			++member_offsets_[id + 1];
+		std::partial_sum(member_offsets_.begin(), member_offsets_.end(), member_offsets_.begin());
+
+		members_.resize(ids_.size());
+		auto next = std::vector<size_type>(member_offsets_.begin(), member_offsets_.end() - 1);
+		for (auto i = size_type{0}; i < ids_.size(); ++i)
+			members_[next[ids_[i]]++] = i;
+	}
+
+	template<typename N>
+	[[nodiscard]] auto components<N>::index_of(N const& value) const noexcept -> size_type {
+		auto it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+		return (it != nodes_.end() && !(value < *it)) ? static_cast<size_type>(it - nodes_.begin())
+		                                              : npos;
+	}
+
+	template<typename N>
+	[[nodiscard]] auto components<N>::component(N const& value) const -> size_type {
+		auto const i = index_of(value);
+		if (i == npos) {
+			throw std::runtime_error("Cannot call gdwg::components<N>::component if value doesn't "
+			                         "exist in the graph");
+		}
+		return ids_[i];
+	}
+
+	template<typename N>
+	[[nodiscard]] auto components<N>::members(size_type id) const -> std::vector<N> {
+		if (id >= count()) {
+			throw std::runtime_error("Cannot call gdwg::components<N>::members if id isn't a "
+			                         "component");
+		}
+		auto result = std::vector<N>{};
+		result.reserve(member_offsets_[id + 1] - member_offsets_[id]);
+		for (auto m = member_offsets_[id]; m < member_offsets_[id + 1]; ++m)
+			result.push_back(nodes_[members_[m]]);
+		return result;
+	}
+
+	namespace detail {
+		// Tarjan's algorithm over an adjacency list in compressed-sparse-row form, with an explicit
+		// stack of (node, next edge) frames so that long paths can't overflow the call stack.
+		// Tarjan finds every component after the ones it has edges into, so ids are handed out from
+		// the top down: every edge between two components goes from a lower id to a higher one.
+		inline auto strong_component_ids(std::span<std::size_t const> offsets,
+		                                 std::span<std::size_t const> targets)
+		   -> std::pair<std::vector<std::size_t>, std::size_t> {
+			constexpr auto unset = std::numeric_limits<std::size_t>::max();
+			auto const n = offsets.size() - 1;
+
+			struct frame {
+				std::size_t node;
+				std::size_t next;
+			};
+
+			// A node is on Tarjan's stack while it has an order but no id yet
+			auto order = std::vector<std::size_t>(n, unset);
+			auto low = std::vector<std::size_t>(n);
+			auto ids = std::vector<std::size_t>(n, unset);
+			auto stack = std::vector<std::size_t>{};
+			auto frames = std::vector<frame>{};
+			auto visited = std::size_t{0};
+			auto found = std::size_t{0};
+
+			auto enter = [&](std::size_t u) {
+				order[u] = low[u] = visited++;
+				stack.push_back(u);
+				frames.push_back(frame{u, offsets[u]});
+			};
+
+			for (auto root = std::size_t{0}; root < n; ++root) {
+				if (order[root] != unset)
+					continue;
+				enter(root);
+				while (!frames.empty()) {
+					auto& top = frames.back();
+					auto const u = top.node;
+					if (top.next < offsets[u + 1]) {
+						auto const v = targets[top.next++];
+						if (order[v] == unset)
+							enter(v);
+						else if (ids[v] == unset)
+							low[u] = std::min(low[u], order[v]);
+						continue;
+					}
+
+					frames.pop_back();
+					if (low[u] == order[u]) {
+						auto v = unset;
+						do {
+							v = stack.back();
+							stack.pop_back();
+							ids[v] = found;
+						} while (v != u);
+						++found;
+					}
+					if (!frames.empty()) {
+						auto const parent = frames.back().node;
+						low[parent] = std::min(low[parent], low[u]);
+					}
+				}
+			}
+
+			for (auto& id : ids)
+				id = found - 1 - id;
+			return {std::move(ids), found};
+		}
+
+		// Disjoint sets over dense indices, with union by rank and path compression, so that any
+		// sequence of operations takes near constant time each
+		class disjoint_sets {
+		public:
+			disjoint_sets() = default;
+			explicit disjoint_sets(std::size_t n)
+			: parent_(n)
+			, rank_(n, 0)
+			, set_count_{n} {
+				std::iota(parent_.begin(), parent_.end(), std::size_t{0});
+			}
+
+			[[nodiscard]] auto size() const noexcept -> std::size_t {
+				return parent_.size();
+			}
+			[[nodiscard]] auto set_count() const noexcept -> std::size_t {
+				return set_count_;
+			}
+
+			// Adds a set of its own and returns its index
+			auto add() -> std::size_t {
+				parent_.push_back(parent_.size());
+				rank_.push_back(0);
+				++set_count_;
+				return parent_.size() - 1;
+			}
+
+			auto find(std::size_t x) noexcept -> std::size_t {
+				auto root = x;
+				while (parent_[root] != root)
+					root = parent_[root];
+				while (parent_[x] != root)
+					x = std::exchange(parent_[x], root);
+				return root;
+			}
+
+			// Returns false if a and b were already in the same set
+			auto unite(std::size_t a, std::size_t b) noexcept -> bool {
+				a = find(a);
+				b = find(b);
+				if (a == b)
+					return false;
+				if (rank_[a] < rank_[b])
+					std::swap(a, b);
+				parent_[b] = a;
+				if (rank_[a] == rank_[b])
+					++rank_[a];
+				--set_count_;
+				return true;
+			}
+
+		private:
+			std::vector<std::size_t> parent_;
+			// Ranks bound tree heights by log2 n, so a byte is plenty
+			std::vector<unsigned char> rank_;
+			std::size_t set_count_ = 0;
+		};
+
+		// Numbers the sets by their lowest member
+		inline auto set_ids(disjoint_sets& sets) -> std::pair<std::vector<std::size_t>, std::size_t> {
+			constexpr auto unset = std::numeric_limits<std::size_t>::max();
+			auto ids = std::vector<std::size_t>(sets.size(), unset);
+			auto count = std::size_t{0};
+			for (auto i = std::size_t{0}; i < sets.size(); ++i) {
+				auto const root = sets.find(i);
+				if (ids[root] == unset)
+					ids[root] = count++;
+				ids[i] = ids[root];
+			}
+			return {std::move(ids), count};
+		}
+
+		// Component ids as nodes, then the edges between them in one bulk insert
+		template<typename E>
+		auto build_condensation(std::size_t count,
+		                        std::vector<graph_value_type<std::size_t, E>> const& edges)
+		   -> graph<std::size_t, E> {
+			auto ids = std::vector<std::size_t>(count);
+			std::iota(ids.begin(), ids.end(), std::size_t{0});
+			auto result = graph<std::size_t, E>(ids.begin(), ids.end());
+			result.insert_edges(edges.begin(), edges.end());
+			return result;
+		}
+	} // namespace detail
+
+	// Strongly connected components, numbered in topological order of the condensation: every
+	// edge between two components goes from a lower id to a higher one. Linear in nodes + edges.
+	template<typename N, typename E>
+	auto strongly_connected_components(graph<N, E> const& g) -> components<N> {
+		auto nodes = g.nodes();
+		auto const [offsets, targets] = detail::adjacency(g, std::span<N const>(nodes));
+		auto [ids, count] = detail::strong_component_ids(offsets, targets);
+		return components<N>(std::move(nodes), std::move(ids), count);
+	}
+
+	template<typename N, typename E>
+	auto strongly_connected_components(csr_graph<N, E> const& g) -> components<N> {
+		auto [ids, count] = detail::strong_component_ids(g.offsets(), g.targets());
+		return components<N>(g.nodes(), std::move(ids), count);
+	}
+
+	// The graph with every strongly connected component merged into one node, named by its id.
+	// Edges inside a component are dropped; edges between components keep their weights, and
+	// ones that end up with the same src, dst and weight are merged like any other repeated edge.
+	// scc has to be strongly_connected_components(g).
+	template<typename N, typename E>
+	auto condensation(graph<N, E> const& g, components<N> const& scc) -> graph<std::size_t, E> {
+		auto const nodes = g.nodes();
+		if (!std::ranges::equal(nodes, scc.nodes())) {
+			throw std::runtime_error("Cannot call gdwg::condensation if scc doesn't partition the "
+			                         "nodes of g");
+		}
+
+		auto const ids = scc.ids();
+		auto edges = std::vector<graph_value_type<std::size_t, E>>{};
+		detail::for_each_indexed_edge(g,
+		                              std::span<N const>(nodes),
+		                              [&](std::size_t src, std::size_t dst, auto const& edge) {
+			                              if (ids[src] != ids[dst])
+				                              edges.emplace_back(ids[src], ids[dst], edge.weight);
+		                              });
+		return detail::build_condensation(scc.count(), edges);
+	}
+
+	template<typename N, typename E>
+	auto condensation(csr_graph<N, E> const& g, components<N> const& scc) -> graph<std::size_t, E> {
+		if (!std::ranges::equal(g.nodes(), scc.nodes())) {
+			throw std::runtime_error("Cannot call gdwg::condensation if scc doesn't partition the "
+			                         "nodes of g");
+		}
+
+		auto const ids = scc.ids();
+		auto const offsets = g.offsets();
+		auto const targets = g.targets();
+		auto const weights = g.edge_weights();
+		auto edges = std::vector<graph_value_type<std::size_t, E>>{};
+		for (auto src = std::size_t{0}; src < g.node_count(); ++src) {
+			for (auto e = offsets[src]; e < offsets[src + 1]; ++e) {
+				if (ids[src] != ids[targets[e]])
+					edges.emplace_back(ids[src], ids[targets[e]], weights[e]);
+			}
+		}
+		return detail::build_condensation(scc.count(), edges);
+	}
+
+	// Weakly connected components: nodes joined by edges in either direction. Linear in nodes +
+	// edges, numbered in order of each component's lowest node.
+	template<typename N, typename E>
+	auto weak_components(graph<N, E> const& g) -> components<N> {
+		auto nodes = g.nodes();
+		auto sets = detail::disjoint_sets(nodes.size());
+		detail::for_each_indexed_edge(g,
+		                              std::span<N const>(nodes),
+		                              [&](std::size_t src, std::size_t dst, auto const&) {
+			                              sets.unite(src, dst);
+		                              });
+		auto [ids, count] = detail::set_ids(sets);
+		return components<N>(std::move(nodes), std::move(ids), count);
+	}
+
+	template<typename N, typename E>
+	auto weak_components(csr_graph<N, E> const& g) -> components<N> {
+		auto sets = detail::disjoint_sets(g.node_count());
+		auto const offsets = g.offsets();
+		auto const targets = g.targets();
+		for (auto src = std::size_t{0}; src < g.node_count(); ++src) {
+			for (auto e = offsets[src]; e < offsets[src + 1]; ++e)
+				sets.unite(src, targets[e]);
+		}
+		auto [ids, count] = detail::set_ids(sets);
+		return components<N>(g.nodes(), std::move(ids), count);
+	}
+
+	// A graph that keeps its weakly connected components up to date as it grows. insert_node and
+	// insert_edge go through to the graph and merge components as they go, so connected(a, b)
+	// answers in near constant time without a traversal. Components can't be split again, so nodes
+	// and edges can't be erased or replaced; take the graph back with as_graph() to do that.
+	// Everything that doesn't modify the graph goes through as_graph().
+	template<typename N, typename E>
+	class incremental_components {
+	public:
+		using value_type = typename graph<N, E>::value_type;
+		using size_type = std::size_t;
+
+		incremental_components() = default;
+		incremental_components(std::initializer_list<N> il);
+		explicit incremental_components(graph<N, E> g);
+
+		[[nodiscard]] auto as_graph() const noexcept -> graph<N, E> const& {
+			return g_;
+		}
+		[[nodiscard]] auto count() const noexcept -> size_type {
+			return sets_.set_count();
+		}
+		// Not const, since lookups shorten the paths they follow
+		[[nodiscard]] auto connected(N const& a, N const& b) -> bool;
+
+		auto insert_node(N const& value) -> bool;
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool;
+		auto clear() noexcept -> void;
+
+		[[nodiscard]] auto operator==(incremental_components const& other) const noexcept -> bool {
+			return g_ == other.g_;
+		}
+
+	private:
+		using index_type = std::conditional_t<detail::hashable<N>,
+		                                      std::unordered_map<N, size_type>,
+		                                      std::map<N, size_type>>;
+
+		static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+		graph<N, E> g_;
+		// Each node's set, numbered in the order the nodes arrived
+		index_type index_;
+		detail::disjoint_sets sets_;
+
+		[[nodiscard]] auto lookup(N const& value) const -> size_type {
+			auto const it = index_.find(value);
+			return it == index_.end() ? npos : it->second;
+		}
+	};
+
+	template<typename N, typename E>
+	incremental_components<N, E>::incremental_components(std::initializer_list<N> il)
+	: g_(il) {
+		for (auto const& value : il) {
+			if (index_.try_emplace(value, sets_.size()).second)
+				sets_.add();
+		}
+	}
+
+	template<typename N, typename E>
+	incremental_components<N, E>::incremental_components(graph<N, E> g)
+	: g_(std::move(g)) {
+		auto const nodes = g_.nodes();
+		sets_ = detail::disjoint_sets(nodes.size());
+		for (auto i = size_type{0}; i < nodes.size(); ++i)
+			index_.emplace(nodes[i], i);
+		detail::for_each_indexed_edge(g_,
+		                              std::span<N const>(nodes),
+		                              [&](size_type src, size_type dst, auto const&) {
+			                              sets_.unite(src, dst);
+		                              });
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto incremental_components<N, E>::connected(N const& a, N const& b) -> bool {
+		auto const i = lookup(a);
+		auto const j = lookup(b);
+		if (i == npos || j == npos) {
+			throw std::runtime_error("Cannot call gdwg::incremental_components<N, E>::connected if "
+			                         "either node doesn't exist");
+		}
+		return sets_.find(i) == sets_.find(j);
+	}
+
+	template<typename N, typename E>
+	auto incremental_components<N, E>::insert_node(N const& value) -> bool {
+		if (!g_.insert_node(value))
+			return false;
+		index_.emplace(value, sets_.size());
+		sets_.add();
+		return true;
+	}
+
+	template<typename N, typename E>
+	auto incremental_components<N, E>::insert_edge(N const& src, N const& dst, E const& weight)
+	   -> bool {
+		auto const a = lookup(src);
+		auto const b = lookup(dst);
+		if (a == npos || b == npos) {
+			throw std::runtime_error("Cannot call gdwg::incremental_components<N, E>::insert_edge "
+			                         "when either src or dst node does not exist");
+		}
+		if (!g_.insert_edge(src, dst, weight))
+			return false;
+		sets_.unite(a, b);
+		return true;
+	}
+
+	template<typename N, typename E>
+	auto incremental_components<N, E>::clear() noexcept -> void {
+		g_.clear();
+		index_.clear();
+		sets_ = detail::disjoint_sets();
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_COMPONENTS_HPP
@@ -0,0 +1,728 @@
+#ifndef GDWG_CONTRACTION_HIERARCHY_HPP
+#define GDWG_CONTRACTION_HIERARCHY_HPP
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+	namespace detail {
+		template<typename E>
+		struct hierarchy_arc {
+			std::size_t node;
+			E weight;
+			// The node a shortcut was added for, or npos for an edge of the original graph
+			std::size_t middle;
+
+			[[nodiscard]] auto operator==(hierarchy_arc const&) const noexcept -> bool = default;
+		};
+
+		// Arcs of a contraction hierarchy that lead to a node contracted later, grouped by the node
+		// they are stored at, as in csr_graph
+		template<typename E>
+		struct upward_arcs {
+			std::vector<std::size_t> offsets = {0};
+			std::vector<hierarchy_arc<E>> arcs;
+
+			[[nodiscard]] auto operator==(upward_arcs const&) const noexcept -> bool = default;
+
+			// The middle of the arc from node to target, or npos if there isn't one
+			[[nodiscard]] auto middle(std::size_t node, std::size_t target) const noexcept
+			   -> std::size_t {
+				for (auto e = offsets[node]; e < offsets[node + 1]; ++e) {
+					if (arcs[e].node == target)
+						return arcs[e].middle;
+				}
+				return std::numeric_limits<std::size_t>::max();
+			}
+		};
+
+		template<typename E>
+		struct shortcut {
+			std::size_t from;
+			std::size_t to;
+			E weight;
+		};
+
+		// The graph as it is being contracted. Contracting a node takes its arcs out of its
+		// neighbours' lists, which leaves it with just the arcs to nodes contracted after it.
+		template<typename E>
+		struct contraction_graph {
+			std::vector<std::vector<hierarchy_arc<E>>> out;
+			std::vector<std::vector<hierarchy_arc<E>>> in;
+
+			// Adds an arc, or lowers the weight of the one already there
+			auto add(std::size_t from, std::size_t to, E weight, std::size_t middle) -> void {
+				auto forward = std::find_if(out[from].begin(), out[from].end(), to_node(to));
+				if (forward == out[from].end()) {
+					out[from].push_back({to, weight, middle});
+					in[to].push_back({from, weight, middle});
+				}
+				else if (weight < forward->weight) {
+					*forward = {to, weight, middle};
+					*std::find_if(in[to].begin(), in[to].end(), to_node(from)) = {from, weight, middle};
+				}
+			}
+
+			auto remove(std::size_t v) -> void {
+				for (auto const& arc : out[v])
+					std::erase_if(in[arc.node], to_node(v));
+				for (auto const& arc : in[v])
+					std::erase_if(out[arc.node], to_node(v));
+			}
+
+		private:
+			static auto to_node(std::size_t node) {
+				return [node](hierarchy_arc<E> const& arc) { return arc.node == node; };
+			}
+		};
+
+		// Dijkstra from one in-neighbour of the node being contracted over the nodes still left,
+		// looking for paths to its out-neighbours that don't go through it. The search stops once
+		// it has settled all of them, and gives up past a distance limit or a number of settled
+		// nodes, in which case a shortcut is added that might not have been needed. Marks are
+		// stamped with the search they belong to, so nothing is cleared between searches.
+		template<typename E>
+		class witness_search {
+		public:
+			using size_type = std::size_t;
+			static constexpr size_type settle_limit = 256;
+
+			explicit witness_search(size_type node_count)
+			: dist_(node_count)
+			, stamp_(node_count, 0)
+			, target_(node_count, 0) {}
+
+			// Searches from the src of in to the dsts of outs, other than the src itself
+			auto run(contraction_graph<E> const& g,
+			         hierarchy_arc<E> const& in,
+			         size_type avoid,
+			         std::span<hierarchy_arc<E> const> outs) -> void {
+				++current_;
+				heap_.clear();
+				auto remaining = size_type{0};
+				auto limit = E{};
+				for (auto const& out : outs) {
+					if (out.node == in.node || target_[out.node] == current_)
+						continue;
+					target_[out.node] = current_;
+					++remaining;
+					limit = std::max(limit, static_cast<E>(in.weight + out.weight));
+				}
+
+				reach(in.node, E{});
+				auto settled = size_type{0};
+				while (remaining > 0 && !heap_.empty() && settled < settle_limit) {
+					std::pop_heap(heap_.begin(), heap_.end(), std::greater<>{});
+					auto const [d, u] = heap_.back();
+					heap_.pop_back();
+					if (dist_[u] < d)
+						continue;
+					if (limit < d)
+						break;
+					++settled;
+					if (target_[u] == current_)
+						--remaining;
+					for (auto const& arc : g.out[u]) {
+						if (arc.node != avoid)
+							reach(arc.node, static_cast<E>(d + arc.weight));
+					}
+				}
+			}
+
+			// Whether the last search found a path to v no longer than distance
+			[[nodiscard]] auto within(size_type v, E distance) const noexcept -> bool {
+				return stamp_[v] == current_ && !(distance < dist_[v]);
+			}
+
+		private:
+			std::vector<E> dist_;
+			std::vector<size_type> stamp_;
+			std::vector<size_type> target_;
+			size_type current_ = 0;
+			std::vector<std::pair<E, size_type>> heap_;
+
+			auto reach(size_type v, E distance) -> void {
+				if (stamp_[v] == current_ && !(distance < dist_[v]))
+					return;
+				stamp_[v] = current_;
+				dist_[v] = distance;
+				heap_.emplace_back(distance, v);
+				std::push_heap(heap_.begin(), heap_.end(), std::greater<>{});
+			}
+		};
+
+		// Arcs of a contraction hierarchy with nodes numbered in the order they were contracted,
+		// so that the nodes near the top, which every query reaches, sit together in memory.
+		// ranks maps the index of a node in the graph to its number.
+		template<typename E>
+		struct ranked_hierarchy {
+			std::vector<std::size_t> ranks;
+			upward_arcs<E> forward;
+			upward_arcs<E> backward;
+		};
+
+		// Contracts the nodes of a graph one at a time, least important first. A node's priority
+		// is its edge difference, the shortcuts contracting it would add less the arcs it would
+		// take out of the remaining graph, plus how many of its neighbours are already contracted
+		// and how deep the hierarchy below it is, which spread contraction evenly over the graph
+		// and keep queries from climbing long chains. Priorities are worked out up front, shared
+		// out over threads, and then kept up to date lazily: the node at the front of the queue
+		// is checked again before it is contracted and goes back if it no longer comes first.
+		template<typename E>
+		class contraction {
+		public:
+			using size_type = std::size_t;
+			static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+			contraction(std::span<size_type const> offsets,
+			            std::span<size_type const> targets,
+			            std::span<E const> weights) {
+				auto const n = offsets.size() - 1;
+				g_.out.resize(n);
+				g_.in.resize(n);
+				// Edges to one dst are sorted by weight, so the first is the lightest
+				for (auto u = size_type{0}; u < n; ++u) {
+					for (auto e = offsets[u]; e < offsets[u + 1]; ++e) {
+						if (targets[e] != u && (e == offsets[u] || targets[e - 1] != targets[e]))
+							g_.add(u, targets[e], weights[e], npos);
+					}
+				}
+			}
+
+			auto run(size_type threads) -> ranked_hierarchy<E> {
+				auto const n = g_.out.size();
+				deleted_neighbours_.assign(n, 0);
+				levels_.assign(n, 0);
+				priorities_.assign(n, 0);
+				initial_priorities(threads);
+
+				using entry = std::pair<std::ptrdiff_t, size_type>;
+				auto queue = std::priority_queue<entry, std::vector<entry>, std::greater<>>{};
+				for (auto v = size_type{0}; v < n; ++v)
+					queue.emplace(priorities_[v], v);
+
+				auto witness = witness_search<E>(n);
+				auto shortcuts = std::vector<shortcut<E>>{};
+				auto contracted = std::vector<bool>(n, false);
+				auto ranks = std::vector<size_type>(n, 0);
+				auto next_rank = size_type{0};
+				while (!queue.empty()) {
+					auto const [priority, v] = queue.top();
+					queue.pop();
+					if (contracted[v] || priority != priorities_[v])
+						continue;
+
+					priorities_[v] = simulate(v, witness, shortcuts);
+					if (!queue.empty() && queue.top().first < priorities_[v]) {
+						queue.emplace(priorities_[v], v);
+						continue;
+					}
+
+					contracted[v] = true;
+					ranks[v] = next_rank++;
+					for (auto const& s : shortcuts)
+						g_.add(s.from, s.to, s.weight, v);
+					g_.remove(v);
+					for (auto const* arcs : {&g_.in[v], &g_.out[v]}) {
+						for (auto const& arc : *arcs) {
+							++deleted_neighbours_[arc.node];
+							levels_[arc.node] = std::max(levels_[arc.node], levels_[v] + 1);
+						}
+					}
+				}
+				return {ranks, upward(ranks, g_.out), upward(ranks, g_.in)};
+			}
+
+		private:
+			contraction_graph<E> g_;
+			std::vector<std::ptrdiff_t> deleted_neighbours_;
+			std::vector<std::ptrdiff_t> levels_;
+			std::vector<std::ptrdiff_t> priorities_;
+
+			// The shortcuts contracting v would need, and the priority that gives it
+			auto simulate(size_type v, witness_search<E>& witness, std::vector<shortcut<E>>& shortcuts)
+			   -> std::ptrdiff_t {
+				shortcuts.clear();
+				for (auto const& in : g_.in[v]) {
+					witness.run(g_, in, v, g_.out[v]);
+					for (auto const& out : g_.out[v]) {
+						auto const through = static_cast<E>(in.weight + out.weight);
+						if (out.node != in.node && !witness.within(out.node, through))
+							shortcuts.push_back({in.node, out.node, through});
+					}
+				}
+				auto const arcs = g_.in[v].size() + g_.out[v].size();
+				return static_cast<std::ptrdiff_t>(shortcuts.size()) - static_cast<std::ptrdiff_t>(arcs)
+				       + deleted_neighbours_[v] + levels_[v];
+			}
+
+			auto initial_priorities(size_type threads) -> void {
+				auto const n = g_.out.size();
+				auto next = std::atomic<size_type>{0};
+				auto work = [&] {
+					auto witness = witness_search<E>(n);
+					auto shortcuts = std::vector<shortcut<E>>{};
+					constexpr auto chunk = size_type{256};
+					for (auto first = next.fetch_add(chunk); first < n; first = next.fetch_add(chunk)) {
+						for (auto v = first; v < std::min(n, first + chunk); ++v)
+							priorities_[v] = simulate(v, witness, shortcuts);
+					}
+				};
+
+				auto helpers = std::vector<std::jthread>{};
+				helpers.reserve(threads - 1);
+				for (auto t = size_type{1}; t < threads; ++t)
+					helpers.emplace_back(work);
+				work();
+			}
+
+			// What each node had left when it was contracted, renumbered by rank
+			static auto upward(std::vector<size_type> const& ranks,
+			                   std::vector<std::vector<hierarchy_arc<E>>> const& lists)
+			   -> upward_arcs<E> {
+				auto const n = lists.size();
+				auto arcs = upward_arcs<E>{std::vector<size_type>(n + 1, 0), {}};
+				for (auto v = size_type{0}; v < n; ++v)
+					arcs.offsets[ranks[v] + 1] = lists[v].size();
+				std::partial_sum(arcs.offsets.begin(), arcs.offsets.end(), arcs.offsets.begin());
+				arcs.arcs.resize(arcs.offsets.back());
+				for (auto v = size_type{0}; v < n; ++v) {
+					auto e = arcs.offsets[ranks[v]];
+					for (auto const& arc : lists[v]) {
+						auto const middle = arc.middle == npos ? npos : ranks[arc.middle];
+						arcs.arcs[e++] = {ranks[arc.node], arc.weight, middle};
+					}
+				}
+				return arcs;
+			}
+		};
+
+		// Working memory for hierarchy queries, kept by each thread between queries. Marks are
+		// stamped with the query they belong to, so only what a query touches costs anything.
+		// Everything about a node sits together, as the nodes a query touches are scattered.
+		template<typename E>
+		struct upward_search {
+			struct label {
+				E dist;
+				// The node and arc the node was reached by
+				std::size_t pred;
+				std::size_t pred_arc;
+				std::uint64_t seen;
+				std::uint64_t settled;
+			};
+			std::vector<label> labels;
+			std::vector<std::pair<E, std::size_t>> heap;
+
+			auto reset(std::size_t node_count) -> void {
+				if (labels.size() < node_count)
+					labels.resize(node_count, label{E{}, 0, 0, 0, 0});
+				heap.clear();
+			}
+		};
+	} // namespace detail
+
+	// Contraction hierarchy over a graph that doesn't change, for point-to-point shortest paths
+	// that settle a few hundred nodes where Dijkstra settles a large part of the graph.
+	// Preprocessing contracts the nodes one at a time, least important first, adding shortcuts
+	// between the neighbours of each wherever a short local search finds no path that avoids it.
+	// Every node then only needs to be searched upwards, towards nodes contracted after it: a
+	// query searches up from src along arcs forwards and up from dst along arcs backwards, and the
+	// two meet at the highest node of a shortest path. Shortcuts are unpacked into the edges of
+	// the original graph. Weights must not be negative.
+	template<typename N, typename E>
+	requires arithmetic<E>
+	class contraction_hierarchy {
+	public:
+		using size_type = std::size_t;
+
+		contraction_hierarchy() = default;
+		// A thread count of 0 means std::thread::hardware_concurrency()
+		explicit contraction_hierarchy(graph<N, E> const& g, size_type threads = 1)
+		: contraction_hierarchy(csr_graph<N, E>(g), threads) {}
+		explicit contraction_hierarchy(csr_graph<N, E> const& g, size_type threads = 1);
+
+		// Searches the hierarchy in time that depends on the nodes it settles, not the size of
+		// the graph. Safe to call from several threads at once.
+		[[nodiscard]] auto shortest_path(N const& src, N const& dst) const
+		   -> shortest_path_result<N, E>;
+
+		[[nodiscard]] auto nodes() const noexcept -> std::span<N const> {
+			return nodes_;
+		}
+		[[nodiscard]] auto node_count() const noexcept -> size_type {
+			return nodes_.size();
+		}
+		[[nodiscard]] auto shortcut_count() const noexcept -> size_type {
+			auto count = size_type{0};
+			for (auto const* arcs : {&forward_, &backward_}) {
+				count += static_cast<size_type>(
+				   std::count_if(arcs->arcs.begin(), arcs->arcs.end(), [](auto const& arc) {
+					   return arc.middle != npos;
+				   }));
+			}
+			return count;
+		}
+
+		// Binary format in the machine's byte order, for node and weight types that are
+		// trivially copyable. save and load must agree on N and E.
+		auto save(std::ostream& os) const -> void
+		requires std::is_trivially_copyable_v<N> && std::is_trivially_copyable_v<E>;
+		[[nodiscard]] static auto load(std::istream& is) -> contraction_hierarchy
+		requires std::is_trivially_copyable_v<N> && std::is_trivially_copyable_v<E>;
+
+		[[nodiscard]] auto operator==(contraction_hierarchy const&) const noexcept -> bool = default;
+
+	private:
+		static constexpr size_type npos = std::numeric_limits<size_type>::max();
+		static constexpr char magic[8] = {'g', 'd', 'w', 'g', '-', 'c', 'h', '1'};
+
+		std::vector<N> nodes_;
+		// Arcs number nodes by when they were contracted: ranks_ maps the index of a node in
+		// nodes_ to its number, and order_ maps back
+		std::vector<size_type> ranks_;
+		std::vector<size_type> order_;
+		detail::upward_arcs<E> forward_;
+		detail::upward_arcs<E> backward_;
+
+		auto set_ranks(std::vector<size_type> ranks) -> void {
+			ranks_ = std::move(ranks);
+			order_.resize(ranks_.size());
+			for (auto i = size_type{0}; i < ranks_.size(); ++i)
+				order_[ranks_[i]] = i;
+		}
+
+		struct segment {
+			size_type from;
+			size_type to;
+			size_type middle;
+		};
+
+		// The path from src along arcs taken off the back of pending, with shortcuts unpacked
+		auto unpack(N const& src, std::vector<segment> pending) const -> std::vector<N>;
+	};
+
+	template<typename N, typename E>
+	requires arithmetic<E>
+	contraction_hierarchy<N, E>::contraction_hierarchy(csr_graph<N, E> const& g, size_type threads)
+	: nodes_(g.nodes()) {
+		auto const weights = g.edge_weights();
+		if (std::any_of(weights.begin(), weights.end(), [](E const& w) { return w < E{}; })) {
+			throw std::runtime_error("Cannot construct gdwg::contraction_hierarchy<N, E> from a graph "
+			                         "with negative weights");
+		}
+		threads = detail::worker_count(threads, nodes_.size());
+
+		auto hierarchy = detail::contraction<E>(g.offsets(), g.targets(), weights).run(threads);
+		set_ranks(std::move(hierarchy.ranks));
+		forward_ = std::move(hierarchy.forward);
+		backward_ = std::move(hierarchy.backward);
+	}
+
+	template<typename N, typename E>
+	requires arithmetic<E>
+	[[nodiscard]] auto contraction_hierarchy<N, E>::shortest_path(N const& src, N const& dst) const
+	   -> shortest_path_result<N, E> {
+		auto index_of = [this](N const& value) {
+			auto it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			return (it != nodes_.end() && !(value < *it)) ? static_cast<size_type>(it - nodes_.begin())
+			                                              : npos;
+		};
+		auto const src_index = index_of(src);
+		auto const dst_index = index_of(dst);
+		if (src_index == npos || dst_index == npos) {
+			throw std::runtime_error("Cannot call gdwg::contraction_hierarchy<N, E>::shortest_path if "
+			                         "src or dst node don't exist in the graph");
+		}
+		auto const source = ranks_[src_index];
+		auto const target = ranks_[dst_index];
+
+		// Each query is numbered, and a node counts as seen or settled by the query whose number
+		// it holds
+		thread_local auto searches = std::pair<detail::upward_search<E>, detail::upward_search<E>>{};
+		thread_local auto query = std::uint64_t{0};
+		++query;
+		auto& [forward, backward] = searches;
+		forward.reset(nodes_.size());
+		backward.reset(nodes_.size());
+
+		auto start = [](detail::upward_search<E>& side, size_type node) {
+			side.labels[node] = {E{}, npos, npos, query, 0};
+			side.heap.emplace_back(E{}, node);
+		};
+		start(forward, source);
+		start(backward, target);
+
+		auto best = std::optional<E>{};
+		auto meet = npos;
+		auto settled = size_type{0};
+		auto step = [&](detail::upward_search<E>& here,
+		                detail::upward_search<E> const& there,
+		                detail::upward_arcs<E> const& arcs,
+		                detail::upward_arcs<E> const& down) {
+			std::pop_heap(here.heap.begin(), here.heap.end(), std::greater<>{});
+			auto const [d, u] = here.heap.back();
+			here.heap.pop_back();
+			auto& label = here.labels[u];
+			if (label.settled == query || label.dist < d)
+				return;
+			label.settled = query;
+			++settled;
+			if (auto const& other = there.labels[u]; other.seen == query) {
+				auto const through = static_cast<E>(d + other.dist);
+				if (!best || through < *best) {
+					best = through;
+					meet = u;
+				}
+			}
+
+			// Stall on demand: a higher node this side has reached gets to u for less, so no
+			// shortest path goes up through u and its arcs needn't be followed
+			for (auto e = down.offsets[u]; e < down.offsets[u + 1]; ++e) {
+				auto const& above = here.labels[down.arcs[e].node];
+				if (above.seen == query && above.dist + down.arcs[e].weight < d)
+					return;
+			}
+
+			for (auto e = arcs.offsets[u]; e < arcs.offsets[u + 1]; ++e) {
+				auto const v = arcs.arcs[e].node;
+				auto const candidate = static_cast<E>(d + arcs.arcs[e].weight);
+				auto& next = here.labels[v];
+				if (next.seen != query || candidate < next.dist) {
+					next = {candidate, u, e, query, next.settled};
+					here.heap.emplace_back(candidate, v);
+					std::push_heap(here.heap.begin(), here.heap.end(), std::greater<>{});
+				}
+			}
+		};
+
+		// Each side stops once nothing left in it can improve on the best meeting so far
+		auto open = [&](detail::upward_search<E> const& side) {
+			return !side.heap.empty() && (!best || side.heap.front().first < *best);
+		};
+		while (open(forward) || open(backward)) {
+			if (open(forward) && (!open(backward) || !(backward.heap.front() < forward.heap.front())))
+				step(forward, backward, forward_, backward_);
+			else
+				step(backward, forward, backward_, forward_);
+		}
+		if (!best)
+			return shortest_path_result<N, E>(settled);
+
+		// Both halves end at meet: src up to it along forward arcs, and dst up to it along
+		// backward ones. The arcs go in last first.
+		auto pending = std::vector<segment>{};
+		for (auto v = meet; backward.labels[v].pred != npos; v = backward.labels[v].pred) {
+			auto const& label = backward.labels[v];
+			pending.push_back({v, label.pred, backward_.arcs[label.pred_arc].middle});
+		}
+		std::reverse(pending.begin(), pending.end());
+		for (auto v = meet; forward.labels[v].pred != npos; v = forward.labels[v].pred) {
+			auto const& label = forward.labels[v];
+			pending.push_back({label.pred, v, forward_.arcs[label.pred_arc].middle});
+		}
+		return shortest_path_result<N, E>(unpack(src, std::move(pending)), *best, settled);
+	}
+
+	template<typename N, typename E>
+	requires arithmetic<E>
+	auto contraction_hierarchy<N, E>::unpack(N const& src, std::vector<segment> pending) const
+	   -> std::vector<N> {
+		// A shortcut from -> to for middle replaced the arcs from -> middle and middle -> to. Both
+		// lead to middle's neighbours, which were contracted later, so they are middle's own
+		// backward and forward arcs.
+		auto path = std::vector<N>{src};
+		while (!pending.empty()) {
+			auto const s = pending.back();
+			pending.pop_back();
+			if (s.middle == npos) {
+				path.push_back(nodes_[order_[s.to]]);
+				continue;
+			}
+			pending.push_back({s.middle, s.to, forward_.middle(s.middle, s.to)});
+			pending.push_back({s.from, s.middle, backward_.middle(s.middle, s.from)});
+		}
+		return path;
+	}
+
+	namespace detail {
+		template<typename T>
+		auto write_values(std::ostream& os, std::span<T const> values) -> void {
+			os.write(reinterpret_cast<char const*>(values.data()),
+			         static_cast<std::streamsize>(values.size_bytes()));
+		}
+
+		template<typename T>
+		auto read_values(std::istream& is, std::span<T> values) -> bool {
+			is.read(reinterpret_cast<char*>(values.data()),
+			        static_cast<std::streamsize>(values.size_bytes()));
+			return static_cast<bool>(is);
+		}
+
+		// Reads count values onto the end of values a block at a time, so that a damaged count can't
+		// allocate much more than the stream turns out to hold
+		template<typename T>
+		auto read_values(std::istream& is, std::size_t count, std::vector<T>& values) -> bool {
+			constexpr auto block = std::size_t{4096};
+			for (auto done = std::size_t{0}; done < count; done += block) {
+				auto const first = values.size();
+				values.resize(first + std::min(block, count - done));
+				if (!read_values(is, std::span<T>(values).subspan(first)))
+					return false;
+			}
+			return true;
+		}
+
+		// Sizes are written as 64 bit integers whatever the size of std::size_t
+		inline auto write_sizes(std::ostream& os, std::span<std::size_t const> sizes) -> void {
+			for (auto const size : sizes) {
+				auto const wide = static_cast<std::uint64_t>(size);
+				write_values(os, std::span<std::uint64_t const>(&wide, 1));
+			}
+		}
+
+		inline auto read_sizes(std::istream& is, std::span<std::size_t> sizes) -> bool {
+			for (auto& size : sizes) {
+				auto wide = std::uint64_t{0};
+				if (!read_values(is, std::span<std::uint64_t>(&wide, 1))
+				    || wide > std::numeric_limits<std::size_t>::max())
+				{
+					return false;
+				}
+				size = static_cast<std::size_t>(wide);
+			}
+			return true;
+		}
+
+		inline auto read_sizes(std::istream& is, std::size_t count, std::vector<std::size_t>& sizes)
+		   -> bool {
+			for (auto i = std::size_t{0}; i < count; ++i) {
+				auto size = std::size_t{0};
+				if (!read_sizes(is, std::span<std::size_t>(&size, 1)))
+					return false;
+				sizes.push_back(size);
+			}
+			return true;
+		}
+
+		// Each field of an arc is written on its own, so that padding never reaches the stream
+		template<typename E>
+		auto write_arcs(std::ostream& os, upward_arcs<E> const& arcs) -> void {
+			write_sizes(os, arcs.offsets);
+			for (auto const& arc : arcs.arcs) {
+				auto const ends = std::array<std::size_t, 2>{arc.node, arc.middle};
+				write_sizes(os, ends);
+				write_values(os, std::span<E const>(&arc.weight, 1));
+			}
+		}
+
+		// Reads the arcs of a hierarchy over node_count nodes, and checks that each leads to a
+		// node ranked above the one it is stored at and that each shortcut's middle is ranked
+		// below both its ends. A damaged file can then neither send a query out of bounds nor
+		// keep it going: searches only go up, and unpacking a shortcut only goes down.
+		template<typename E>
+		auto read_arcs(std::istream& is, std::size_t node_count, upward_arcs<E>& arcs) -> bool {
+			constexpr auto npos = std::numeric_limits<std::size_t>::max();
+			arcs.offsets.clear();
+			if (!read_sizes(is, node_count + 1, arcs.offsets) || arcs.offsets.front() != 0
+			    || !std::is_sorted(arcs.offsets.begin(), arcs.offsets.end()))
+			{
+				return false;
+			}
+			for (auto u = std::size_t{0}; u < node_count; ++u) {
+				for (auto e = arcs.offsets[u]; e < arcs.offsets[u + 1]; ++e) {
+					auto ends = std::array<std::size_t, 2>{};
+					auto weight = E{};
+					if (!read_sizes(is, ends) || !read_values(is, std::span<E>(&weight, 1)))
+						return false;
+					auto const [node, middle] = ends;
+					if (node <= u || node >= node_count || (middle != npos && middle >= u))
+						return false;
+					arcs.arcs.push_back({node, weight, middle});
+				}
+			}
+			return true;
+		}
+	} // namespace detail
+
+	template<typename N, typename E>
+	requires arithmetic<E>
+	auto contraction_hierarchy<N, E>::save(std::ostream& os) const -> void
+	requires std::is_trivially_copyable_v<N> && std::is_trivially_copyable_v<E>
+	{
+		detail::write_values(os, std::span<char const>(magic));
+		auto const header = std::vector<size_type>{sizeof(N), sizeof(E), nodes_.size()};
+		detail::write_sizes(os, header);
+		detail::write_values(os, std::span<N const>(nodes_));
+		detail::write_sizes(os, ranks_);
+		detail::write_arcs(os, forward_);
+		detail::write_arcs(os, backward_);
+	}
+
+	template<typename N, typename E>
+	requires arithmetic<E>
+	[[nodiscard]] auto contraction_hierarchy<N, E>::load(std::istream& is) -> contraction_hierarchy
+	requires std::is_trivially_copyable_v<N> && std::is_trivially_copyable_v<E>
+	{
+		auto fail = [] {
+			return std::runtime_error("Cannot call gdwg::contraction_hierarchy<N, E>::load on a "
+			                          "stream that doesn't hold a saved hierarchy of this type");
+		};
+
+		char found[sizeof(magic)] = {};
+		auto header = std::vector<size_type>(3);
+		if (!detail::read_values(is, std::span<char>(found)) || !std::equal(found, found + 8, magic)
+		    || !detail::read_sizes(is, header) || header[0] != sizeof(N) || header[1] != sizeof(E)
+		    || header[2] > std::numeric_limits<std::uint32_t>::max())
+		{
+			throw fail();
+		}
+
+		auto ch = contraction_hierarchy{};
+		auto const node_count = header[2];
+		auto ranks = std::vector<size_type>{};
+		if (!detail::read_values(is, node_count, ch.nodes_)
+		    || !std::is_sorted(ch.nodes_.begin(), ch.nodes_.end())
+		    || !detail::read_sizes(is, node_count, ranks))
+		{
+			throw fail();
+		}
+		// The ranks have to number the nodes from 0 without gaps
+		auto numbered = std::vector<bool>(node_count, false);
+		for (auto const rank : ranks) {
+			if (rank >= node_count || numbered[rank])
+				throw fail();
+			numbered[rank] = true;
+		}
+		ch.set_ranks(std::move(ranks));
+		if (!detail::read_arcs(is, node_count, ch.forward_)
+		    || !detail::read_arcs(is, node_count, ch.backward_))
+		{
+			throw fail();
+		}
+		return ch;
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_CONTRACTION_HIERARCHY_HPP
@@ -0,0 +1,411 @@
+#ifndef GDWG_CSR_GRAPH_HPP
+#define GDWG_CSR_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+	namespace detail {
+		template<typename T>
+		concept hashable = requires(T const& value) {
+			{ std::hash<T>{}(value) } -> std::convertible_to<std::size_t>;
+		};
+
+		// Calls f(src, dst, edge) for every edge of g in iteration order, where src and dst are the
+		// positions of the edge's nodes in nodes, which has to be g.nodes(). Sources come in order,
+		// so src is found by walking forward. dsts are looked up once per node and then remembered:
+		// by address in the pointer based graph, which stores each node once, and by value in flat
+		// graphs, whose edge lists hold copies. Dense integral nodes skip the lookup altogether.
+		template<typename N, typename E, typename F>
+		auto for_each_indexed_edge(graph<N, E> const& g, std::span<N const> nodes, F&& f) -> void {
+			auto position = [&](N const& value) {
+				return static_cast<std::size_t>(std::lower_bound(nodes.begin(), nodes.end(), value)
+				                                - nodes.begin());
+			};
+			auto walk = [&](auto&& dst_of) {
+				auto src = std::size_t{0};
+				for (auto const& edge : g) {
+					while (nodes[src] < edge.from)
+						++src;
+					f(src, dst_of(edge.to), edge);
+				}
+			};
+
+			// Integral nodes that fill most of their range index a table directly
+			if constexpr (std::integral<N>) {
+				using unsigned_type = std::make_unsigned_t<N>;
+				auto offset = [&](N const& value) {
+					return static_cast<std::size_t>(static_cast<unsigned_type>(value)
+					                                - static_cast<unsigned_type>(nodes.front()));
+				};
+				if (!nodes.empty() && offset(nodes.back()) < 4 * nodes.size()) {
+					auto positions = std::vector<std::size_t>(offset(nodes.back()) + 1);
+					for (auto i = std::size_t{0}; i < nodes.size(); ++i)
+						positions[offset(nodes[i])] = i;
+					walk([&](N const& to) { return positions[offset(to)]; });
+					return;
+				}
+			}
+
+			using key_type = std::conditional_t<flat_storable<N, E>, N, N const*>;
+			if constexpr (hashable<key_type>) {
+				auto positions = std::unordered_map<key_type, std::size_t>{};
+				walk([&](N const& to) {
+					auto key = key_type{};
+					if constexpr (flat_storable<N, E>)
+						key = to;
+					else
+						key = &to;
+					auto [it, inserted] = positions.try_emplace(key, 0);
+					if (inserted)
+						it->second = position(to);
+					return it->second;
+				});
+			}
+			else {
+				walk(position);
+			}
+		}
+
+		// The edges of g as dst positions in nodes, grouped by src: offsets[i] .. offsets[i + 1]
+		// delimits the edges out of the i-th node, as in csr_graph. Weights are left out.
+		template<typename N, typename E>
+		auto adjacency(graph<N, E> const& g, std::span<N const> nodes)
+		   -> std::pair<std::vector<std::size_t>, std::vector<std::size_t>> {
+			auto offsets = std::vector<std::size_t>(nodes.size() + 1, 0);
+			auto targets = std::vector<std::size_t>{};
+			for_each_indexed_edge(g, nodes, [&](std::size_t src, std::size_t dst, auto const&) {
+				++offsets[src + 1];
+				targets.push_back(dst);
+			});
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+			return {std::move(offsets), std::move(targets)};
+		}
+
+		// Threads to share work items out over: threads, or one per hardware thread if that is 0,
+		// but no more than there are items and at least one
+		inline auto worker_count(std::size_t threads, std::size_t work) -> std::size_t {
+			if (threads == 0)
+				threads = std::max(1U, std::thread::hardware_concurrency());
+			return std::max(std::size_t{1}, std::min(threads, work));
+		}
+
+		// Splits the nodes of an adjacency list in compressed-sparse-row form into parts runs of
+		// about the same number of edges each, counting every node as one more. Run t is
+		// blocks[t] .. blocks[t + 1].
+		inline auto balanced_blocks(std::span<std::size_t const> offsets, std::size_t parts)
+		   -> std::vector<std::size_t> {
+			auto const n = offsets.size() - 1;
+			auto blocks = std::vector<std::size_t>(parts + 1, n);
+			blocks[0] = 0;
+			auto const edges = offsets[n] + n;
+			for (auto t = std::size_t{1}; t < parts; ++t) {
+				auto const goal = edges * t / parts;
+				auto v = blocks[t - 1];
+				while (v < n && offsets[v] + v < goal)
+					++v;
+				blocks[t] = v;
+			}
+			return blocks;
+		}
+	} // namespace detail
+
+	// Read-only compressed-sparse-row snapshot of a gdwg::graph.
+	// Nodes are packed into one sorted array and every edge is stored as a target index and a
+	// weight, grouped by source node. offsets_[i] .. offsets_[i + 1] delimits the edges of the i-th
+	// node, which are kept in the same (dst, weight) order as in the graph it was built from.
+	template<typename N, typename E>
+	class csr_graph {
+	public:
+		using value_type = typename graph<N, E>::value_type;
+		using size_type = std::size_t;
+
+		static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+	private:
+		class iterator {
+		public:
+			using value_type = csr_graph<N, E>::value_type;
+			using reference = graph_edge_ref<N, E>;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				return reference{g_->nodes_[src_], g_->nodes_[g_->targets_[edge_]], g_->weights_[edge_]};
+			}
+
+			auto operator++() -> iterator& {
+				++edge_;
+				while (src_ < g_->nodes_.size() && g_->offsets_[src_ + 1] <= edge_)
+					++src_;
+				return *this;
+			}
+
+			auto operator++(int) -> iterator {
+				iterator tmp = *this;
+				++(*this);
+				return tmp;
+			}
+
+			auto operator--() -> iterator& {
+				--edge_;
+				while (g_->offsets_[src_] > edge_)
+					--src_;
+				return *this;
+			}
+
+			auto operator--(int) -> iterator {
+				iterator tmp = *this;
+				--(*this);
+				return tmp;
+			}
+
+			auto operator==(iterator const& other) const noexcept -> bool {
+				return edge_ == other.edge_;
+			}
+
+		private:
+			csr_graph const* g_ = nullptr;
+			size_type src_ = 0;
+			size_type edge_ = 0;
+
+			friend class csr_graph;
+
+			iterator(csr_graph const* g, size_type src, size_type edge)
+			: g_{g}
+			, src_{src}
+			, edge_{edge} {}
+		};
+
+	public:
+		using iter = iterator;
+		using reverse_iterator = std::reverse_iterator<iter>;
+
+		csr_graph() = default;
+		explicit csr_graph(graph<N, E> const& g);
+
+		[[nodiscard]] auto operator==(csr_graph const& other) const noexcept -> bool = default;
+
+		[[nodiscard]] auto is_node(N const& value) const noexcept -> bool;
+		[[nodiscard]] auto empty() const noexcept -> bool;
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool;
+		[[nodiscard]] auto nodes() const noexcept -> std::vector<N>;
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E>;
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const noexcept -> iterator;
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N>;
+
+		// Index based access to the packed arrays, for algorithms that work on dense node indices
+		[[nodiscard]] auto node_count() const noexcept -> size_type {
+			return nodes_.size();
+		}
+		[[nodiscard]] auto edge_count() const noexcept -> size_type {
+			return targets_.size();
+		}
+		[[nodiscard]] auto index_of(N const& value) const noexcept -> size_type;
+		[[nodiscard]] auto node(size_type index) const noexcept -> N const& {
+			return nodes_[index];
+		}
+		[[nodiscard]] auto offsets() const noexcept -> std::span<size_type const> {
+			return offsets_;
+		}
+		[[nodiscard]] auto targets() const noexcept -> std::span<size_type const> {
+			return targets_;
+		}
+		[[nodiscard]] auto edge_weights() const noexcept -> std::span<E const> {
+			return weights_;
+		}
+		// The same nodes with every edge reversed, so that the edges of node i are the edges into it
+		// (the compressed-sparse-column form of this graph)
+		[[nodiscard]] auto transposed() const -> csr_graph;
+
+		[[nodiscard]] auto begin() const -> iter {
+			auto it = iter{this, 0, 0};
+			while (it.src_ < nodes_.size() && offsets_[it.src_ + 1] == 0)
+				++it.src_;
+			return it;
+		}
+
+		[[nodiscard]] auto end() const -> iter {
+			return iter{this, nodes_.size(), targets_.size()};
+		}
+
+		friend auto operator<<(std::ostream& os, csr_graph const& g) noexcept -> std::ostream& {
+			for (auto i = size_type{0}; i < g.nodes_.size(); ++i) {
+				os << g.nodes_[i] << " (\n";
+				for (auto e = g.offsets_[i]; e < g.offsets_[i + 1]; ++e) {
+					os << "  " << g.nodes_[g.targets_[e]] << " | " << g.weights_[e] << "\n";
+				}
+				os << ")\n";
+			}
+			return os;
+		}
+
+	private:
+		std::vector<N> nodes_;
+		std::vector<size_type> offsets_ = std::vector<size_type>(1, 0);
+		std::vector<size_type> targets_;
+		std::vector<E> weights_;
+
+		// Range of edge positions from src to dst, empty if they aren't connected
+		[[nodiscard]] auto edge_range(size_type src, size_type dst) const noexcept
+		   -> std::pair<size_type, size_type>;
+	};
+
+	template<typename N, typename E>
+	csr_graph<N, E>::csr_graph(graph<N, E> const& g)
+	: nodes_(g.nodes()) {
+		offsets_.assign(nodes_.size() + 1, 0);
+		auto const nodes = std::span<N const>(nodes_);
+		detail::for_each_indexed_edge(g, nodes, [&](std::size_t src, std::size_t dst, auto& edge) {
+			++offsets_[src + 1];
+			targets_.push_back(dst);
+			weights_.push_back(edge.weight);
+		});
+		std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto csr_graph<N, E>::transposed() const -> csr_graph {
+		auto t = csr_graph{};
+		t.nodes_ = nodes_;
+		t.offsets_.assign(nodes_.size() + 1, 0);
+		for (auto dst : targets_)
+			++t.offsets_[dst + 1];
+		std::partial_sum(t.offsets_.begin(), t.offsets_.end(), t.offsets_.begin());
+
+		// Counting sort by dst. Sources are visited in increasing order and each source's weights
+		// are already sorted, so every reversed edge list comes out in (dst, weight) order.
+		auto next = std::vector<size_type>(t.offsets_.begin(), t.offsets_.end() - 1);
+		auto order = std::vector<size_type>(targets_.size());
+		t.targets_.resize(targets_.size());
+		for (auto src = size_type{0}; src < nodes_.size(); ++src) {
+			for (auto e = offsets_[src]; e < offsets_[src + 1]; ++e) {
+				auto const pos = next[targets_[e]]++;
+				t.targets_[pos] = src;
+				order[pos] = e;
+			}
+		}
+		t.weights_.reserve(weights_.size());
+		for (auto e : order)
+			t.weights_.push_back(weights_[e]);
+		return t;
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto csr_graph<N, E>::index_of(N const& value) const noexcept -> size_type {
+		auto it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+		return (it != nodes_.end() && !(value < *it)) ? static_cast<size_type>(it - nodes_.begin())
+		                                              : npos;
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto csr_graph<N, E>::edge_range(size_type src, size_type dst) const noexcept
+	   -> std::pair<size_type, size_type> {
+		auto first = targets_.begin() + static_cast<std::ptrdiff_t>(offsets_[src]);
+		auto last = targets_.begin() + static_cast<std::ptrdiff_t>(offsets_[src + 1]);
+		auto [lo, hi] = std::equal_range(first, last, dst);
+		return {static_cast<size_type>(lo - targets_.begin()),
+		        static_cast<size_type>(hi - targets_.begin())};
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto csr_graph<N, E>::is_node(N const& value) const noexcept -> bool {
+		return index_of(value) != npos;
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto csr_graph<N, E>::empty() const noexcept -> bool {
+		return nodes_.empty();
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto csr_graph<N, E>::is_connected(N const& src, N const& dst) const -> bool {
+		auto src_index = index_of(src);
+		auto dst_index = index_of(dst);
+		if (src_index == npos || dst_index == npos) {
+			throw std::runtime_error("Cannot call gdwg::csr_graph<N, E>::is_connected if src or dst "
+			                         "node don't exist in the graph");
+		}
+
+		auto [first, last] = edge_range(src_index, dst_index);
+		return first != last;
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto csr_graph<N, E>::nodes() const noexcept -> std::vector<N> {
+		return nodes_;
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto csr_graph<N, E>::weights(N const& src, N const& dst) const
+	   -> std::vector<E> {
+		auto src_index = index_of(src);
+		auto dst_index = index_of(dst);
+		if (src_index == npos || dst_index == npos) {
+			throw std::runtime_error("Cannot call gdwg::csr_graph<N, E>::weights if src or dst node "
+			                         "don't exist in the graph");
+		}
+
+		auto [first, last] = edge_range(src_index, dst_index);
+		return std::vector<E>(weights_.begin() + static_cast<std::ptrdiff_t>(first),
+		                      weights_.begin() + static_cast<std::ptrdiff_t>(last));
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto csr_graph<N, E>::find(N const& src, N const& dst, E const& weight) const noexcept
+	   -> iterator {
+		auto src_index = index_of(src);
+		auto dst_index = index_of(dst);
+		if (src_index == npos || dst_index == npos)
+			return end();
+
+		auto [first, last] = edge_range(src_index, dst_index);
+		auto w_first = weights_.begin() + static_cast<std::ptrdiff_t>(first);
+		auto w_last = weights_.begin() + static_cast<std::ptrdiff_t>(last);
+		auto found = std::lower_bound(w_first, w_last, weight);
+		if (found == w_last || weight < *found)
+			return end();
+
+		return iter{this, src_index, static_cast<size_type>(found - weights_.begin())};
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto csr_graph<N, E>::connections(N const& src) const -> std::vector<N> {
+		auto src_index = index_of(src);
+		if (src_index == npos)
+			throw std::runtime_error("Cannot call gdwg::csr_graph<N, E>::connections if src doesn't "
+			                         "exist in the graph");
+
+		auto v = std::vector<N>{};
+		for (auto e = offsets_[src_index]; e < offsets_[src_index + 1]; ++e) {
+			// targets are sorted, so parallel edges to the same node are adjacent
+			if (e == offsets_[src_index] || targets_[e] != targets_[e - 1]) {
+				v.push_back(nodes_[targets_[e]]);
+			}
+		}
+
+		return v;
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_CSR_GRAPH_HPP
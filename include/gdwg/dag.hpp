@@ -0,0 +1,285 @@
+#ifndef GDWG_DAG_HPP
+#define GDWG_DAG_HPP
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <map>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+	namespace detail {
+		// Kahn's algorithm over an adjacency list in compressed-sparse-row form. Nodes that are
+		// ready together come out in index order. The result is short of some nodes if the graph
+		// has a cycle.
+		inline auto topological_indices(std::span<std::size_t const> offsets,
+		                                std::span<std::size_t const> targets)
+		   -> std::vector<std::size_t> {
+			auto const n = offsets.size() - 1;
+			auto in_degree = std::vector<std::size_t>(n, 0);
+			for (auto const v : targets)
+				++in_degree[v];
+
+			// Nodes are appended once all their in-edges are accounted for
+			auto order = std::vector<std::size_t>{};
+			order.reserve(n);
+			for (auto u = std::size_t{0}; u < n; ++u) {
+				if (in_degree[u] == 0)
+					order.push_back(u);
+			}
+			for (auto head = std::size_t{0}; head < order.size(); ++head) {
+				auto const u = order[head];
+				for (auto e = offsets[u]; e < offsets[u + 1]; ++e) {
+					if (--in_degree[targets[e]] == 0)
+						order.push_back(targets[e]);
+				}
+			}
+			return order;
+		}
+
+		template<typename N>
+		auto topological_nodes(std::span<N const> nodes,
+		                       std::span<std::size_t const> offsets,
+		                       std::span<std::size_t const> targets,
+		                       char const* message) -> std::vector<N> {
+			auto const order = topological_indices(offsets, targets);
+			if (order.size() != nodes.size())
+				throw std::runtime_error(message);
+
+			auto result = std::vector<N>{};
+			result.reserve(order.size());
+			for (auto const i : order)
+				result.push_back(nodes[i]);
+			return result;
+		}
+	} // namespace detail
+
+	// The nodes of g ordered so that every edge goes from an earlier node to a later one. Linear in
+	// nodes + edges.
+	template<typename N, typename E>
+	auto topological_order(graph<N, E> const& g) -> std::vector<N> {
+		auto const nodes = g.nodes();
+		auto const [offsets, targets] = detail::adjacency(g, std::span<N const>(nodes));
+		return detail::topological_nodes<N>(nodes,
+		                                    offsets,
+		                                    targets,
+		                                    "Cannot call gdwg::topological_order if the graph has "
+		                                    "a cycle");
+	}
+
+	template<typename N, typename E>
+	auto topological_order(csr_graph<N, E> const& g) -> std::vector<N> {
+		auto const nodes = g.nodes();
+		return detail::topological_nodes<N>(nodes,
+		                                    g.offsets(),
+		                                    g.targets(),
+		                                    "Cannot call gdwg::topological_order if the graph has "
+		                                    "a cycle");
+	}
+
+	// A graph that stays acyclic: insert_edge refuses any edge that would close a cycle. Alongside
+	// the graph it keeps a topological order, which Pearce and Kelly's algorithm repairs on each
+	// insert. An edge that already agrees with the order costs nothing extra; otherwise only the
+	// nodes ranked between its ends are searched, from dst forwards and from src backwards, and
+	// those found are swapped around among the ranks they already held.
+	// Everything that doesn't modify the graph goes through as_graph().
+	template<typename N, typename E>
+	class dag {
+	public:
+		using value_type = typename graph<N, E>::value_type;
+		using size_type = std::size_t;
+
+		dag() = default;
+		dag(std::initializer_list<N> il);
+		explicit dag(graph<N, E> g);
+
+		[[nodiscard]] auto as_graph() const noexcept -> graph<N, E> const& {
+			return g_;
+		}
+		// The nodes ordered so that every edge goes from an earlier node to a later one
+		[[nodiscard]] auto topological_order() const -> std::vector<N>;
+
+		auto insert_node(N const& value) -> bool;
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool;
+		auto replace_node(N const& old_data, N const& new_data) -> bool;
+		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool;
+		auto erase_node(N const& value) noexcept -> bool;
+		auto clear() noexcept -> void;
+
+		[[nodiscard]] auto operator==(dag const& other) const noexcept -> bool {
+			return g_ == other.g_;
+		}
+
+	private:
+		using rank_map = std::conditional_t<detail::hashable<N>,
+		                                    std::unordered_map<N, size_type>,
+		                                    std::map<N, size_type>>;
+		using node_set =
+		   std::conditional_t<detail::hashable<N>, std::unordered_set<N>, std::set<N>>;
+
+		graph<N, E> g_;
+		// Position of every node in the topological order. Ranks are unique but can have gaps.
+		rank_map rank_;
+		size_type next_rank_ = 0;
+
+		// Reranks the nodes between dst and src so that src comes before dst, or returns false if
+		// dst reaches src
+		auto reorder(N const& src, N const& dst) -> bool;
+	};
+
+	template<typename N, typename E>
+	dag<N, E>::dag(std::initializer_list<N> il)
+	: g_(il) {
+		for (auto const& value : il)
+			rank_.try_emplace(value, next_rank_++);
+	}
+
+	template<typename N, typename E>
+	dag<N, E>::dag(graph<N, E> g)
+	: g_(std::move(g)) {
+		auto const nodes = g_.nodes();
+		auto const [offsets, targets] = detail::adjacency(g_, std::span<N const>(nodes));
+		auto const order = detail::topological_indices(offsets, targets);
+		if (order.size() != nodes.size()) {
+			throw std::runtime_error("Cannot construct gdwg::dag<N, E> from a graph with a cycle");
+		}
+		for (auto const i : order)
+			rank_.emplace(nodes[i], next_rank_++);
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto dag<N, E>::topological_order() const -> std::vector<N> {
+		auto ranked = std::vector<std::pair<size_type, N const*>>{};
+		ranked.reserve(rank_.size());
+		for (auto const& [value, rank] : rank_)
+			ranked.emplace_back(rank, &value);
+		std::sort(ranked.begin(), ranked.end(), [](auto const& a, auto const& b) {
+			return a.first < b.first;
+		});
+
+		auto result = std::vector<N>{};
+		result.reserve(ranked.size());
+		for (auto const& [rank, value] : ranked)
+			result.push_back(*value);
+		return result;
+	}
+
+	template<typename N, typename E>
+	auto dag<N, E>::insert_node(N const& value) -> bool {
+		if (!g_.insert_node(value))
+			return false;
+		rank_.emplace(value, next_rank_++);
+		return true;
+	}
+
+	template<typename N, typename E>
+	auto dag<N, E>::insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+		if (!g_.is_node(src) || !g_.is_node(dst)) {
+			throw std::runtime_error("Cannot call gdwg::dag<N, E>::insert_edge when either src or "
+			                         "dst node does not exist");
+		}
+		if (!(rank_.find(src)->second < rank_.find(dst)->second) && !reorder(src, dst)) {
+			throw std::runtime_error("Cannot call gdwg::dag<N, E>::insert_edge if the edge would "
+			                         "create a cycle");
+		}
+		return g_.insert_edge(src, dst, weight);
+	}
+
+	template<typename N, typename E>
+	auto dag<N, E>::replace_node(N const& old_data, N const& new_data) -> bool {
+		if (!g_.replace_node(old_data, new_data))
+			return false;
+		auto const rank = rank_.find(old_data)->second;
+		rank_.erase(old_data);
+		rank_.emplace(new_data, rank);
+		return true;
+	}
+
+	template<typename N, typename E>
+	auto dag<N, E>::erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+		return g_.erase_edge(src, dst, weight);
+	}
+
+	template<typename N, typename E>
+	auto dag<N, E>::erase_node(N const& value) noexcept -> bool {
+		if (!g_.erase_node(value))
+			return false;
+		rank_.erase(value);
+		return true;
+	}
+
+	template<typename N, typename E>
+	auto dag<N, E>::clear() noexcept -> void {
+		g_.clear();
+		rank_.clear();
+		next_rank_ = 0;
+	}
+
+	template<typename N, typename E>
+	auto dag<N, E>::reorder(N const& src, N const& dst) -> bool {
+		if (src == dst)
+			return false;
+		auto const lower = rank_.find(dst)->second;
+		auto const upper = rank_.find(src)->second;
+
+		// Everything dst reaches that is ranked no later than src. Finding src itself means the
+		// edge closes a cycle.
+		auto forward = std::vector<N>{dst};
+		auto seen = node_set{dst};
+		for (auto head = size_type{0}; head < forward.size(); ++head) {
+			for (auto const& edge : g_.out_edges(forward[head])) {
+				auto const rank = rank_.find(edge.to)->second;
+				if (rank == upper)
+					return false;
+				if (rank < upper && seen.insert(edge.to).second)
+					forward.push_back(edge.to);
+			}
+		}
+
+		// Everything that reaches src and is ranked no earlier than dst
+		auto backward = std::vector<N>{src};
+		seen.insert(src);
+		for (auto head = size_type{0}; head < backward.size(); ++head) {
+			for (auto const& from : g_.in_connections(backward[head])) {
+				if (rank_.find(from)->second > lower && seen.insert(from).second)
+					backward.push_back(from);
+			}
+		}
+
+		// Both sets keep their internal order and backward moves in front of forward, reusing the
+		// ranks they held between them
+		auto by_rank = [this](N const& a, N const& b) {
+			return rank_.find(a)->second < rank_.find(b)->second;
+		};
+		std::sort(forward.begin(), forward.end(), by_rank);
+		std::sort(backward.begin(), backward.end(), by_rank);
+		auto ranks = std::vector<size_type>{};
+		ranks.reserve(forward.size() + backward.size());
+		for (auto const& value : backward)
+			ranks.push_back(rank_.find(value)->second);
+		for (auto const& value : forward)
+			ranks.push_back(rank_.find(value)->second);
+		std::sort(ranks.begin(), ranks.end());
+
+		auto next = ranks.begin();
+		for (auto const& value : backward)
+			rank_.find(value)->second = *next++;
+		for (auto const& value : forward)
+			rank_.find(value)->second = *next++;
+		return true;
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_DAG_HPP
@@ -0,0 +1,404 @@
+#ifndef GDWG_DELTA_STEPPING_HPP
+#define GDWG_DELTA_STEPPING_HPP
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+	template<typename E>
+	struct delta_stepping_options {
+		// Width of a bucket. Edges no heavier than delta are light and relaxed over and over
+		// while a bucket settles; heavier ones are relaxed once per node. 0 picks the heaviest
+		// weight over the average out-degree.
+		E delta = E{};
+		// 0 means std::thread::hardware_concurrency()
+		std::size_t threads = 0;
+	};
+
+	namespace detail {
+		// Delta-stepping (Meyer and Sanders). Nodes wait in buckets of width delta by tentative
+		// distance, and buckets are settled in order: light edges out of the current bucket are
+		// relaxed until it stays empty, which may take several passes as nodes fall back into it,
+		// and then the heavy edges out of every node it held, which can only reach later buckets.
+		// Each thread keeps its own buckets and pushes the nodes it reaches into them. The
+		// current bucket is shared with the other threads, which take half of it when they run
+		// out of their own. The threads stay up for the whole search and meet at a barrier after
+		// every bucket, where one of them picks the next.
+		// Every node waiting lies within the heaviest weight of the current bucket, so buckets are
+		// kept in a ring of slots indexed by bucket modulo its size, as Meyer and Sanders do. The
+		// ring has room for that span, but no more slots than nodes: when delta is tiny, entries
+		// for a later turn of the ring wait in their slot until the search gets round to them.
+		template<typename E>
+		class delta_stepping_search {
+		public:
+			using size_type = std::size_t;
+			static constexpr size_type npos = std::numeric_limits<size_type>::max();
+			static constexpr E unreached = std::numeric_limits<E>::max();
+
+			delta_stepping_search(std::span<size_type const> offsets,
+			                      std::span<size_type const> targets,
+			                      std::span<E const> weights,
+			                      E delta)
+			: offsets_{offsets}
+			, targets_{targets}
+			, weights_{weights}
+			, delta_{delta} {
+				auto const heaviest =
+				   weights.empty() ? E{} : *std::max_element(weights.begin(), weights.end());
+				auto const span = static_cast<double>(heaviest) / static_cast<double>(delta);
+				auto const n = offsets.size() - 1;
+				slots_ = (span < static_cast<double>(n) ? static_cast<size_type>(span) : n) + 2;
+			}
+
+			auto run(size_type src, size_type threads) -> dijkstra_state<E> {
+				auto const n = offsets_.size() - 1;
+				dist_.assign(n, unreached);
+				dist_[src] = E{};
+				settled_in_.assign(n, npos);
+				workers_ = std::vector<worker>(threads);
+				for (auto& w : workers_)
+					w.buckets.resize(slots_);
+				workers_[0].current.push_back({src, E{}});
+				bucket_ = 0;
+				pending_.store(1, std::memory_order_relaxed);
+				done_ = false;
+
+				auto bucket_done = [this]() noexcept { next_bucket(); };
+				auto sync = std::barrier(static_cast<std::ptrdiff_t>(threads), bucket_done);
+				auto work = [&](size_type t) {
+					do {
+						// Nothing is left in flight once pending_ reaches 0, so every thread
+						// moves on to heavy edges as soon as it sees that
+						relax_light(t);
+						relax_heavy(t);
+						sync.arrive_and_wait();
+					} while (!done_);
+				};
+
+				{
+					auto helpers = std::vector<std::jthread>{};
+					helpers.reserve(threads - 1);
+					for (auto t = size_type{1}; t < threads; ++t)
+						helpers.emplace_back(work, t);
+					work(0);
+				}
+				workers_.clear();
+				return tree(src, threads);
+			}
+
+		private:
+			// A node and the distance it was pushed with, which is stale once its distance drops
+			struct entry {
+				size_type node;
+				E dist;
+			};
+
+			struct alignas(64) worker {
+				// The bucket being settled, which other threads steal from
+				std::mutex lock;
+				std::vector<entry> current;
+				// The ring of later buckets, only touched by this worker's thread
+				std::vector<std::vector<entry>> buckets;
+				// Nodes this thread took from the current bucket, for their heavy edges
+				std::vector<size_type> settled;
+			};
+
+			// Most entries a thread takes from its own current bucket at a time
+			static constexpr size_type chunk = 64;
+
+			std::span<size_type const> offsets_;
+			std::span<size_type const> targets_;
+			std::span<E const> weights_;
+			E delta_;
+			// Size of each worker's ring of buckets
+			size_type slots_ = 0;
+
+			std::vector<E> dist_;
+			// The bucket each node's heavy edges were last queued for
+			std::vector<size_type> settled_in_;
+			std::vector<worker> workers_;
+			size_type bucket_ = 0;
+			bool done_ = false;
+			// Entries of the current bucket that have been pushed but not finished
+			std::atomic<size_type> pending_ = 0;
+
+			[[nodiscard]] auto bucket_of(E dist) const noexcept -> size_type {
+				return static_cast<size_type>(dist / delta_);
+			}
+
+			auto push(worker& w, size_type bucket, entry e) -> void {
+				w.buckets[bucket % slots_].push_back(e);
+			}
+
+			// Lowers v's distance to candidate if that is lower, from any thread
+			auto relax(size_type v, E candidate) noexcept -> bool {
+				auto dist = std::atomic_ref<E>(dist_[v]);
+				auto old = dist.load(std::memory_order_relaxed);
+				while (candidate < old) {
+					if (dist.compare_exchange_weak(old, candidate, std::memory_order_relaxed))
+						return true;
+				}
+				return false;
+			}
+
+			[[nodiscard]] auto distance(size_type v) const noexcept -> E {
+				return std::atomic_ref<E const>(dist_[v]).load(std::memory_order_relaxed);
+			}
+
+			// Moves half of w's current bucket, rounded up and no more than limit, into batch
+			static auto take(worker& w, std::vector<entry>& batch, size_type limit = npos) -> void {
+				auto const guard = std::lock_guard(w.lock);
+				auto const count = std::min(limit, (w.current.size() + 1) / 2);
+				auto const first = w.current.end() - static_cast<std::ptrdiff_t>(count);
+				batch.insert(batch.end(), first, w.current.end());
+				w.current.erase(first, w.current.end());
+			}
+
+			auto steal(size_type t, std::vector<entry>& batch) -> void {
+				for (auto i = size_type{1}; i < workers_.size() && batch.empty(); ++i)
+					take(workers_[(t + i) % workers_.size()], batch);
+			}
+
+			auto relax_light(size_type t) -> void {
+				auto& me = workers_[t];
+				auto batch = std::vector<entry>{};
+				auto same = std::vector<entry>{};
+				while (true) {
+					take(me, batch, chunk);
+					if (batch.empty())
+						steal(t, batch);
+					if (batch.empty()) {
+						if (pending_.load(std::memory_order_acquire) == 0)
+							return;
+						std::this_thread::yield();
+						continue;
+					}
+
+					for (auto const [u, d] : batch) {
+						if (distance(u) < d)
+							continue;
+						auto mark = std::atomic_ref<size_type>(settled_in_[u]);
+						if (mark.exchange(bucket_, std::memory_order_relaxed) != bucket_)
+							me.settled.push_back(u);
+						for (auto e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+							if (delta_ < weights_[e])
+								continue;
+							auto const v = targets_[e];
+							auto const candidate = static_cast<E>(d + weights_[e]);
+							if (!relax(v, candidate))
+								continue;
+							if (auto const b = bucket_of(candidate); b == bucket_)
+								same.push_back({v, candidate});
+							else
+								push(me, b, {v, candidate});
+						}
+					}
+
+					// New work is counted before the batch is let go, so pending_ can't touch 0
+					// while any is left
+					if (!same.empty()) {
+						pending_.fetch_add(same.size(), std::memory_order_relaxed);
+						auto const guard = std::lock_guard(me.lock);
+						me.current.insert(me.current.end(), same.begin(), same.end());
+					}
+					pending_.fetch_sub(batch.size(), std::memory_order_acq_rel);
+					same.clear();
+					batch.clear();
+				}
+			}
+
+			// Distances in the current bucket are final now, and heavy edges reach past it
+			auto relax_heavy(size_type t) -> void {
+				auto& me = workers_[t];
+				for (auto const u : me.settled) {
+					auto const d = distance(u);
+					for (auto e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+						if (!(delta_ < weights_[e]))
+							continue;
+						auto const v = targets_[e];
+						auto const candidate = static_cast<E>(d + weights_[e]);
+						if (relax(v, candidate))
+							push(me, bucket_of(candidate), {v, candidate});
+					}
+				}
+				me.settled.clear();
+			}
+
+			// Runs on one thread while the others wait at the barrier. Looks one turn round the
+			// ring for the next bucket, and failing that jumps to the lowest one left.
+			auto next_bucket() noexcept -> void {
+				for (auto b = bucket_ + 1; b < bucket_ + slots_; ++b) {
+					if (open_bucket(b))
+						return;
+				}
+
+				auto lowest = npos;
+				for (auto& w : workers_) {
+					for (auto& slot : w.buckets) {
+						std::erase_if(slot, [&](entry const& e) { return distance(e.node) < e.dist; });
+						for (auto const& e : slot)
+							lowest = std::min(lowest, bucket_of(e.dist));
+					}
+				}
+				done_ = lowest == npos;
+				if (!done_)
+					open_bucket(lowest);
+			}
+
+			// Makes b the current bucket if any worker holds entries for it. Entries for later
+			// turns of the ring stay in the slot.
+			auto open_bucket(size_type b) noexcept -> bool {
+				auto pending = size_type{0};
+				for (auto& w : workers_) {
+					auto& slot = w.buckets[b % slots_];
+					auto const later = std::partition(slot.begin(), slot.end(), [&](entry const& e) {
+						return bucket_of(e.dist) == b;
+					});
+					w.current.assign(slot.begin(), later);
+					slot.erase(slot.begin(), later);
+					pending += w.current.size();
+				}
+				if (pending == 0)
+					return false;
+				bucket_ = b;
+				pending_.store(pending, std::memory_order_relaxed);
+				return true;
+			}
+
+			// Predecessors aren't kept during the search, as threads lowering a distance at once
+			// could leave it with another's predecessor. Any edge that a distance is the sum over
+			// leads on from a predecessor, so long as it goes further from src; zero weight edges
+			// between nodes at the same distance are followed out from the rest afterwards.
+			auto tree(size_type src, size_type threads) -> dijkstra_state<E> {
+				auto const n = dist_.size();
+				auto predecessors = std::vector<size_type>(n, npos);
+				auto next = std::atomic<size_type>{0};
+				auto work = [&] {
+					constexpr auto nodes_per_chunk = size_type{1024};
+					for (auto first = next.fetch_add(nodes_per_chunk); first < n;
+					     first = next.fetch_add(nodes_per_chunk))
+					{
+						for (auto u = first; u < std::min(n, first + nodes_per_chunk); ++u) {
+							if (dist_[u] == unreached)
+								continue;
+							for (auto e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+								auto const v = targets_[e];
+								auto const tight = static_cast<E>(dist_[u] + weights_[e]) == dist_[v];
+								if (dist_[u] < dist_[v] && tight) {
+									auto pred = std::atomic_ref<size_type>(predecessors[v]);
+									auto none = npos;
+									pred.compare_exchange_strong(none, u, std::memory_order_relaxed);
+								}
+							}
+						}
+					}
+				};
+				{
+					auto helpers = std::vector<std::jthread>{};
+					helpers.reserve(threads - 1);
+					for (auto t = size_type{1}; t < threads; ++t)
+						helpers.emplace_back(work);
+					work();
+				}
+
+				auto reached = std::vector<bool>(n, false);
+				auto unresolved = false;
+				for (auto v = size_type{0}; v < n; ++v) {
+					reached[v] = dist_[v] != unreached;
+					unresolved = unresolved || (reached[v] && v != src && predecessors[v] == npos);
+				}
+				if (unresolved) {
+					auto resolved = std::vector<size_type>{};
+					for (auto v = size_type{0}; v < n; ++v) {
+						if (v == src || predecessors[v] != npos)
+							resolved.push_back(v);
+					}
+					while (!resolved.empty()) {
+						auto const u = resolved.back();
+						resolved.pop_back();
+						for (auto e = offsets_[u]; e < offsets_[u + 1]; ++e) {
+							auto const v = targets_[e];
+							if (v != src && predecessors[v] == npos && weights_[e] == E{}
+							    && dist_[u] == dist_[v])
+							{
+								predecessors[v] = u;
+								resolved.push_back(v);
+							}
+						}
+					}
+				}
+				return {std::move(dist_), std::move(predecessors), std::move(reached)};
+			}
+		};
+
+		template<typename E>
+		auto default_delta(std::span<E const> weights, std::size_t node_count) -> E {
+			auto const heaviest =
+			   weights.empty() ? E{} : *std::max_element(weights.begin(), weights.end());
+			auto const delta = static_cast<double>(heaviest) * static_cast<double>(node_count)
+			                   / static_cast<double>(std::max(weights.size(), std::size_t{1}));
+			if constexpr (std::is_integral_v<E>)
+				return std::max(E{1}, static_cast<E>(delta));
+			else
+				return delta > 0 ? static_cast<E>(delta) : E{1};
+		}
+	} // namespace detail
+
+	// Multi-threaded single source shortest paths from src by delta-stepping. Gives the same
+	// distances as gdwg::shortest_paths, and a shortest path tree that may differ where paths tie.
+	// Pays off with several threads on graphs that are large and not too deep; a small delta
+	// does less wasted work, a large one needs fewer buckets and so fewer barriers. Weights must
+	// not be negative.
+	template<typename N, typename E>
+	requires arithmetic<E>
+	auto delta_stepping(csr_graph<N, E> const& g,
+	                    N const& src,
+	                    delta_stepping_options<E> const& options = {})
+	   -> shortest_paths_result<N, E> {
+		auto const src_index = g.index_of(src);
+		if (src_index == csr_graph<N, E>::npos) {
+			throw std::runtime_error("Cannot call gdwg::delta_stepping if src doesn't exist in the "
+			                         "graph");
+		}
+		auto const weights = g.edge_weights();
+		if (std::any_of(weights.begin(), weights.end(), [](E const& w) { return w < E{}; })) {
+			throw std::runtime_error("Cannot call gdwg::delta_stepping on a graph with negative "
+			                         "weights");
+		}
+		if (options.delta < E{})
+			throw std::runtime_error("Cannot call gdwg::delta_stepping with a negative delta");
+
+		auto const threads = detail::worker_count(options.threads, g.node_count());
+		auto const delta =
+		   options.delta == E{} ? detail::default_delta(weights, g.node_count()) : options.delta;
+		auto search = detail::delta_stepping_search<E>(g.offsets(), g.targets(), weights, delta);
+		return detail::make_result(g.nodes(), src_index, search.run(src_index, threads));
+	}
+
+	template<typename N, typename E>
+	requires arithmetic<E>
+	auto delta_stepping(graph<N, E> const& g,
+	                    N const& src,
+	                    delta_stepping_options<E> const& options = {})
+	   -> shortest_paths_result<N, E> {
+		return delta_stepping(csr_graph<N, E>(g), src, options);
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_DELTA_STEPPING_HPP
@@ -0,0 +1,1065 @@
+#ifndef GDWG_FLAT_GRAPH_HPP
+#define GDWG_FLAT_GRAPH_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+	// Storage backend for graphs whose nodes and weights are small trivially copyable values.
+	// Rather than a shared_ptr per node and weight, nodes are kept by value in one sorted vector and
+	// each node owns two sorted vectors alongside it: its outgoing edges as (dst, weight) pairs, and
+	// the src nodes of its incoming edges. Looking up a node is a binary search over contiguous
+	// memory, and an edge costs sizeof(N) + sizeof(E) bytes.
+	// Inserting or erasing a node shifts the vectors behind it, so loading many nodes in random
+	// order is best done through the range or from_edges constructors.
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	class graph<N, E> {
+	public:
+		using value_type = graph_value_type<N, E>;
+
+	private:
+		using size_type = std::size_t;
+		static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+		struct out_edge {
+			N to;
+			E weight;
+
+			[[nodiscard]] auto operator==(out_edge const& other) const noexcept -> bool = default;
+			[[nodiscard]] auto operator<(out_edge const& other) const noexcept -> bool {
+				return (to < other.to || other.to < to) ? to < other.to : weight < other.weight;
+			}
+		};
+
+		using out_edges_type = std::vector<out_edge>;
+		using out_edge_span = std::ranges::subrange<typename out_edges_type::const_iterator>;
+
+		// Unlike the iterators of a transform_view, these don't point back at the range they came
+		// from, so they stay usable once it is gone (for instance on a traversal's stack)
+		class out_edge_iterator {
+			using base_iter = typename out_edges_type::const_iterator;
+
+		public:
+			using value_type = out_edge_ref<N, E>;
+			using reference = value_type;
+			using difference_type = std::ptrdiff_t;
+			using iterator_concept = std::forward_iterator_tag;
+			using iterator_category = std::input_iterator_tag;
+
+			out_edge_iterator() = default;
+			explicit out_edge_iterator(base_iter it)
+			: it_{it} {}
+
+			auto operator*() const -> reference {
+				return reference{it_->to, it_->weight};
+			}
+
+			auto operator++() -> out_edge_iterator& {
+				++it_;
+				return *this;
+			}
+
+			auto operator++(int) -> out_edge_iterator {
+				auto tmp = *this;
+				++it_;
+				return tmp;
+			}
+
+			auto operator==(out_edge_iterator const& other) const noexcept -> bool = default;
+
+		private:
+			base_iter it_;
+		};
+
+		struct weight_of {
+			auto operator()(out_edge const& edge) const noexcept -> E const& {
+				return edge.weight;
+			}
+		};
+
+		// nodes, out and in are parallel: out[i] and in[i] belong to nodes[i]
+		struct storage {
+			std::vector<N> nodes;
+			std::vector<out_edges_type> out;
+			std::vector<std::vector<N>> in;
+
+			[[nodiscard]] auto index_of(N const& value) const noexcept -> size_type {
+				auto it = std::lower_bound(nodes.begin(), nodes.end(), value);
+				return (it != nodes.end() && !(value < *it)) ? static_cast<size_type>(it - nodes.begin())
+				                                             : npos;
+			}
+
+			[[nodiscard]] auto next_source(size_type node) const noexcept -> size_type {
+				while (node < out.size() && out[node].empty())
+					++node;
+				return node;
+			}
+
+			// The edges from the src-th node to dst, one per weight
+			[[nodiscard]] auto dst_range(size_type src, N const& dst) const noexcept
+			   -> std::pair<typename out_edges_type::const_iterator,
+			                typename out_edges_type::const_iterator> {
+				auto const& edges = out[src];
+				auto first =
+				   std::lower_bound(edges.begin(), edges.end(), dst, [](auto& e, N const& v) {
+					   return e.to < v;
+				   });
+				auto last = std::upper_bound(first, edges.end(), dst, [](N const& v, auto& e) {
+					return v < e.to;
+				});
+				return {first, last};
+			}
+		};
+
+		// Walks the srcs in one dst's in list, and each one's edges to dst in its out list, which
+		// are found as the walk reaches them
+		class in_edge_iterator {
+			using src_iter = typename std::vector<N>::const_iterator;
+			using base_iter = typename out_edges_type::const_iterator;
+
+		public:
+			using value_type = in_edge_ref<N, E>;
+			using reference = value_type;
+			using difference_type = std::ptrdiff_t;
+			using iterator_concept = std::forward_iterator_tag;
+			using iterator_category = std::input_iterator_tag;
+
+			in_edge_iterator() = default;
+			in_edge_iterator(storage const& s, N const& dst, src_iter src, src_iter last)
+			: s_{&s}
+			, dst_{dst}
+			, src_{src}
+			, last_{last} {
+				enter();
+			}
+
+			auto operator*() const -> reference {
+				return reference{*src_, it_->weight};
+			}
+
+			auto operator++() -> in_edge_iterator& {
+				if (++it_ == bucket_end_) {
+					++src_;
+					enter();
+				}
+				return *this;
+			}
+
+			auto operator++(int) -> in_edge_iterator {
+				auto tmp = *this;
+				++(*this);
+				return tmp;
+			}
+
+			auto operator==(in_edge_iterator const& other) const noexcept -> bool {
+				return src_ == other.src_ && it_ == other.it_;
+			}
+
+		private:
+			storage const* s_ = nullptr;
+			N dst_ = N{};
+			src_iter src_;
+			src_iter last_;
+			base_iter it_;
+			base_iter bucket_end_;
+
+			// Every src in an in list has at least one edge to its dst
+			auto enter() -> void {
+				if (src_ == last_) {
+					it_ = base_iter{};
+					return;
+				}
+				auto const [first, last] = s_->dst_range(s_->index_of(*src_), dst_);
+				it_ = first;
+				bucket_end_ = last;
+			}
+		};
+
+		// Iterators point into the heap allocated storage, so like the iterators of the pointer
+		// based graph they stay valid when the graph is moved. They remember the edge they are at and
+		// find it again if inserts or erases have shifted the vectors since.
+		class iterator {
+		public:
+			using value_type = graph<N, E>::value_type;
+			// A copy of the cached edge rather than a graph_edge_ref: flat types are cheaper to copy
+			// than to refer to, and a reference into the cache would dangle with the iterator
+			using reference = value_type;
+			using pointer = void;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::bidirectional_iterator_tag;
+
+			iterator() = default;
+
+			auto operator*() const -> reference {
+				return value_type(from_, edge_.to, edge_.weight);
+			}
+
+			auto operator++() -> iterator& {
+				sync();
+				if (++pos_ == s_->out[node_].size()) {
+					node_ = s_->next_source(node_ + 1);
+					pos_ = 0;
+				}
+				load();
+				return *this;
+			}
+
+			auto operator++(int) -> iterator {
+				iterator tmp = *this;
+				++(*this);
+				return tmp;
+			}
+
+			auto operator--() -> iterator& {
+				sync();
+				if (node_ == npos)
+					node_ = s_->nodes.size();
+				if (pos_ == 0) {
+					do {
+						--node_;
+					} while (s_->out[node_].empty());
+					pos_ = s_->out[node_].size();
+				}
+				--pos_;
+				load();
+				return *this;
+			}
+
+			auto operator--(int) -> iterator {
+				iterator tmp = *this;
+				--(*this);
+				return tmp;
+			}
+
+			auto operator==(iterator const& other) const noexcept -> bool {
+				if (node_ == npos || other.node_ == npos)
+					return node_ == other.node_;
+				return from_ == other.from_ && edge_ == other.edge_;
+			}
+
+		private:
+			storage const* s_ = nullptr;
+			size_type node_ = npos;
+			size_type pos_ = 0;
+			N from_{};
+			out_edge edge_{};
+
+			friend class graph;
+
+			iterator(storage const* s, size_type node, size_type pos)
+			: s_{s}
+			, node_{node}
+			, pos_{pos} {
+				load();
+			}
+
+			// Normalises a position past the last node to end and caches the edge at the position
+			auto load() noexcept -> void {
+				if (node_ >= s_->nodes.size()) {
+					node_ = npos;
+					pos_ = 0;
+					return;
+				}
+				from_ = s_->nodes[node_];
+				edge_ = s_->out[node_][pos_];
+			}
+
+			// Moves the position back onto the cached edge, or onto the edge after it if it is gone
+			auto sync() noexcept -> void {
+				if (node_ == npos)
+					return;
+				if (node_ < s_->nodes.size() && pos_ < s_->out[node_].size()
+				    && s_->nodes[node_] == from_ && s_->out[node_][pos_] == edge_)
+				{
+					return;
+				}
+
+				auto node = std::lower_bound(s_->nodes.begin(), s_->nodes.end(), from_);
+				node_ = static_cast<size_type>(node - s_->nodes.begin());
+				pos_ = 0;
+				if (node != s_->nodes.end() && *node == from_) {
+					auto const& out = s_->out[node_];
+					pos_ = static_cast<size_type>(std::lower_bound(out.begin(), out.end(), edge_)
+					                              - out.begin());
+					if (pos_ < out.size())
+						return;
+					++node_;
+					pos_ = 0;
+				}
+				// pos_ has to land on an edge, since operator++ and operator-- step from it
+				node_ = s_->next_source(node_);
+				if (node_ == s_->nodes.size())
+					node_ = npos;
+			}
+		};
+
+	public:
+		using iter = iterator;
+		using reverse_iterator = std::reverse_iterator<iter>;
+		// Views of the sorted (dst, weight) list of a node, returned by out_edges and weights_view,
+		// and of the edges into it, returned by in_edges. They allocate nothing and are invalidated
+		// by any modification of the graph.
+		using out_edge_range = std::ranges::subrange<out_edge_iterator>;
+		using in_edge_range = std::ranges::subrange<in_edge_iterator>;
+		using weight_range = std::ranges::transform_view<out_edge_span, weight_of>;
+
+		graph() noexcept = default;
+		graph(std::initializer_list<N> il);
+		template<typename InputIt>
+		graph(InputIt first, InputIt last);
+		template<std::ranges::input_range EdgeRange>
+		requires std::convertible_to<std::ranges::range_reference_t<EdgeRange>, value_type>
+		graph(from_edges_t, EdgeRange&& edges);
+		graph(graph const& other);
+		graph(graph&& other) noexcept;
+		auto operator=(graph const& other) -> graph&;
+		auto operator=(graph&& other) noexcept -> graph&;
+
+		[[nodiscard]] auto operator==(graph const& other) const noexcept -> bool;
+
+		[[nodiscard]] auto is_node(N const& value) const noexcept -> bool;
+		[[nodiscard]] auto empty() const noexcept -> bool;
+		[[nodiscard]] auto is_connected(N const& src, N const& dst) const -> bool;
+		[[nodiscard]] auto nodes() const noexcept -> std::vector<N>;
+		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E>;
+		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const noexcept -> iterator;
+		[[nodiscard]] auto connections(N const& src) const -> std::vector<N>;
+		[[nodiscard]] auto in_connections(N const& dst) const -> std::vector<N>;
+		[[nodiscard]] auto in_degree(N const& dst) const -> std::size_t;
+		[[nodiscard]] auto out_edges(N const& src) const -> out_edge_range;
+		[[nodiscard]] auto in_edges(N const& dst) const -> in_edge_range;
+		[[nodiscard]] auto weights_view(N const& src, N const& dst) const -> weight_range;
+
+		auto insert_node(N const& value) -> bool;
+		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool;
+		template<typename InputIt>
+		auto insert_edges(InputIt first, InputIt last) -> std::size_t;
+		auto replace_node(N const& old_data, N const& new_data) -> bool;
+		auto merge_replace_node(N const& old_data, N const& new_data) -> void;
+		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool;
+		auto erase_node(N const& value) noexcept -> bool;
+		template<std::ranges::input_range NodeRange>
+		auto erase_nodes(NodeRange&& values) -> std::size_t;
+		template<std::predicate<N const&> Pred>
+		auto erase_nodes_if(Pred pred) -> std::size_t;
+		auto erase_edge(iterator i) noexcept -> iterator;
+		auto erase_edge(iterator i, iterator s) noexcept -> iterator;
+		auto clear() noexcept -> void;
+
+		[[nodiscard]] auto begin() const -> iter {
+			return iter{&data(), data().next_source(0), 0};
+		}
+
+		[[nodiscard]] auto end() const -> iter {
+			return iter{&data(), npos, 0};
+		}
+
+		friend auto operator<<(std::ostream& os, graph<N, E> const& g) noexcept -> std::ostream& {
+			g.print_to(os);
+			return os;
+		}
+
+		friend auto print_edges(N node, std::ostream& os, graph<N, E> const& g) noexcept
+		   -> std::ostream& {
+			auto src = g.data().index_of(node);
+			if (src != npos)
+				g.print_out_edges(os, src);
+			return os;
+		}
+
+		// Same output as operator<<, formatted through a buffered_writer
+		auto write(buffered_writer& out) const -> void {
+			print_to(out);
+		}
+
+	private:
+		// Null until the graph is first modified, and after it has been moved from
+		std::unique_ptr<storage> storage_;
+
+		[[nodiscard]] auto data() const noexcept -> storage const& {
+			static auto const empty = storage{};
+			return storage_ ? *storage_ : empty;
+		}
+
+		auto mutable_data() -> storage& {
+			if (!storage_)
+				storage_ = std::make_unique<storage>();
+			return *storage_;
+		}
+
+		[[nodiscard]] auto dst_range(size_type src, N const& dst) const noexcept
+		   -> std::pair<typename out_edges_type::const_iterator, typename out_edges_type::const_iterator>;
+		static auto sort_edges(std::vector<value_type>& edges) -> void;
+		auto link_edge(size_type src, N const& dst) -> void;
+		auto unlink_edge(size_type src, N const& dst) noexcept -> void;
+		auto erase_out_edges(size_type src, size_type first, size_type last) noexcept -> void;
+		[[nodiscard]] auto incident_edges(N const& value) const -> std::vector<value_type>;
+
+		template<typename Out>
+		auto print_to(Out& out) const -> void {
+			for (auto i = size_type{0}; i < data().nodes.size(); ++i) {
+				out << data().nodes[i] << " (\n";
+				print_out_edges(out, i);
+				out << ")\n";
+			}
+		}
+
+		template<typename Out>
+		auto print_out_edges(Out& out, size_type src) const -> void {
+			for (auto const& edge : data().out[src]) {
+				out << "  " << edge.to << " | " << edge.weight << "\n";
+			}
+		}
+	};
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	graph<N, E>::graph(std::initializer_list<N> il)
+	: graph(il.begin(), il.end()) {}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	template<typename InputIt>
+	graph<N, E>::graph(InputIt first, InputIt last) {
+		auto& d = mutable_data();
+		d.nodes.assign(first, last);
+		std::sort(d.nodes.begin(), d.nodes.end());
+		d.nodes.erase(std::unique(d.nodes.begin(), d.nodes.end()), d.nodes.end());
+		d.out.resize(d.nodes.size());
+		d.in.resize(d.nodes.size());
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	template<std::ranges::input_range EdgeRange>
+	requires std::convertible_to<std::ranges::range_reference_t<EdgeRange>,
+	                             typename graph<N, E>::value_type>
+	graph<N, E>::graph(from_edges_t, EdgeRange&& edges) {
+		auto sorted = std::vector<value_type>{};
+		if constexpr (std::ranges::sized_range<EdgeRange>) {
+			sorted.reserve(std::ranges::size(edges));
+		}
+		std::ranges::copy(edges, std::back_inserter(sorted));
+		sort_edges(sorted);
+
+		auto& d = mutable_data();
+		d.nodes.reserve(sorted.size() * 2);
+		std::for_each(sorted.begin(), sorted.end(), [&](auto& edge) {
+			d.nodes.push_back(edge.from);
+			d.nodes.push_back(edge.to);
+		});
+		std::sort(d.nodes.begin(), d.nodes.end());
+		d.nodes.erase(std::unique(d.nodes.begin(), d.nodes.end()), d.nodes.end());
+		d.nodes.shrink_to_fit();
+		d.out.resize(d.nodes.size());
+		d.in.resize(d.nodes.size());
+
+		// Edges are sorted by (from, to, weight), so every list is built by appending in order
+		auto src = size_type{0};
+		std::for_each(sorted.begin(), sorted.end(), [&](auto& edge) {
+			while (d.nodes[src] < edge.from)
+				++src;
+			if (d.out[src].empty() || !(d.out[src].back().to == edge.to))
+				d.in[d.index_of(edge.to)].push_back(edge.from);
+			d.out[src].push_back(out_edge{edge.to, edge.weight});
+		});
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	graph<N, E>::graph(graph const& other)
+	: storage_(other.storage_ ? std::make_unique<storage>(*other.storage_) : nullptr) {}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	graph<N, E>::graph(graph&& other) noexcept
+	: storage_(std::exchange(other.storage_, nullptr)) {}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::operator=(graph const& other) -> graph& {
+		graph(other).storage_.swap(storage_);
+		return *this;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::operator=(graph&& other) noexcept -> graph& {
+		storage_.swap(other.storage_);
+
+		other.storage_ = nullptr;
+		return *this;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::operator==(graph const& other) const noexcept -> bool {
+		return data().nodes == other.data().nodes && data().out == other.data().out;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::dst_range(size_type src, N const& dst) const noexcept
+	   -> std::pair<typename out_edges_type::const_iterator, typename out_edges_type::const_iterator> {
+		return data().dst_range(src, dst);
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::sort_edges(std::vector<value_type>& edges) -> void {
+		auto less = [](auto const& l, auto const& r) {
+			if (l.from < r.from || r.from < l.from)
+				return l.from < r.from;
+			if (l.to < r.to || r.to < l.to)
+				return l.to < r.to;
+			return l.weight < r.weight;
+		};
+		std::sort(edges.begin(), edges.end(), less);
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::is_node(N const& value) const noexcept -> bool {
+		return data().index_of(value) != npos;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::empty() const noexcept -> bool {
+		return data().nodes.empty();
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::is_connected(N const& src, N const& dst) const -> bool {
+		auto src_index = data().index_of(src);
+		if (src_index == npos || is_node(dst) == false) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::is_connected if src or dst node "
+			                         "don't exist in the graph");
+		}
+
+		auto [first, last] = dst_range(src_index, dst);
+		return first != last;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::nodes() const noexcept -> std::vector<N> {
+		return data().nodes;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::weights(N const& src, N const& dst) const -> std::vector<E> {
+		auto src_index = data().index_of(src);
+		if (src_index == npos || is_node(dst) == false) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights if src or dst node don't "
+			                         "exist in the graph");
+		}
+
+		auto ret = std::vector<E>();
+		auto [first, last] = dst_range(src_index, dst);
+		std::transform(first, last, std::back_inserter(ret), [](auto& edge) { return edge.weight; });
+		return ret;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::find(N const& src, N const& dst, E const& weight) const noexcept
+	   -> iterator {
+		auto src_index = data().index_of(src);
+		if (src_index == npos)
+			return end();
+
+		auto const& out = data().out[src_index];
+		auto found = std::lower_bound(out.begin(), out.end(), out_edge{dst, weight});
+		if (found == out.end() || !(*found == out_edge{dst, weight}))
+			return end();
+
+		return iter{&data(), src_index, static_cast<size_type>(found - out.begin())};
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::connections(N const& src) const -> std::vector<N> {
+		auto src_index = data().index_of(src);
+		if (src_index == npos)
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::connections if src doesn't exist "
+			                         "in the graph");
+
+		auto v = std::vector<N>{};
+		for (auto const& edge : data().out[src_index]) {
+			if (v.empty() || !(v.back() == edge.to))
+				v.push_back(edge.to);
+		}
+
+		return v;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::in_connections(N const& dst) const -> std::vector<N> {
+		auto dst_index = data().index_of(dst);
+		if (dst_index == npos)
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::in_connections if dst doesn't "
+			                         "exist in the graph");
+
+		return data().in[dst_index];
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::out_edges(N const& src) const -> out_edge_range {
+		auto src_index = data().index_of(src);
+		if (src_index == npos)
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::out_edges if src doesn't exist "
+			                         "in the graph");
+
+		auto const& out = data().out[src_index];
+		return out_edge_range{out_edge_iterator{out.begin()}, out_edge_iterator{out.end()}};
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::in_edges(N const& dst) const -> in_edge_range {
+		auto dst_index = data().index_of(dst);
+		if (dst_index == npos)
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::in_edges if dst doesn't exist "
+			                         "in the graph");
+
+		auto const& in = data().in[dst_index];
+		return in_edge_range{in_edge_iterator{data(), dst, in.begin(), in.end()},
+		                     in_edge_iterator{data(), dst, in.end(), in.end()}};
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::weights_view(N const& src, N const& dst) const -> weight_range {
+		auto src_index = data().index_of(src);
+		if (src_index == npos || is_node(dst) == false) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights_view if src or dst node "
+			                         "don't exist in the graph");
+		}
+
+		auto [first, last] = dst_range(src_index, dst);
+		return weight_range{out_edge_span{first, last}, weight_of{}};
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::in_degree(N const& dst) const -> std::size_t {
+		auto dst_index = data().index_of(dst);
+		if (dst_index == npos)
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::in_degree if dst doesn't exist in "
+			                         "the graph");
+
+		auto degree = std::size_t{0};
+		for (auto const& src : data().in[dst_index]) {
+			auto [first, last] = dst_range(data().index_of(src), dst);
+			degree += static_cast<std::size_t>(last - first);
+		}
+		return degree;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::insert_node(N const& value) -> bool {
+		auto& d = mutable_data();
+		auto it = std::lower_bound(d.nodes.begin(), d.nodes.end(), value);
+		if (it != d.nodes.end() && !(value < *it))
+			return false;
+
+		auto offset = it - d.nodes.begin();
+		d.nodes.insert(it, value);
+		d.out.insert(d.out.begin() + offset, out_edges_type{});
+		d.in.insert(d.in.begin() + offset, std::vector<N>{});
+		return true;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::link_edge(size_type src, N const& dst) -> void {
+		auto& d = mutable_data();
+		auto& in = d.in[d.index_of(dst)];
+		auto pos = std::lower_bound(in.begin(), in.end(), d.nodes[src]);
+		if (pos == in.end() || d.nodes[src] < *pos)
+			in.insert(pos, d.nodes[src]);
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::unlink_edge(size_type src, N const& dst) noexcept -> void {
+		// src stays an in-connection of dst while any weight between them is left
+		auto [first, last] = dst_range(src, dst);
+		if (first != last)
+			return;
+
+		auto& d = *storage_;
+		auto& in = d.in[d.index_of(dst)];
+		auto pos = std::lower_bound(in.begin(), in.end(), d.nodes[src]);
+		if (pos != in.end() && *pos == d.nodes[src])
+			in.erase(pos);
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::insert_edge(N const& src, N const& dst, E const& weight) -> bool {
+		auto src_index = data().index_of(src);
+		if (src_index == npos || is_node(dst) == false) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edge when either src or "
+			                         "dst node does not exist");
+		}
+
+		auto& out = storage_->out[src_index];
+		auto edge = out_edge{dst, weight};
+		auto pos = std::lower_bound(out.begin(), out.end(), edge);
+		if (pos != out.end() && *pos == edge)
+			return false;
+
+		out.insert(pos, edge);
+		link_edge(src_index, dst);
+		return true;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	template<typename InputIt>
+	auto graph<N, E>::insert_edges(InputIt first, InputIt last) -> std::size_t {
+		auto sorted = std::vector<value_type>(first, last);
+		if (sorted.empty())
+			return 0;
+		sort_edges(sorted);
+
+		// Resolve every endpoint before changing anything, so a missing node leaves the graph as it
+		// was. Sources are sorted, so their indices are found by walking nodes forward.
+		auto const& nodes = data().nodes;
+		auto dsts = std::vector<size_type>(sorted.size());
+		auto srcs = std::vector<size_type>(sorted.size());
+		auto next_src = size_type{0};
+		for (auto i = size_type{0}; i < sorted.size(); ++i) {
+			while (next_src < nodes.size() && nodes[next_src] < sorted[i].from)
+				++next_src;
+			srcs[i] = next_src;
+			dsts[i] = data().index_of(sorted[i].to);
+			if (next_src == nodes.size() || sorted[i].from < nodes[next_src] || dsts[i] == npos) {
+				throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edges when either src "
+				                         "or dst node does not exist");
+			}
+		}
+
+		// Edges are appended in order. A list only needs sorting again if it already held edges
+		// that sort after the new ones, which never happens when loading into an empty graph.
+		auto& d = *storage_;
+		if (sorted.size() >= nodes.size()) {
+			// Large batches reserve every list up front rather than growing them edge by edge
+			auto in_counts = std::vector<size_type>(nodes.size());
+			std::for_each(dsts.begin(), dsts.end(), [&](auto dst) { ++in_counts[dst]; });
+			for (auto i = size_type{0}; i < nodes.size(); ++i) {
+				d.in[i].reserve(d.in[i].size() + in_counts[i]);
+			}
+		}
+
+		auto inserted = std::size_t{0};
+		auto unsorted_in = std::vector<size_type>{};
+		for (auto i = size_type{0}; i < sorted.size();) {
+			auto const src_index = srcs[i];
+			auto const src = sorted[i].from;
+			auto& out = d.out[src_index];
+			auto const old_size = out.size();
+			auto const batch_end = std::find_if(srcs.begin() + static_cast<std::ptrdiff_t>(i),
+			                                    srcs.end(),
+			                                    [&](auto s) { return s != src_index; });
+			out.reserve(old_size + static_cast<size_type>(batch_end - srcs.begin()) - i);
+			for (; i < sorted.size() && srcs[i] == src_index; ++i) {
+				out.push_back(out_edge{sorted[i].to, sorted[i].weight});
+
+				auto& in = d.in[dsts[i]];
+				if (in.empty() || in.back() < src) {
+					in.push_back(src);
+				}
+				else if (src < in.back()) {
+					in.push_back(src);
+					unsorted_in.push_back(dsts[i]);
+				}
+			}
+
+			auto const middle = out.begin() + static_cast<std::ptrdiff_t>(old_size);
+			if (old_size != 0 && !(out[old_size - 1] < *middle)) {
+				std::inplace_merge(out.begin(), middle, out.end());
+				out.erase(std::unique(out.begin(), out.end()), out.end());
+			}
+			inserted += out.size() - old_size;
+		}
+
+		std::sort(unsorted_in.begin(), unsorted_in.end());
+		unsorted_in.erase(std::unique(unsorted_in.begin(), unsorted_in.end()), unsorted_in.end());
+		for (auto dst : unsorted_in) {
+			std::sort(d.in[dst].begin(), d.in[dst].end());
+			d.in[dst].erase(std::unique(d.in[dst].begin(), d.in[dst].end()), d.in[dst].end());
+		}
+
+		return inserted;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	[[nodiscard]] auto graph<N, E>::incident_edges(N const& value) const -> std::vector<value_type> {
+		auto const& d = data();
+		auto index = d.index_of(value);
+		auto edges = std::vector<value_type>{};
+		for (auto const& edge : d.out[index]) {
+			edges.emplace_back(value, edge.to, edge.weight);
+		}
+		for (auto const& src : d.in[index]) {
+			// self-loops were already collected with the outgoing edges
+			if (src == value)
+				continue;
+			auto [first, last] = dst_range(d.index_of(src), value);
+			std::for_each(first, last, [&](auto& edge) { edges.emplace_back(src, value, edge.weight); });
+		}
+		return edges;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::replace_node(N const& old_data, N const& new_data) -> bool {
+		if (is_node(old_data) == false) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::replace_node on a node that "
+			                         "doesn't exist");
+		}
+
+		if (is_node(new_data))
+			return false;
+
+		// Nodes are ordered by value, so the renamed node and its edges are moved to their new place
+		auto edges = incident_edges(old_data);
+		erase_node(old_data);
+		insert_node(new_data);
+		std::for_each(edges.begin(), edges.end(), [&](auto& edge) {
+			insert_edge(edge.from == old_data ? new_data : edge.from,
+			            edge.to == old_data ? new_data : edge.to,
+			            edge.weight);
+		});
+
+		return true;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::merge_replace_node(N const& old_data, N const& new_data) -> void {
+		if ((is_node(old_data) == false) || (is_node(new_data) == false)) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::merge_replace_node on old or new "
+			                         "data if they don't exist in the graph");
+		}
+
+		if (old_data == new_data)
+			return;
+
+		// Edges that already exist on new_data are rejected by insert_edge, which merges them
+		auto edges = incident_edges(old_data);
+		erase_node(old_data);
+		std::for_each(edges.begin(), edges.end(), [&](auto& edge) {
+			insert_edge(edge.from == old_data ? new_data : edge.from,
+			            edge.to == old_data ? new_data : edge.to,
+			            edge.weight);
+		});
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::erase_node(N const& value) noexcept -> bool {
+		auto index = data().index_of(value);
+		if (index == npos)
+			return false;
+
+		// Drop value from the in-connections of its dsts, and its edges from its srcs' lists
+		auto& d = *storage_;
+		for (auto const& edge : d.out[index]) {
+			auto& in = d.in[d.index_of(edge.to)];
+			auto pos = std::lower_bound(in.begin(), in.end(), value);
+			if (pos != in.end() && *pos == value)
+				in.erase(pos);
+		}
+		for (auto const& src : d.in[index]) {
+			auto src_index = d.index_of(src);
+			auto [first, last] = dst_range(src_index, value);
+			auto& out = d.out[src_index];
+			out.erase(out.begin() + (first - out.cbegin()), out.begin() + (last - out.cbegin()));
+		}
+
+		auto offset = static_cast<std::ptrdiff_t>(index);
+		d.nodes.erase(d.nodes.begin() + offset);
+		d.out.erase(d.out.begin() + offset);
+		d.in.erase(d.in.begin() + offset);
+
+		return true;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	template<std::ranges::input_range NodeRange>
+	auto graph<N, E>::erase_nodes(NodeRange&& values) -> std::size_t {
+		auto marked = std::vector<N>{};
+		for (auto const& value : values) {
+			if (is_node(value))
+				marked.push_back(value);
+		}
+		std::sort(marked.begin(), marked.end());
+		marked.erase(std::unique(marked.begin(), marked.end()), marked.end());
+
+		return erase_nodes_if(
+		   [&](N const& value) { return std::binary_search(marked.begin(), marked.end(), value); });
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	template<std::predicate<N const&> Pred>
+	auto graph<N, E>::erase_nodes_if(Pred pred) -> std::size_t {
+		if (!storage_)
+			return 0;
+
+		auto& d = *storage_;
+		auto marked = std::vector<bool>(d.nodes.size());
+		auto count = std::size_t{0};
+		for (auto i = size_type{0}; i < d.nodes.size(); ++i) {
+			marked[i] = pred(std::as_const(d.nodes[i]));
+			count += marked[i] ? 1 : 0;
+		}
+		if (count == 0)
+			return 0;
+
+		// Drop every reference to a marked node from the lists of the nodes that stay, then close
+		// the gaps the marked nodes leave behind
+		auto is_marked = [&](N const& value) { return marked[d.index_of(value)]; };
+		for (auto i = size_type{0}; i < d.nodes.size(); ++i) {
+			if (marked[i])
+				continue;
+			std::erase_if(d.out[i], [&](auto& edge) { return is_marked(edge.to); });
+			std::erase_if(d.in[i], is_marked);
+		}
+
+		auto kept = size_type{0};
+		for (auto i = size_type{0}; i < d.nodes.size(); ++i) {
+			if (marked[i])
+				continue;
+			if (kept != i) {
+				d.nodes[kept] = d.nodes[i];
+				d.out[kept] = std::move(d.out[i]);
+				d.in[kept] = std::move(d.in[i]);
+			}
+			++kept;
+		}
+
+		d.nodes.resize(kept);
+		d.out.resize(kept);
+		d.in.resize(kept);
+		return count;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::erase_edge(N const& src, N const& dst, E const& weight) -> bool {
+		auto src_index = data().index_of(src);
+		if (src_index == npos || is_node(dst) == false) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::erase_edge on src or dst if they "
+			                         "don't exist in the graph");
+		}
+
+		auto& out = storage_->out[src_index];
+		auto edge = out_edge{dst, weight};
+		auto pos = std::lower_bound(out.begin(), out.end(), edge);
+		if (pos == out.end() || !(*pos == edge))
+			return false;
+
+		out.erase(pos);
+		unlink_edge(src_index, dst);
+		return true;
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::erase_out_edges(size_type src, size_type first, size_type last) noexcept
+	   -> void {
+		auto& out = storage_->out[src];
+		auto last_it = out.begin() + static_cast<std::ptrdiff_t>(last);
+		for (auto it = out.begin() + static_cast<std::ptrdiff_t>(first); it != last_it;) {
+			// Erase edge by edge to the same dst, so the in-connection can be dropped after the last
+			auto dst = it->to;
+			auto run_end = std::find_if(it, last_it, [&](auto& e) { return !(e.to == dst); });
+			auto erased = run_end - it;
+			it = out.erase(it, run_end);
+			last_it -= erased;
+			unlink_edge(src, dst);
+		}
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::erase_edge(iterator i) noexcept -> iterator {
+		if (i == end())
+			return end();
+
+		i.sync();
+		erase_out_edges(i.node_, i.pos_, i.pos_ + 1);
+
+		// The following edge has moved into the erased slot, unless it was the last of its node
+		if (i.pos_ == storage_->out[i.node_].size())
+			return iter{storage_.get(), storage_->next_source(i.node_ + 1), 0};
+		return iter{storage_.get(), i.node_, i.pos_};
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::erase_edge(iterator i, iterator s) noexcept -> iterator {
+		if (i == end())
+			return end();
+		if (i == s)
+			return s;
+
+		i.sync();
+		s.sync();
+		if (i.node_ == s.node_) {
+			erase_out_edges(i.node_, i.pos_, s.pos_);
+			return iter{storage_.get(), i.node_, i.pos_};
+		}
+
+		auto& d = *storage_;
+		auto last_node = (s.node_ == npos) ? d.nodes.size() : s.node_;
+		erase_out_edges(i.node_, i.pos_, d.out[i.node_].size());
+		for (auto node = i.node_ + 1; node < last_node; ++node) {
+			erase_out_edges(node, 0, d.out[node].size());
+		}
+		if (s.node_ == npos)
+			return end();
+
+		erase_out_edges(s.node_, 0, s.pos_);
+		return iter{storage_.get(), s.node_, 0};
+	}
+
+	template<typename N, typename E>
+	requires flat_storable<N, E>
+	auto graph<N, E>::clear() noexcept -> void {
+		if (storage_) {
+			storage_->nodes.clear();
+			storage_->out.clear();
+			storage_->in.clear();
+		}
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_FLAT_GRAPH_HPP
@@ -0,0 +1,327 @@
+#ifndef GDWG_GENERATORS_HPP
+#define GDWG_GENERATORS_HPP
+
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Synthetic graphs for benchmarks and load tests.
+// Every generator numbers its nodes 0 .. n - 1 and is deterministic for a given seed and standard
+// library. The edges are collected first and loaded through graph::insert_edges, which sorts them
+// once rather than inserting them one at a time. Unless stated otherwise, weights are drawn
+// uniformly from [1, max_weight].
+namespace gdwg {
+
+	namespace detail {
+		// Uniform weights in [low, high]. std::uniform_int_distribution isn't defined for character
+		// types, so integers narrower than int are drawn as int.
+		template<typename E>
+		class weight_distribution {
+		public:
+			weight_distribution(E low, E high)
+			: distribution_(static_cast<drawn>(low), static_cast<drawn>(high)) {}
+
+			template<typename Rng>
+			auto operator()(Rng& rng) -> E {
+				return static_cast<E>(distribution_(rng));
+			}
+
+		private:
+			using drawn = std::conditional_t<std::integral<E> && (sizeof(E) < sizeof(int)), int, E>;
+			std::conditional_t<std::integral<E>,
+			                   std::uniform_int_distribution<drawn>,
+			                   std::uniform_real_distribution<drawn>>
+			   distribution_;
+		};
+
+		template<std::integral N, arithmetic E>
+		auto build_graph(std::size_t node_count, std::vector<graph_value_type<N, E>> const& edges)
+		   -> graph<N, E> {
+			auto nodes = std::vector<N>(node_count);
+			std::iota(nodes.begin(), nodes.end(), N{0});
+
+			auto g = graph<N, E>(nodes.begin(), nodes.end());
+			g.insert_edges(edges.begin(), edges.end());
+			return g;
+		}
+	} // namespace detail
+
+	// G(n, m): edge_count edges between uniformly chosen distinct nodes. Repeated draws of the same
+	// pair become parallel edges, unless they also draw the same weight, in which case they merge
+	// and the graph ends up with slightly fewer edges.
+	template<std::integral N, arithmetic E>
+	auto erdos_renyi(std::size_t node_count,
+	                 std::size_t edge_count,
+	                 std::uint64_t seed,
+	                 E max_weight = E{100}) -> graph<N, E> {
+		if (node_count < 2 && edge_count > 0) {
+			throw std::invalid_argument("Cannot call gdwg::erdos_renyi with edges on fewer than two "
+			                            "nodes");
+		}
+
+		auto rng = std::mt19937_64{seed};
+		auto node = std::uniform_int_distribution<std::size_t>{0, node_count - 1};
+		auto weight = detail::weight_distribution<E>{E{1}, max_weight};
+
+		auto edges = std::vector<graph_value_type<N, E>>{};
+		edges.reserve(edge_count);
+		while (edges.size() < edge_count) {
+			auto const from = node(rng);
+			auto const to = node(rng);
+			if (from != to)
+				edges.emplace_back(static_cast<N>(from), static_cast<N>(to), weight(rng));
+		}
+		return detail::build_graph(node_count, edges);
+	}
+
+	// Preferential attachment: every node after the first edges_per_node + 1 adds edges_per_node
+	// edges to earlier nodes, picked with probability proportional to their degree. The seed nodes
+	// form a ring. In-degrees follow a power law.
+	template<std::integral N, arithmetic E>
+	auto barabasi_albert(std::size_t node_count,
+	                     std::size_t edges_per_node,
+	                     std::uint64_t seed,
+	                     E max_weight = E{100}) -> graph<N, E> {
+		if (edges_per_node == 0 || node_count <= edges_per_node) {
+			throw std::invalid_argument("Cannot call gdwg::barabasi_albert with edges_per_node == 0 "
+			                            "or not fewer than node_count");
+		}
+
+		auto rng = std::mt19937_64{seed};
+		auto weight = detail::weight_distribution<E>{E{1}, max_weight};
+
+		auto edges = std::vector<graph_value_type<N, E>>{};
+		edges.reserve(node_count * edges_per_node);
+		// Every edge adds both of its ends, so a uniform pick from here is a pick by degree
+		auto ends = std::vector<std::size_t>{};
+		ends.reserve(2 * node_count * edges_per_node);
+
+		auto add_edge = [&](std::size_t from, std::size_t to) {
+			edges.emplace_back(static_cast<N>(from), static_cast<N>(to), weight(rng));
+			ends.push_back(from);
+			ends.push_back(to);
+		};
+
+		auto const seed_nodes = edges_per_node + 1;
+		for (auto n = std::size_t{0}; n < seed_nodes; ++n) {
+			add_edge(n, (n + 1) % seed_nodes);
+		}
+
+		auto targets = std::vector<std::size_t>{};
+		for (auto n = seed_nodes; n < node_count; ++n) {
+			targets.clear();
+			while (targets.size() < edges_per_node) {
+				auto end = std::uniform_int_distribution<std::size_t>{0, ends.size() - 1};
+				auto const target = ends[end(rng)];
+				if (std::find(targets.begin(), targets.end(), target) == targets.end())
+					targets.push_back(target);
+			}
+			for (auto target : targets) {
+				add_edge(n, target);
+			}
+		}
+		return detail::build_graph(node_count, edges);
+	}
+
+	// R-MAT / Kronecker graph with 2^scale nodes and edge_factor edges per node. Each edge picks one
+	// quadrant of the adjacency matrix per level with probabilities a, b, c and 1 - a - b - c.
+	// Node labels are shuffled afterwards so that the hubs aren't all at small ids. Repeated draws
+	// of the same pair become parallel edges, and only merge when their weights match too.
+	struct rmat_parameters {
+		double a = 0.57;
+		double b = 0.19;
+		double c = 0.19;
+	};
+
+	template<std::integral N, arithmetic E>
+	auto rmat(std::size_t scale,
+	          std::size_t edge_factor,
+	          std::uint64_t seed,
+	          rmat_parameters p = {},
+	          E max_weight = E{100}) -> graph<N, E> {
+		if (p.a < 0 || p.b < 0 || p.c < 0 || p.a + p.b + p.c > 1) {
+			throw std::invalid_argument("Cannot call gdwg::rmat with quadrant probabilities that "
+			                            "aren't a distribution");
+		}
+
+		auto const node_count = std::size_t{1} << scale;
+		auto rng = std::mt19937_64{seed};
+		auto unit = std::uniform_real_distribution<double>{0.0, 1.0};
+		auto weight = detail::weight_distribution<E>{E{1}, max_weight};
+
+		auto labels = std::vector<std::size_t>(node_count);
+		std::iota(labels.begin(), labels.end(), std::size_t{0});
+		std::shuffle(labels.begin(), labels.end(), rng);
+
+		auto const edge_count = node_count * edge_factor;
+		auto edges = std::vector<graph_value_type<N, E>>{};
+		edges.reserve(edge_count);
+		for (auto e = std::size_t{0}; e < edge_count; ++e) {
+			auto from = std::size_t{0};
+			auto to = std::size_t{0};
+			for (auto bit = std::size_t{0}; bit < scale; ++bit) {
+				auto const r = unit(rng);
+				auto const right = (r >= p.a && r < p.a + p.b) || r >= p.a + p.b + p.c;
+				auto const down = r >= p.a + p.b;
+				from = (from << 1) | (down ? 1 : 0);
+				to = (to << 1) | (right ? 1 : 0);
+			}
+			edges.emplace_back(static_cast<N>(labels[from]), static_cast<N>(labels[to]), weight(rng));
+		}
+		return detail::build_graph(node_count, edges);
+	}
+
+	// rows x cols lattice where node r * cols + c has edges in both directions to its right and
+	// lower neighbours. Each direction gets its own weight.
+	template<std::integral N, arithmetic E>
+	auto grid(std::size_t rows, std::size_t cols, std::uint64_t seed, E max_weight = E{100})
+	   -> graph<N, E> {
+		auto rng = std::mt19937_64{seed};
+		auto weight = detail::weight_distribution<E>{E{1}, max_weight};
+
+		auto edges = std::vector<graph_value_type<N, E>>{};
+		edges.reserve(4 * rows * cols);
+		auto add_edges = [&](std::size_t a, std::size_t b) {
+			edges.emplace_back(static_cast<N>(a), static_cast<N>(b), weight(rng));
+			edges.emplace_back(static_cast<N>(b), static_cast<N>(a), weight(rng));
+		};
+
+		for (auto r = std::size_t{0}; r < rows; ++r) {
+			for (auto c = std::size_t{0}; c < cols; ++c) {
+				auto const node = r * cols + c;
+				if (c + 1 < cols)
+					add_edges(node, node + 1);
+				if (r + 1 < rows)
+					add_edges(node, node + cols);
+			}
+		}
+		return detail::build_graph(rows * cols, edges);
+	}
+
+	struct point {
+		double x;
+		double y;
+	};
+
+	// node_count points placed uniformly in the unit square
+	inline auto random_points(std::size_t node_count, std::uint64_t seed) -> std::vector<point> {
+		auto rng = std::mt19937_64{seed};
+		auto unit = std::uniform_real_distribution<double>{0.0, 1.0};
+
+		auto points = std::vector<point>(node_count);
+		for (auto& p : points) {
+			p.x = unit(rng);
+			p.y = unit(rng);
+		}
+		return points;
+	}
+
+	// Road-network-like graph: every point is joined in both directions to its k nearest points.
+	// With k == 0 the points are left unconnected.
+	// The weight is the distance times scale, rounded up to at least 1 for integral weights.
+	// Node i is points[i], so the points can serve as coordinates for A* heuristics.
+	template<std::integral N, arithmetic E>
+	auto geometric(std::vector<point> const& points, std::size_t k, double scale = 1e6)
+	   -> graph<N, E> {
+		auto const node_count = points.size();
+		if (k >= node_count && node_count > 0) {
+			throw std::invalid_argument("Cannot call gdwg::geometric with k not fewer than the number "
+			                            "of points");
+		}
+		if (k == 0)
+			return detail::build_graph<N, E>(node_count, {});
+
+		// Bucket the points into cells of about two points each, then search rings of cells around
+		// each point until the k nearest are known
+		auto const side = std::max<std::size_t>(
+		   1, static_cast<std::size_t>(std::sqrt(static_cast<double>(node_count) / 2.0)));
+		auto const cell_of = [&](double v) {
+			return std::min(side - 1, static_cast<std::size_t>(v * static_cast<double>(side)));
+		};
+		auto cell_start = std::vector<std::size_t>(side * side + 1, 0);
+		for (auto const& p : points) {
+			++cell_start[cell_of(p.y) * side + cell_of(p.x) + 1];
+		}
+		std::partial_sum(cell_start.begin(), cell_start.end(), cell_start.begin());
+		auto cells = std::vector<std::size_t>(node_count);
+		auto fill = std::vector<std::size_t>(cell_start.begin(), cell_start.end() - 1);
+		for (auto i = std::size_t{0}; i < node_count; ++i) {
+			cells[fill[cell_of(points[i].y) * side + cell_of(points[i].x)]++] = i;
+		}
+
+		auto const distance = [&](std::size_t a, std::size_t b) {
+			return std::hypot(points[a].x - points[b].x, points[a].y - points[b].y);
+		};
+		auto const to_weight = [&](double d) {
+			if constexpr (std::integral<E>) {
+				return std::max(E{1}, static_cast<E>(std::ceil(d * scale)));
+			}
+			else {
+				return static_cast<E>(d * scale);
+			}
+		};
+
+		auto edges = std::vector<graph_value_type<N, E>>{};
+		edges.reserve(2 * k * node_count);
+		auto nearest = std::vector<std::pair<double, std::size_t>>{};
+		for (auto i = std::size_t{0}; i < node_count; ++i) {
+			auto const cx = static_cast<std::ptrdiff_t>(cell_of(points[i].x));
+			auto const cy = static_cast<std::ptrdiff_t>(cell_of(points[i].y));
+			auto const cell_size = 1.0 / static_cast<double>(side);
+
+			nearest.clear();
+			for (auto ring = std::ptrdiff_t{0};; ++ring) {
+				for (auto y = cy - ring; y <= cy + ring; ++y) {
+					for (auto x = cx - ring; x <= cx + ring; ++x) {
+						auto const on_ring = std::max(std::abs(x - cx), std::abs(y - cy)) == ring;
+						auto const s = static_cast<std::ptrdiff_t>(side);
+						if (!on_ring || x < 0 || y < 0 || x >= s || y >= s)
+							continue;
+						auto const cell = static_cast<std::size_t>(y * s + x);
+						for (auto c = cell_start[cell]; c < cell_start[cell + 1]; ++c) {
+							if (cells[c] != i)
+								nearest.emplace_back(distance(i, cells[c]), cells[c]);
+						}
+					}
+				}
+
+				// Every point outside the rings searched so far is at least ring * cell_size away
+				if (nearest.size() >= k) {
+					auto const kth = nearest.begin() + static_cast<std::ptrdiff_t>(k - 1);
+					std::nth_element(nearest.begin(), kth, nearest.end());
+					if (kth->first <= static_cast<double>(ring) * cell_size
+					    || ring >= static_cast<std::ptrdiff_t>(side))
+					{
+						break;
+					}
+				}
+			}
+
+			for (auto n = std::size_t{0}; n < k; ++n) {
+				auto const [d, j] = nearest[n];
+				edges.emplace_back(static_cast<N>(i), static_cast<N>(j), to_weight(d));
+				edges.emplace_back(static_cast<N>(j), static_cast<N>(i), to_weight(d));
+			}
+		}
+		return detail::build_graph(node_count, edges);
+	}
+
+	template<std::integral N, arithmetic E>
+	auto geometric(std::size_t node_count, std::size_t k, std::uint64_t seed, double scale = 1e6)
+	   -> graph<N, E> {
+		return geometric<N, E>(random_points(node_count, seed), k, scale);
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_GENERATORS_HPP
@@ -2,13 +2,20 @@
 #define GDWG_GRAPH_HPP
 
 #include <algorithm>
+#include <charconv>
 #include <concepts>
 #include <iostream>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <ranges>
 #include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -28,6 +35,81 @@ auto operator<<(std::ostream& os, const std::vector<T>& collection) noexcept ->
 
 namespace gdwg {
 
+	// Formats output into a reusable char buffer and writes it to the stream in large blocks.
+	// Integral and floating point values are formatted with std::to_chars, matching the default
+	// formatting of std::ostream; anything else is formatted through a reusable string stream.
+	class buffered_writer {
+	public:
+		explicit buffered_writer(std::ostream& os, std::size_t block_size = 64 * 1024)
+		: os_{os}
+		, block_size_{block_size} {
+			buffer_.reserve(block_size_ + 64);
+		}
+
+		buffered_writer(buffered_writer const&) = delete;
+		auto operator=(buffered_writer const&) -> buffered_writer& = delete;
+
+		~buffered_writer() {
+			flush();
+		}
+
+		template<typename T>
+		auto operator<<(T const& value) -> buffered_writer& {
+			if constexpr (std::is_same_v<T, char>) {
+				buffer_.push_back(value);
+			}
+			else if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+				buffer_.append(std::string_view(value));
+			}
+			else if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>
+			                   && !std::is_same_v<T, signed char> && !std::is_same_v<T, unsigned char>)
+			{
+				append_chars(value);
+			}
+			else {
+				scratch_.str("");
+				scratch_ << value;
+				buffer_.append(scratch_.view());
+			}
+
+			if (buffer_.size() >= block_size_)
+				flush();
+			return *this;
+		}
+
+		auto flush() -> void {
+			os_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+			buffer_.clear();
+		}
+
+	private:
+		std::ostream& os_;
+		std::size_t block_size_;
+		std::string buffer_;
+		std::ostringstream scratch_;
+
+		template<typename T>
+		auto append_chars(T value) -> void {
+			char chars[64];
+			auto result = std::to_chars_result{};
+			if constexpr (std::is_floating_point_v<T>) {
+				// same as std::ostream's default %g with precision 6
+				result =
+				   std::to_chars(chars, chars + sizeof(chars), value, std::chars_format::general, 6);
+			}
+			else {
+				result = std::to_chars(chars, chars + sizeof(chars), value);
+			}
+			buffer_.append(chars, result.ptr);
+		}
+	};
+
+	// Tag selecting the graph constructor that bulk-loads nodes and edges from a range of edges
+	struct from_edges_t {
+		explicit from_edges_t() = default;
+	};
+	inline constexpr from_edges_t from_edges{};
+
 	template<typename T, typename P>
 	class PointerComparator {
 	public:
@@ -75,25 +157,88 @@ namespace gdwg {
 		}
 	};
 
+	// An edge as handed out by graph, whichever way the graph stores it
+	template<typename N, typename E>
+	struct graph_value_type {
+		graph_value_type() = default;
+		graph_value_type(N f, N t, E w)
+		: from(f)
+		, to(t)
+		, weight(w){};
+		N from;
+		N to;
+		E weight;
+		[[nodiscard]] auto operator==(graph_value_type const& other) const noexcept -> bool = default;
+
+		friend auto operator<<(std::ostream& os, graph_value_type const& v) noexcept -> std::ostream& {
+			os << "(" << v.from << " " << v.to << " " << v.weight << ")";
+			return os;
+		}
+	};
+
+	// What dereferencing a graph iterator gives: the edge's nodes and weight as stored in the graph,
+	// so walking the edges copies nothing. Converts to value_type for a copy that outlives the
+	// graph; like the iterator it came from, it's only valid until the graph is next modified.
+	// Flat graphs (see flat_graph.hpp) hand out value_type copies instead.
+	template<typename N, typename E>
+	struct graph_edge_ref {
+		N const& from;
+		N const& to;
+		E const& weight;
+
+		operator graph_value_type<N, E>() const {
+			return graph_value_type<N, E>(from, to, weight);
+		}
+
+		[[nodiscard]] friend auto operator==(graph_edge_ref const& a, graph_edge_ref const& b) noexcept
+		   -> bool {
+			return a.from == b.from && a.to == b.to && a.weight == b.weight;
+		}
+		[[nodiscard]] friend auto operator==(graph_edge_ref const& a,
+		                                     graph_value_type<N, E> const& b) noexcept -> bool {
+			return a.from == b.from && a.to == b.to && a.weight == b.weight;
+		}
+
+		friend auto operator<<(std::ostream& os, graph_edge_ref const& v) noexcept -> std::ostream& {
+			os << "(" << v.from << " " << v.to << " " << v.weight << ")";
+			return os;
+		}
+	};
+
+	// An edge seen from its source: the dst node and weight as stored in the graph. Handed out by
+	// graph::out_edges, and only valid until the graph is next modified.
+	template<typename N, typename E>
+	struct out_edge_ref {
+		N const& to;
+		E const& weight;
+	};
+
+	// An edge seen from its destination: the src node and weight as stored in the graph. Handed out
+	// by graph::in_edges, and only valid until the graph is next modified.
+	template<typename N, typename E>
+	struct in_edge_ref {
+		N const& from;
+		E const& weight;
+	};
+
+	// Small trivially copyable node and weight types are stored by value in sorted vectors (see
+	// flat_graph.hpp) instead of behind a shared_ptr each. Specialise this to false to opt a type out.
+	template<typename T>
+	inline constexpr bool enable_flat_storage =
+	   std::is_trivially_copyable_v<T> && std::default_initializable<T> && std::totally_ordered<T>
+	   && sizeof(T) <= 16;
+
+	template<typename N, typename E>
+	concept flat_storable = enable_flat_storage<N> && enable_flat_storage<E>;
+
+	// Weights that algorithms can add up and compare, such as path lengths
+	template<typename T>
+	concept arithmetic = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+
 	template<typename N, typename E>
 	class graph {
 	public:
-		struct value_type {
-			value_type() = default;
-			value_type(N f, N t, E w)
-			: from(f)
-			, to(t)
-			, weight(w){};
-			N from;
-			N to;
-			E weight;
-			[[nodiscard]] auto operator==(value_type const& other) const noexcept -> bool = default;
-
-			friend auto operator<<(std::ostream& os, value_type const& v) noexcept -> std::ostream& {
-				os << "(" << v.from << " " << v.to << " " << v.weight << ")";
-				return os;
-			}
-		};
+		using value_type = graph_value_type<N, E>;
 
 	private:
 		class iterator {
@@ -106,27 +251,20 @@ namespace gdwg {
 
 		public:
 			using value_type = graph<N, E>::value_type;
-			using reference = value_type;
+			using reference = graph_edge_ref<N, E>;
 			using pointer = void;
 			using difference_type = std::ptrdiff_t;
 			using iterator_category = std::bidirectional_iterator_tag;
 
 			iterator() = default;
-			iterator(outer_iter o_iter = {},
-			         inner_iter i_iter = {},
-			         outer_iter o_rend = {},
-			         outer_iter o_end = {})
+			iterator(outer_iter o_iter, inner_iter i_iter, outer_iter o_rend, outer_iter o_end)
 			: outer_iter_{o_iter}
 			, inner_iter_{i_iter}
 			, outer_iter_rend_{o_rend}
 			, outer_iter_end_{o_end} {}
 
-			auto operator*() -> reference {
-				auto res = value_type();
-				res.from = *(*outer_iter_).first.first;
-				res.to = *(*outer_iter_).first.second;
-				res.weight = *(*inner_iter_);
-				return res;
+			auto operator*() const -> reference {
+				return reference{*outer_iter_->first.first, *outer_iter_->first.second, **inner_iter_};
 			}
 
 			auto operator++() -> iterator& {
@@ -170,7 +308,11 @@ namespace gdwg {
 				return tmp;
 			}
 
-			auto operator==(iterator const& other) const noexcept -> bool = default;
+			// Only the position takes part in comparison: the cached begin/end sentinels of an
+			// iterator obtained before a modification would otherwise compare unequal.
+			auto operator==(iterator const& other) const noexcept -> bool {
+				return outer_iter_ == other.outer_iter_ && inner_iter_ == other.inner_iter_;
+			}
 
 		private:
 			outer_iter outer_iter_;
@@ -188,14 +330,147 @@ namespace gdwg {
 			};
 		};
 
+		// Walks the weights of consecutive edges_ buckets. out_edges limits it to one source.
+		class out_edge_iterator {
+			using outer_iter = typename iterator::outer_iter;
+			using inner_iter = typename iterator::inner_iter;
+
+		public:
+			using value_type = out_edge_ref<N, E>;
+			using reference = value_type;
+			using difference_type = std::ptrdiff_t;
+			using iterator_concept = std::forward_iterator_tag;
+			using iterator_category = std::input_iterator_tag;
+
+			out_edge_iterator() = default;
+
+			auto operator*() const -> reference {
+				return reference{*bucket_->first.second, **weight_};
+			}
+
+			auto operator++() -> out_edge_iterator& {
+				if (++weight_ == bucket_->second.cend()) {
+					++bucket_;
+					weight_ = (bucket_ == last_) ? inner_iter{} : bucket_->second.cbegin();
+				}
+				return *this;
+			}
+
+			auto operator++(int) -> out_edge_iterator {
+				auto tmp = *this;
+				++(*this);
+				return tmp;
+			}
+
+			auto operator==(out_edge_iterator const& other) const noexcept -> bool {
+				return bucket_ == other.bucket_ && weight_ == other.weight_;
+			}
+
+		private:
+			outer_iter bucket_;
+			inner_iter weight_;
+			outer_iter last_;
+
+			friend class graph;
+
+			out_edge_iterator(outer_iter bucket, inner_iter weight, outer_iter last)
+			: bucket_{bucket}
+			, weight_{weight}
+			, last_{last} {}
+		};
+
+		// Walks the srcs that in_edges_ lists for one dst, and the weights of each one's edges_
+		// bucket, which is found as the walk reaches it
+		class in_edge_iterator {
+			using bucket_iter = typename iterator::outer_iter;
+			using inner_iter = typename iterator::inner_iter;
+			using src_iter =
+			   typename std::set<std::shared_ptr<N>, PointerComparator<std::shared_ptr<N>, N>>::const_iterator;
+
+		public:
+			using value_type = in_edge_ref<N, E>;
+			using reference = value_type;
+			using difference_type = std::ptrdiff_t;
+			using iterator_concept = std::forward_iterator_tag;
+			using iterator_category = std::input_iterator_tag;
+
+			in_edge_iterator() = default;
+
+			auto operator*() const -> reference {
+				return reference{**src_, **weight_};
+			}
+
+			auto operator++() -> in_edge_iterator& {
+				if (++weight_ == bucket_->second.cend()) {
+					++src_;
+					enter();
+				}
+				return *this;
+			}
+
+			auto operator++(int) -> in_edge_iterator {
+				auto tmp = *this;
+				++(*this);
+				return tmp;
+			}
+
+			auto operator==(in_edge_iterator const& other) const noexcept -> bool {
+				return src_ == other.src_ && weight_ == other.weight_;
+			}
+
+		private:
+			graph const* graph_ = nullptr;
+			std::shared_ptr<N> const* dst_ = nullptr;
+			src_iter src_;
+			src_iter last_;
+			bucket_iter bucket_;
+			inner_iter weight_;
+
+			friend class graph;
+
+			in_edge_iterator(graph const& g, std::shared_ptr<N> const& dst, src_iter src, src_iter last)
+			: graph_{&g}
+			, dst_{&dst}
+			, src_{src}
+			, last_{last} {
+				enter();
+			}
+
+			// Every src in in_edges_ has a non-empty bucket of edges to dst
+			auto enter() -> void {
+				if (src_ == last_) {
+					weight_ = inner_iter{};
+					return;
+				}
+				bucket_ = graph_->edges_.find(std::pair{*src_, *dst_});
+				weight_ = bucket_->second.cbegin();
+			}
+		};
+
+		struct dereference_weight {
+			auto operator()(std::shared_ptr<E> const& weight) const noexcept -> E const& {
+				return *weight;
+			}
+		};
+
 	public:
 		using iter = iterator;
 		using reverse_iterator = std::reverse_iterator<iter>;
+		// Ranges over the edges as stored, returned by out_edges, in_edges and weights_view. They
+		// allocate nothing and are invalidated by any modification of the graph.
+		using out_edge_range = std::ranges::subrange<out_edge_iterator>;
+		using in_edge_range = std::ranges::subrange<in_edge_iterator>;
+		using weight_range = std::ranges::transform_view<
+		   std::ranges::subrange<typename iterator::inner_iter>,
+		   dereference_weight>;
 
 		graph() noexcept = default;
 		graph(std::initializer_list<N> il);
 		template<typename InputIt>
 		graph(InputIt first, InputIt last);
+		template<std::ranges::input_range EdgeRange>
+		requires std::convertible_to<std::ranges::range_reference_t<EdgeRange>, value_type>
+		graph(from_edges_t, EdgeRange&& edges);
 		graph(graph const& other);
 		graph(graph&& other) noexcept;
 		auto operator=(graph const& other) -> graph&;
@@ -210,13 +485,24 @@ namespace gdwg {
 		[[nodiscard]] auto weights(N const& src, N const& dst) const -> std::vector<E>;
 		[[nodiscard]] auto find(N const& src, N const& dst, E const& weight) const noexcept -> iterator;
 		[[nodiscard]] auto connections(N const& src) const -> std::vector<N>;
+		[[nodiscard]] auto in_connections(N const& dst) const -> std::vector<N>;
+		[[nodiscard]] auto in_degree(N const& dst) const -> std::size_t;
+		[[nodiscard]] auto out_edges(N const& src) const -> out_edge_range;
+		[[nodiscard]] auto in_edges(N const& dst) const -> in_edge_range;
+		[[nodiscard]] auto weights_view(N const& src, N const& dst) const -> weight_range;
 
 		auto insert_node(N const& value) -> bool;
 		auto insert_edge(N const& src, N const& dst, E const& weight) -> bool;
+		template<typename InputIt>
+		auto insert_edges(InputIt first, InputIt last) -> std::size_t;
 		auto replace_node(N const& old_data, N const& new_data) -> bool;
 		auto merge_replace_node(N const& old_data, N const& new_data) -> void;
 		auto erase_edge(N const& src, N const& dst, E const& weight) -> bool;
 		auto erase_node(N const& value) noexcept -> bool;
+		template<std::ranges::input_range NodeRange>
+		auto erase_nodes(NodeRange&& values) -> std::size_t;
+		template<std::predicate<N const&> Pred>
+		auto erase_nodes_if(Pred pred) -> std::size_t;
 		auto erase_edge(iterator i) noexcept -> iterator;
 		auto erase_edge(iterator i, iterator s) noexcept -> iterator;
 		auto clear() noexcept -> void;
@@ -234,27 +520,25 @@ namespace gdwg {
 		}
 
 		friend auto operator<<(std::ostream& os, graph<N, E> const& g) noexcept -> std::ostream& {
-			std::for_each(g.nodes_.begin(), g.nodes_.end(), [&](const auto& node) {
-				os << *node << " (\n";
-				print_edges(*node, os, g);
-				os << ")\n";
-			});
-
+			g.print_to(os);
 			return os;
 		}
 
 		friend auto print_edges(N node, std::ostream& os, graph<N, E> const& g) noexcept
 		   -> std::ostream& {
-			auto edge_it = std::find_if(g.begin(), g.end(), [&](auto e) { return ((e.from == node)); });
-			if (edge_it != g.end()) {
-				while (edge_it != g.end() && (*edge_it).from == node) {
-					os << "  " << (*edge_it).to << " | " << (*edge_it).weight << "\n";
-					++edge_it;
-				}
+			for (auto it = g.edges_.lower_bound(node); it != g.edges_.end(); ++it) {
+				if (!(*it->first.first == node))
+					break;
+				g.print_bucket(os, *it);
 			}
 			return os;
 		}
 
+		// Same output as operator<<, formatted through a buffered_writer
+		auto write(buffered_writer& out) const -> void {
+			print_to(out);
+		}
+
 	private:
 		using nodes_type = std::set<std::shared_ptr<N>, PointerComparator<std::shared_ptr<N>, N>>;
 		using edges_type =
@@ -262,14 +546,52 @@ namespace gdwg {
 		            std::set<std::shared_ptr<E>, PointerComparator<std::shared_ptr<E>, E>>,
 		            PairPointersComparator<std::shared_ptr<N>, N>>;
 		using weights_type = std::set<std::shared_ptr<E>, PointerComparator<std::shared_ptr<E>, E>>;
+		// Interned weights, each mapped to the number of edges sharing it
+		using weight_index_type =
+		   std::map<std::shared_ptr<E>, std::size_t, PointerComparator<std::shared_ptr<E>, E>>;
+		// Reverse adjacency: every dst node mapped to the src nodes of its incoming edges
+		using in_edges_type =
+		   std::map<std::shared_ptr<N>, nodes_type, PointerComparator<std::shared_ptr<N>, N>>;
 
 		nodes_type nodes_;
 		edges_type edges_;
+		weight_index_type weight_index_;
+		in_edges_type in_edges_;
 
 		auto swap(graph& other) noexcept -> void;
 		[[nodiscard]] auto get_node_ptr(N const& value) const noexcept -> std::shared_ptr<N>;
 		[[nodiscard]] auto find_weight(E const& weight) const noexcept -> std::shared_ptr<E>;
+		auto acquire_weight(E const& weight) -> std::shared_ptr<E>;
+		auto release_weight(std::shared_ptr<E> const& weight) noexcept -> void;
+		auto release_weights(edges_type const& edges) noexcept -> void;
 		auto extract_edges(N const& value) noexcept -> edges_type;
+		// Sorts edges by (from, to, weight) and removes duplicates, the order edges_ stores them in
+		static auto sort_edges(std::vector<value_type>& edges) -> void;
+		auto insert_sorted_edges(std::vector<value_type> const& edges) -> std::size_t;
+		auto erase_marked_nodes(std::unordered_set<N const*> const& marked) noexcept -> std::size_t;
+		auto link_edge(typename edges_type::key_type const& edge) -> void;
+		auto unlink_edge(typename edges_type::key_type const& edge) noexcept -> void;
+
+		// Prints every node followed by its outgoing edges in a single merged pass over nodes_ and
+		// edges_, which are both sorted by source node
+		template<typename Out>
+		auto print_to(Out& out) const -> void {
+			auto edge_it = this->edges_.begin();
+			for (auto const& node : this->nodes_) {
+				out << *node << " (\n";
+				for (; edge_it != this->edges_.end() && *edge_it->first.first == *node; ++edge_it) {
+					print_bucket(out, *edge_it);
+				}
+				out << ")\n";
+			}
+		}
+
+		template<typename Out>
+		auto print_bucket(Out& out, typename edges_type::value_type const& edge) const -> void {
+			for (auto const& weight : edge.second) {
+				out << "  " << *edge.first.second << " | " << *weight << "\n";
+			}
+		}
 
 		[[nodiscard]] auto get_iterator(typename edges_type::const_iterator o_it,
 		                                typename weights_type::const_iterator i_it) const noexcept
@@ -290,16 +612,84 @@ namespace gdwg {
 		});
 	};
 
+	template<typename N, typename E>
+	auto graph<N, E>::sort_edges(std::vector<value_type>& edges) -> void {
+		auto less = [](auto const& l, auto const& r) {
+			if (l.from < r.from || r.from < l.from)
+				return l.from < r.from;
+			if (l.to < r.to || r.to < l.to)
+				return l.to < r.to;
+			return l.weight < r.weight;
+		};
+		std::sort(edges.begin(), edges.end(), less);
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+	}
+
+	template<typename N, typename E>
+	template<std::ranges::input_range EdgeRange>
+	requires std::convertible_to<std::ranges::range_reference_t<EdgeRange>,
+	                             typename graph<N, E>::value_type>
+	graph<N, E>::graph(from_edges_t, EdgeRange&& edges) {
+		auto sorted = std::vector<value_type>{};
+		if constexpr (std::ranges::sized_range<EdgeRange>) {
+			sorted.reserve(std::ranges::size(edges));
+		}
+		std::ranges::copy(edges, std::back_inserter(sorted));
+		sort_edges(sorted);
+
+		auto values = std::vector<N>{};
+		values.reserve(sorted.size() * 2);
+		std::for_each(sorted.begin(), sorted.end(), [&](auto& edge) {
+			values.push_back(edge.from);
+			values.push_back(edge.to);
+		});
+		std::sort(values.begin(), values.end());
+		values.erase(std::unique(values.begin(), values.end()), values.end());
+
+		// values are sorted, so every node goes in at the end of nodes_
+		std::for_each(values.begin(), values.end(), [&](auto& value) {
+			this->nodes_.emplace_hint(this->nodes_.end(), std::make_shared<N>(value));
+		});
+
+		insert_sorted_edges(sorted);
+	}
+
 	template<typename N, typename E>
 	graph<N, E>::graph(graph const& other) {
-		std::transform(other.nodes_.begin(),
-		               other.nodes_.end(),
-		               std::inserter(this->nodes_, this->nodes_.end()),
-		               [&](auto& node) { return std::make_shared<N>(*(node)); });
-
-		std::for_each(other.edges_.begin(), other.edges_.end(), [&](auto& pair) {
-			std::for_each(pair.second.begin(), pair.second.end(), [&](auto& weight) {
-				this->insert_edge(*(pair.first.first), *(pair.first.second), *weight);
+		// Every container is copied in its own order, so each element goes in at the end. Edges
+		// refer to nodes and weights by pointer, which are mapped to the copies through these tables
+		auto node_map = std::unordered_map<N const*, std::shared_ptr<N>>{};
+		node_map.reserve(other.nodes_.size());
+		std::for_each(other.nodes_.begin(), other.nodes_.end(), [&](auto& node) {
+			auto copy = std::make_shared<N>(*node);
+			node_map.emplace(node.get(), copy);
+			this->nodes_.emplace_hint(this->nodes_.end(), std::move(copy));
+		});
+
+		auto weight_map = std::unordered_map<E const*, std::shared_ptr<E>>{};
+		weight_map.reserve(other.weight_index_.size());
+		std::for_each(other.weight_index_.begin(), other.weight_index_.end(), [&](auto& weight) {
+			auto copy = std::make_shared<E>(*weight.first);
+			weight_map.emplace(weight.first.get(), copy);
+			this->weight_index_.emplace_hint(this->weight_index_.end(), std::move(copy), weight.second);
+		});
+
+		std::for_each(other.edges_.begin(), other.edges_.end(), [&](auto& edge) {
+			auto bucket = this->edges_.emplace_hint(
+			   this->edges_.end(),
+			   std::pair{node_map[edge.first.first.get()], node_map[edge.first.second.get()]},
+			   weights_type{});
+			std::for_each(edge.second.begin(), edge.second.end(), [&](auto& weight) {
+				bucket->second.emplace_hint(bucket->second.end(), weight_map[weight.get()]);
+			});
+		});
+
+		std::for_each(other.in_edges_.begin(), other.in_edges_.end(), [&](auto& in) {
+			auto srcs = this->in_edges_.emplace_hint(this->in_edges_.end(),
+			                                         node_map[in.first.get()],
+			                                         nodes_type{});
+			std::for_each(in.second.begin(), in.second.end(), [&](auto& src) {
+				srcs->second.emplace_hint(srcs->second.end(), node_map[src.get()]);
 			});
 		});
 	}
@@ -307,12 +697,16 @@ namespace gdwg {
 	template<typename N, typename E>
 	graph<N, E>::graph(graph&& other) noexcept
 	: nodes_(std::exchange(other.nodes_, nodes_type{}))
-	, edges_(std::exchange(other.edges_, edges_type{})) {}
+	, edges_(std::exchange(other.edges_, edges_type{}))
+	, weight_index_(std::exchange(other.weight_index_, weight_index_type{}))
+	, in_edges_(std::exchange(other.in_edges_, in_edges_type{})) {}
 
 	template<typename N, typename E>
 	void graph<N, E>::swap(graph& other) noexcept {
 		std::swap(this->nodes_, other.nodes_);
 		std::swap(this->edges_, other.edges_);
+		std::swap(this->weight_index_, other.weight_index_);
+		std::swap(this->in_edges_, other.in_edges_);
 	}
 
 	template<typename N, typename E>
@@ -327,6 +721,8 @@ namespace gdwg {
 
 		other.nodes_ = nodes_type{};
 		other.edges_ = edges_type{};
+		other.weight_index_ = weight_index_type{};
+		other.in_edges_ = in_edges_type{};
 		return *this;
 	}
 
@@ -397,6 +793,9 @@ namespace gdwg {
 
 		auto ret = std::vector<E>();
 		auto edge = edges_.find(std::pair{src, dst});
+		if (edge == edges_.end())
+			return ret;
+
 		std::transform(edge->second.begin(),
 		               edge->second.end(),
 		               std::back_inserter(ret),
@@ -440,6 +839,86 @@ namespace gdwg {
 		return v;
 	}
 
+	template<typename N, typename E>
+	[[nodiscard]] auto graph<N, E>::out_edges(N const& src) const -> out_edge_range {
+		if (is_node(src) == false)
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::out_edges if src doesn't exist "
+			                         "in the graph");
+
+		auto first = edges_.lower_bound(src);
+		auto last = edges_.upper_bound(src);
+		if (first == last)
+			return out_edge_range{};
+
+		return out_edge_range{out_edge_iterator{first, first->second.cbegin(), last},
+		                      out_edge_iterator{last, {}, last}};
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto graph<N, E>::in_edges(N const& dst) const -> in_edge_range {
+		if (is_node(dst) == false)
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::in_edges if dst doesn't exist "
+			                         "in the graph");
+
+		auto in = in_edges_.find(dst);
+		if (in == in_edges_.end())
+			return in_edge_range{};
+
+		auto const& srcs = in->second;
+		return in_edge_range{in_edge_iterator{*this, in->first, srcs.cbegin(), srcs.cend()},
+		                     in_edge_iterator{*this, in->first, srcs.cend(), srcs.cend()}};
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto graph<N, E>::weights_view(N const& src, N const& dst) const -> weight_range {
+		if ((is_node(src) == false) || (is_node(dst) == false)) {
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::weights_view if src or dst node "
+			                         "don't exist in the graph");
+		}
+
+		auto edge = edges_.find(std::pair{src, dst});
+		if (edge == edges_.end())
+			return weight_range{};
+
+		return weight_range{{edge->second.cbegin(), edge->second.cend()}, dereference_weight{}};
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto graph<N, E>::in_connections(N const& dst) const -> std::vector<N> {
+		if (is_node(dst) == false)
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::in_connections if dst doesn't "
+			                         "exist in the graph");
+
+		auto v = std::vector<N>{};
+		auto in = this->in_edges_.find(dst);
+		if (in != this->in_edges_.end()) {
+			std::transform(in->second.begin(),
+			               in->second.end(),
+			               std::back_inserter(v),
+			               [](auto& node) { return *node; });
+		}
+
+		return v;
+	}
+
+	template<typename N, typename E>
+	[[nodiscard]] auto graph<N, E>::in_degree(N const& dst) const -> std::size_t {
+		if (is_node(dst) == false)
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::in_degree if dst doesn't exist in "
+			                         "the graph");
+
+		auto in = this->in_edges_.find(dst);
+		if (in == this->in_edges_.end())
+			return 0;
+
+		auto dst_ptr = in->first;
+		auto degree = std::size_t{0};
+		std::for_each(in->second.begin(), in->second.end(), [&](auto& src_ptr) {
+			degree += this->edges_.find(std::pair{src_ptr, dst_ptr})->second.size();
+		});
+		return degree;
+	}
+
 	template<typename N, typename E>
 	auto graph<N, E>::insert_node(N const& value) -> bool {
 		if (this->nodes_.find(value) != this->nodes_.end())
@@ -450,15 +929,37 @@ namespace gdwg {
 
 	template<typename N, typename E>
 	[[nodiscard]] auto graph<N, E>::find_weight(E const& weight) const noexcept -> std::shared_ptr<E> {
-		// traditional for-loop function to return sooner
-		for (auto& edge : this->edges_) {
-			auto found = edge.second.find(weight);
-			if (found != edge.second.end()) {
-				return *found;
-			}
+		auto found = this->weight_index_.find(weight);
+		return (found != this->weight_index_.end()) ? found->first : std::shared_ptr<E>{};
+	}
+
+	template<typename N, typename E>
+	auto graph<N, E>::acquire_weight(E const& weight) -> std::shared_ptr<E> {
+		// Equal weights are shared between edges, so only the first edge with a weight allocates it
+		auto found = this->weight_index_.lower_bound(weight);
+		if (found != this->weight_index_.end() && !(weight < *found->first)) {
+			++found->second;
+			return found->first;
 		}
 
-		return {};
+		return this->weight_index_.emplace_hint(found, std::make_shared<E>(weight), 1)->first;
+	}
+
+	template<typename N, typename E>
+	auto graph<N, E>::release_weight(std::shared_ptr<E> const& weight) noexcept -> void {
+		auto found = this->weight_index_.find(*weight);
+		if (found != this->weight_index_.end() && --found->second == 0) {
+			this->weight_index_.erase(found);
+		}
+	}
+
+	template<typename N, typename E>
+	auto graph<N, E>::release_weights(edges_type const& edges) noexcept -> void {
+		std::for_each(edges.begin(), edges.end(), [&](auto& edge) {
+			std::for_each(edge.second.begin(), edge.second.end(), [&](auto& w) {
+				this->release_weight(w);
+			});
+		});
 	}
 
 	template<typename N, typename E>
@@ -471,14 +972,13 @@ namespace gdwg {
 		if (this->find(src, dst, weight) != this->end())
 			return false;
 
-		auto weight_ptr = this->find_weight(weight);
-		if (!weight_ptr)
-			weight_ptr = std::make_shared<E>(weight);
+		auto weight_ptr = this->acquire_weight(weight);
 
 		auto edge = this->edges_.find(std::pair{src, dst});
 		if (edge == this->edges_.end()) {
-			this->edges_.insert(
-			   std::pair{std::pair{get_node_ptr(src), get_node_ptr(dst)}, weights_type({weight_ptr})});
+			auto key = std::pair{get_node_ptr(src), get_node_ptr(dst)};
+			this->edges_.insert(std::pair{key, weights_type({weight_ptr})});
+			link_edge(key);
 		}
 		else {
 			edge->second.insert(weight_ptr);
@@ -487,17 +987,94 @@ namespace gdwg {
 		return true;
 	}
 
+	template<typename N, typename E>
+	template<typename InputIt>
+	auto graph<N, E>::insert_edges(InputIt first, InputIt last) -> std::size_t {
+		auto sorted = std::vector<value_type>(first, last);
+		if (std::any_of(sorted.begin(), sorted.end(), [&](auto& edge) {
+			    return (is_node(edge.from) == false) || (is_node(edge.to) == false);
+		    }))
+		{
+			throw std::runtime_error("Cannot call gdwg::graph<N, E>::insert_edges when either src or "
+			                         "dst node does not exist");
+		}
+
+		sort_edges(sorted);
+		return insert_sorted_edges(sorted);
+	}
+
+	template<typename N, typename E>
+	auto graph<N, E>::insert_sorted_edges(std::vector<value_type> const& edges) -> std::size_t {
+		// Contiguous copy of nodes_ so that looking up each dst is a cache friendly binary search
+		auto node_ptrs = std::vector<std::shared_ptr<N>>(this->nodes_.begin(), this->nodes_.end());
+		auto node_ptr = [&](N const& value) {
+			return *std::lower_bound(node_ptrs.begin(),
+			                         node_ptrs.end(),
+			                         value,
+			                         PointerComparator<std::shared_ptr<N>, N>{});
+		};
+
+		auto inserted = std::size_t{0};
+		auto bucket = this->edges_.end();
+
+		for (auto const& edge : edges) {
+			if (bucket == this->edges_.end() || !(*bucket->first.first == edge.from)
+			    || !(*bucket->first.second == edge.to))
+			{
+				// Input is sorted like edges_, so the next bucket belongs right after the last one
+				auto hint = (bucket == this->edges_.end()) ? this->edges_.begin() : std::next(bucket);
+				auto key = std::pair{node_ptr(edge.from), node_ptr(edge.to)};
+				auto size = this->edges_.size();
+				bucket = this->edges_.try_emplace(hint, key);
+				if (this->edges_.size() != size)
+					link_edge(key);
+			}
+
+			auto pos = bucket->second.lower_bound(edge.weight);
+			if (pos == bucket->second.end() || edge.weight < **pos) {
+				bucket->second.emplace_hint(pos, acquire_weight(edge.weight));
+				++inserted;
+			}
+		}
+
+		return inserted;
+	}
+
+	template<typename N, typename E>
+	auto graph<N, E>::link_edge(typename edges_type::key_type const& edge) -> void {
+		this->in_edges_.try_emplace(edge.second).first->second.insert(edge.first);
+	}
+
+	template<typename N, typename E>
+	auto graph<N, E>::unlink_edge(typename edges_type::key_type const& edge) noexcept -> void {
+		auto in = this->in_edges_.find(*edge.second);
+		in->second.erase(edge.first);
+		if (in->second.empty()) {
+			this->in_edges_.erase(in);
+		}
+	}
+
 	template<typename N, typename E>
 	auto graph<N, E>::extract_edges(N const& value) noexcept -> edges_type {
 		auto extracted_edges = edges_type{};
-		// To prevent iterator invalidation issues and therefore be able to extract edges in O(e)
-		// time, tradition for-loop is used
-		for (auto it = this->edges_.begin(), it_end = this->edges_.end(); it != it_end;) {
+
+		// Outgoing edges are contiguous in edges_ as it is sorted by src
+		for (auto it = this->edges_.lower_bound(value); it != this->edges_.end();) {
+			if (*it->first.first != value)
+				break;
 			auto tmp_it = it++;
-			if ((*tmp_it->first.first == value) || (*tmp_it->first.second == value)) {
-				extracted_edges.insert(*tmp_it);
-				this->edges_.erase(tmp_it);
-			}
+			unlink_edge(tmp_it->first);
+			extracted_edges.insert(this->edges_.extract(tmp_it));
+		}
+
+		// Incoming edges are found through the reverse index; self-loops were already extracted
+		auto in = this->in_edges_.find(value);
+		if (in != this->in_edges_.end()) {
+			auto dst_ptr = in->first;
+			std::for_each(in->second.begin(), in->second.end(), [&](auto& src_ptr) {
+				extracted_edges.insert(this->edges_.extract(std::pair{src_ptr, dst_ptr}));
+			});
+			this->in_edges_.erase(in);
 		}
 
 		return extracted_edges;
@@ -524,6 +1101,7 @@ namespace gdwg {
 		this->nodes_.insert(data_ptr);
 		std::for_each(edges_removed.begin(), edges_removed.end(), [&](auto& edge) {
 			this->edges_.insert(edge);
+			link_edge(edge.first);
 		});
 
 		return true;
@@ -545,17 +1123,23 @@ namespace gdwg {
 		auto found_node = this->nodes_.find(old_data);
 		auto data_ptr = *found_node;
 		this->nodes_.erase(found_node);
-		*data_ptr = new_data;
+		auto new_ptr = get_node_ptr(new_data);
 
 		std::for_each(edges_removed.begin(), edges_removed.end(), [&](auto& edge) {
-			auto found = this->edges_.find(edge.first);
+			// Re-key the edge onto the surviving node so no edge refers to the merged away pointer
+			auto key = std::pair{edge.first.first == data_ptr ? new_ptr : edge.first.first,
+			                     edge.first.second == data_ptr ? new_ptr : edge.first.second};
+			auto found = this->edges_.find(key);
 			if (found != this->edges_.end()) {
 				std::for_each(edge.second.begin(), edge.second.end(), [&](auto& w) {
-					found->second.insert(w);
+					// a weight merged into an edge that already has it is no longer referenced
+					if (found->second.insert(w).second == false)
+						this->release_weight(w);
 				});
 			}
 			else {
-				this->edges_.insert(edge);
+				this->edges_.insert(std::pair{key, edge.second});
+				link_edge(key);
 			}
 		});
 	}
@@ -565,12 +1149,67 @@ namespace gdwg {
 		if (is_node(value) == false)
 			return false;
 
-		extract_edges(value);
+		release_weights(extract_edges(value));
 		this->nodes_.erase(this->nodes_.find(value));
 
 		return true;
 	}
 
+	template<typename N, typename E>
+	template<std::ranges::input_range NodeRange>
+	auto graph<N, E>::erase_nodes(NodeRange&& values) -> std::size_t {
+		auto marked = std::unordered_set<N const*>{};
+		for (auto const& value : values) {
+			auto found = this->nodes_.find(value);
+			if (found != this->nodes_.end())
+				marked.insert(found->get());
+		}
+
+		return erase_marked_nodes(marked);
+	}
+
+	template<typename N, typename E>
+	template<std::predicate<N const&> Pred>
+	auto graph<N, E>::erase_nodes_if(Pred pred) -> std::size_t {
+		auto marked = std::unordered_set<N const*>{};
+		std::for_each(this->nodes_.begin(), this->nodes_.end(), [&](auto& node) {
+			if (pred(std::as_const(*node)))
+				marked.insert(node.get());
+		});
+
+		return erase_marked_nodes(marked);
+	}
+
+	template<typename N, typename E>
+	auto graph<N, E>::erase_marked_nodes(std::unordered_set<N const*> const& marked) noexcept
+	   -> std::size_t {
+		if (marked.empty())
+			return 0;
+
+		auto is_marked = [&](auto& node) { return marked.contains(node.get()); };
+
+		// A single pass over each container removes every edge incident to a marked node
+		for (auto it = this->edges_.begin(); it != this->edges_.end();) {
+			if (is_marked(it->first.first) || is_marked(it->first.second)) {
+				std::for_each(it->second.begin(), it->second.end(), [&](auto& w) {
+					this->release_weight(w);
+				});
+				it = this->edges_.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+
+		for (auto it = this->in_edges_.begin(); it != this->in_edges_.end();) {
+			if (!is_marked(it->first))
+				std::erase_if(it->second, is_marked);
+			it = (is_marked(it->first) || it->second.empty()) ? this->in_edges_.erase(it) : ++it;
+		}
+
+		return std::erase_if(this->nodes_, is_marked);
+	}
+
 	template<typename N, typename E>
 	auto graph<N, E>::erase_edge(N const& src, N const& dst, E const& weight) -> bool {
 		if ((is_node(src) == false) || (is_node(dst) == false)) {
@@ -586,8 +1225,10 @@ namespace gdwg {
 		if (weight_set_it == edge_it->second.end())
 			return false;
 
+		this->release_weight(*weight_set_it);
 		edge_it->second.erase(weight_set_it);
 		if (edge_it->second.empty()) {
+			unlink_edge(edge_it->first);
 			this->edges_.erase(edge_it);
 		}
 
@@ -605,9 +1246,11 @@ namespace gdwg {
 		auto outer_it = this->edges_.erase(const_outer_it, const_outer_it);
 		++i;
 
+		this->release_weight(*inner_it);
 		outer_it->second.erase(inner_it);
 
 		if (outer_it->second.empty()) {
+			unlink_edge(outer_it->first);
 			this->edges_.erase(outer_it);
 		}
 
@@ -634,10 +1277,14 @@ namespace gdwg {
 
 	template<typename N, typename E>
 	auto graph<N, E>::clear() noexcept -> void {
-		while (!this->nodes_.empty())
-			this->erase_node(*(*this->nodes_.begin()));
+		this->edges_.clear();
+		this->in_edges_.clear();
+		this->weight_index_.clear();
+		this->nodes_.clear();
 	}
 
 } // namespace gdwg
 
+#include "gdwg/flat_graph.hpp"
+
 #endif // GDWG_GRAPH_HPP
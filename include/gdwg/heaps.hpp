@@ -0,0 +1,221 @@
+#ifndef GDWG_HEAPS_HPP
+#define GDWG_HEAPS_HPP
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Priority queues for the shortest path algorithms, keyed by dense item indices 0 .. n - 1.
+// They share one interface:
+//     reset(n)          empties the heap and makes room for items 0 .. n - 1
+//     push(item, key)   item now has priority key, no greater than any key it was pushed with
+//     pop()             removes and returns a (key, item) pair with the smallest key
+//     empty()
+// A heap may hand out an item again with an outdated, larger key after it was pushed twice.
+// Callers skip those entries by comparing the key with the item's best known distance.
+namespace gdwg {
+
+	// Binary heap over a vector. A push adds an entry rather than updating the existing one, which
+	// is usually faster than keeping a position index for decrease-key.
+	template<typename Key>
+	class binary_heap {
+	public:
+		using size_type = std::size_t;
+
+		auto reset(size_type) -> void {
+			entries_.clear();
+		}
+
+		auto push(size_type item, Key key) -> void {
+			entries_.emplace_back(key, item);
+			std::push_heap(entries_.begin(), entries_.end(), std::greater<>{});
+		}
+
+		auto pop() -> std::pair<Key, size_type> {
+			std::pop_heap(entries_.begin(), entries_.end(), std::greater<>{});
+			auto top = entries_.back();
+			entries_.pop_back();
+			return top;
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return entries_.empty();
+		}
+
+	private:
+		std::vector<std::pair<Key, size_type>> entries_;
+	};
+
+	// Pairing heap with decrease-key, so every item is in the heap at most once. Nodes live in
+	// vectors indexed by item rather than being allocated one by one.
+	template<typename Key>
+	class pairing_heap {
+	public:
+		using size_type = std::size_t;
+
+		auto reset(size_type n) -> void {
+			root_ = npos;
+			nodes_.assign(n, node{});
+		}
+
+		auto push(size_type item, Key key) -> void {
+			auto& n = nodes_[item];
+			if (!n.in_heap) {
+				n = node{key, npos, npos, npos, true};
+				root_ = meld(root_, item);
+				return;
+			}
+
+			n.key = key;
+			if (item == root_)
+				return;
+
+			// Cut the item's subtree out of its parent's child list and meld it with the root
+			if (nodes_[n.prev].child == item)
+				nodes_[n.prev].child = n.next;
+			else
+				nodes_[n.prev].next = n.next;
+			if (n.next != npos)
+				nodes_[n.next].prev = n.prev;
+			n.prev = npos;
+			n.next = npos;
+			root_ = meld(root_, item);
+		}
+
+		auto pop() -> std::pair<Key, size_type> {
+			auto const top = root_;
+			nodes_[top].in_heap = false;
+			root_ = merge_pairs(nodes_[top].child);
+			return {nodes_[top].key, top};
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return root_ == npos;
+		}
+
+	private:
+		static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+		// prev is the previous sibling, or the parent for a first child
+		struct node {
+			Key key{};
+			size_type child = npos;
+			size_type next = npos;
+			size_type prev = npos;
+			bool in_heap = false;
+		};
+
+		std::vector<node> nodes_;
+		std::vector<size_type> pairs_;
+		size_type root_ = npos;
+
+		auto meld(size_type a, size_type b) noexcept -> size_type {
+			if (a == npos)
+				return b;
+			if (b == npos)
+				return a;
+			if (nodes_[b].key < nodes_[a].key)
+				std::swap(a, b);
+
+			// b becomes the first child of a
+			nodes_[b].prev = a;
+			nodes_[b].next = nodes_[a].child;
+			if (nodes_[a].child != npos)
+				nodes_[nodes_[a].child].prev = b;
+			nodes_[a].child = b;
+			nodes_[a].next = npos;
+			nodes_[a].prev = npos;
+			return a;
+		}
+
+		// Standard two pass merge: meld siblings pairwise left to right, then fold right to left
+		auto merge_pairs(size_type first) -> size_type {
+			pairs_.clear();
+			while (first != npos) {
+				auto const a = first;
+				auto const b = nodes_[a].next;
+				first = (b == npos) ? npos : nodes_[b].next;
+				nodes_[a].next = nodes_[a].prev = npos;
+				if (b != npos)
+					nodes_[b].next = nodes_[b].prev = npos;
+				pairs_.push_back(meld(a, b));
+			}
+
+			auto root = npos;
+			for (auto it = pairs_.rbegin(); it != pairs_.rend(); ++it) {
+				root = meld(*it, root);
+			}
+			return root;
+		}
+	};
+
+	// Radix heap for non-negative integer keys that are popped in non-decreasing order, as they are
+	// in Dijkstra's algorithm. Entries are bucketed by the highest bit in which their key differs
+	// from the last popped key, so a push is O(1) and every entry moves down at most once per bit.
+	template<std::integral Key>
+	class radix_heap {
+	public:
+		using size_type = std::size_t;
+
+		auto reset(size_type) -> void {
+			for (auto& bucket : buckets_) {
+				bucket.clear();
+			}
+			last_ = 0;
+			size_ = 0;
+		}
+
+		auto push(size_type item, Key key) -> void {
+			auto const k = static_cast<unsigned_key>(key);
+			buckets_[bucket_of(k)].emplace_back(k, item);
+			++size_;
+		}
+
+		auto pop() -> std::pair<Key, size_type> {
+			if (buckets_[0].empty()) {
+				auto i = size_type{1};
+				while (buckets_[i].empty())
+					++i;
+
+				// Every entry in the first non-empty bucket moves to a lower one once the smallest
+				// of them becomes the reference key
+				auto& bucket = buckets_[i];
+				last_ = std::min_element(bucket.begin(), bucket.end())->first;
+				for (auto const& entry : bucket) {
+					buckets_[bucket_of(entry.first)].push_back(entry);
+				}
+				bucket.clear();
+			}
+
+			auto top = buckets_[0].back();
+			buckets_[0].pop_back();
+			--size_;
+			return {static_cast<Key>(top.first), top.second};
+		}
+
+		[[nodiscard]] auto empty() const noexcept -> bool {
+			return size_ == 0;
+		}
+
+	private:
+		using unsigned_key = std::make_unsigned_t<Key>;
+		static constexpr auto bits = std::numeric_limits<unsigned_key>::digits;
+
+		std::vector<std::pair<unsigned_key, size_type>> buckets_[bits + 1];
+		unsigned_key last_ = 0;
+		size_type size_ = 0;
+
+		[[nodiscard]] auto bucket_of(unsigned_key key) const noexcept -> size_type {
+			return static_cast<size_type>(std::bit_width(static_cast<unsigned_key>(key ^ last_)));
+		}
+	};
+
+} // namespace gdwg
+
+#endif // GDWG_HEAPS_HPP
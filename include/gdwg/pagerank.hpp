@@ -0,0 +1,333 @@
+#ifndef GDWG_PAGERANK_HPP
+#define GDWG_PAGERANK_HPP
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <barrier>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+	template<typename N>
+	struct pagerank_options {
+		// Chance of following an edge rather than jumping
+		double damping = 0.85;
+		// Iteration stops once the scores move less than this in total (L1 norm)
+		double tolerance = 1e-6;
+		std::size_t max_iterations = 100;
+		// Where jumps land, as (node, weight) pairs. Weights are normalised and nodes left out get
+		// none. Empty means every node equally.
+		std::vector<std::pair<N, double>> personalization = {};
+		// Split edges out of a node in proportion to their weights, when E is arithmetic.
+		// Otherwise every edge gets the same share.
+		bool weighted = true;
+		// 0 means std::thread::hardware_concurrency()
+		std::size_t threads = 1;
+	};
+
+	// Scores found by gdwg::pagerank, by node value or by index in nodes(), which is the sorted
+	// node list of the graph. The scores add up to 1.
+	template<typename N>
+	class pagerank_result {
+	public:
+		using size_type = std::size_t;
+		static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+		pagerank_result(std::vector<N> nodes,
+		                std::vector<double> scores,
+		                size_type iterations,
+		                bool converged)
+		: nodes_(std::move(nodes))
+		, scores_(std::move(scores))
+		, iterations_{iterations}
+		, converged_{converged} {}
+
+		[[nodiscard]] auto score(N const& value) const -> double {
+			auto const index = index_of(value);
+			if (index == npos) {
+				throw std::runtime_error("Cannot call gdwg::pagerank_result<N>::score on a node that "
+				                         "doesn't exist in the graph");
+			}
+			return scores_[index];
+		}
+		[[nodiscard]] auto iterations() const noexcept -> size_type {
+			return iterations_;
+		}
+		// Whether the scores settled within the tolerance before max_iterations ran out
+		[[nodiscard]] auto converged() const noexcept -> bool {
+			return converged_;
+		}
+
+		[[nodiscard]] auto nodes() const noexcept -> std::span<N const> {
+			return nodes_;
+		}
+		[[nodiscard]] auto scores() const noexcept -> std::span<double const> {
+			return scores_;
+		}
+		[[nodiscard]] auto index_of(N const& value) const noexcept -> size_type {
+			auto it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			return (it != nodes_.end() && !(value < *it)) ? static_cast<size_type>(it - nodes_.begin())
+			                                              : npos;
+		}
+
+	private:
+		std::vector<N> nodes_;
+		std::vector<double> scores_;
+		size_type iterations_;
+		bool converged_;
+	};
+
+	namespace detail {
+		// Power iteration for PageRank, pulling along in-edges so that every score is written by
+		// one thread and nothing needs to be atomic. Each iteration first scales every score by
+		// the inverse of its node's out-weight, then each node sums what its in-edges bring. The
+		// sum is the sparse matrix-vector product; it runs on four accumulators so the additions
+		// don't wait on each other. Nodes without out-edges hand their score to the jump
+		// distribution.
+		class pagerank_iteration {
+		public:
+			using size_type = std::size_t;
+
+			// in_offsets and in_sources are the transposed graph. in_weights is empty for
+			// unweighted ranking, and inverse_out_weights is 0 for nodes without out-edges.
+			pagerank_iteration(std::span<size_type const> in_offsets,
+			                   std::span<size_type const> in_sources,
+			                   std::span<double const> in_weights,
+			                   std::vector<double> inverse_out_weights,
+			                   std::vector<double> jump)
+			: in_offsets_{in_offsets}
+			, in_sources_{in_sources}
+			, in_weights_{in_weights}
+			, inverse_out_weights_(std::move(inverse_out_weights))
+			, jump_(std::move(jump)) {}
+
+			auto run(double damping, double tolerance, size_type max_iterations, size_type threads)
+			   -> std::pair<std::vector<double>, size_type> {
+				auto const n = jump_.size();
+				damping_ = damping;
+				tolerance_ = tolerance;
+				max_iterations_ = max_iterations;
+				scores_ = jump_;
+				next_.assign(n, 0.0);
+				shares_.assign(n, 0.0);
+				iterations_ = 0;
+				converged_ = false;
+				done_ = max_iterations == 0;
+
+				// Blocks of nodes with about the same number of in-edges each
+				blocks_ = balanced_blocks(in_offsets_, threads);
+				dangling_.assign(threads, 0.0);
+				change_.assign(threads, 0.0);
+
+				auto shared = std::barrier(static_cast<std::ptrdiff_t>(threads),
+				                           [this]() noexcept { sum_dangling(); });
+				auto summed = std::barrier(static_cast<std::ptrdiff_t>(threads),
+				                           [this]() noexcept { end_iteration(); });
+				auto work = [&](size_type t) {
+					while (!done_) {
+						share(t);
+						shared.arrive_and_wait();
+						gather(t);
+						summed.arrive_and_wait();
+					}
+				};
+
+				{
+					auto helpers = std::vector<std::jthread>{};
+					helpers.reserve(threads - 1);
+					for (auto t = size_type{1}; t < threads; ++t)
+						helpers.emplace_back(work, t);
+					work(0);
+				}
+				return {std::move(scores_), iterations_};
+			}
+
+			[[nodiscard]] auto converged() const noexcept -> bool {
+				return converged_;
+			}
+
+		private:
+			std::span<size_type const> in_offsets_;
+			std::span<size_type const> in_sources_;
+			std::span<double const> in_weights_;
+			std::vector<double> inverse_out_weights_;
+			std::vector<double> jump_;
+
+			double damping_ = 0.0;
+			double tolerance_ = 0.0;
+			size_type max_iterations_ = 0;
+			std::vector<double> scores_;
+			std::vector<double> next_;
+			// Score sent along each unit of out-weight
+			std::vector<double> shares_;
+			std::vector<size_type> blocks_;
+			// Per thread partial sums, added up between the phases
+			std::vector<double> dangling_;
+			std::vector<double> change_;
+			double dangling_total_ = 0.0;
+			size_type iterations_ = 0;
+			bool converged_ = false;
+			bool done_ = false;
+
+			auto share(size_type t) noexcept -> void {
+				auto dangling = 0.0;
+				for (auto u = blocks_[t]; u < blocks_[t + 1]; ++u) {
+					shares_[u] = scores_[u] * inverse_out_weights_[u];
+					if (inverse_out_weights_[u] == 0.0)
+						dangling += scores_[u];
+				}
+				dangling_[t] = dangling;
+			}
+
+			auto gather(size_type t) noexcept -> void {
+				auto const base = 1.0 - damping_ + damping_ * dangling_total_;
+				auto change = 0.0;
+				for (auto v = blocks_[t]; v < blocks_[t + 1]; ++v) {
+					auto const incoming = in_weights_.empty()
+					                         ? sum_in(v, [](size_type) { return 1.0; })
+					                         : sum_in(v, [this](size_type e) { return in_weights_[e]; });
+					next_[v] = base * jump_[v] + damping_ * incoming;
+					change += std::abs(next_[v] - scores_[v]);
+				}
+				change_[t] = change;
+			}
+
+			template<typename Weight>
+			[[nodiscard]] auto sum_in(size_type v, Weight weight) const noexcept -> double {
+				auto const first = in_offsets_[v];
+				auto const last = in_offsets_[v + 1];
+				double sums[4] = {0.0, 0.0, 0.0, 0.0};
+				auto e = first;
+				for (; e + 4 <= last; e += 4) {
+					sums[0] += weight(e) * shares_[in_sources_[e]];
+					sums[1] += weight(e + 1) * shares_[in_sources_[e + 1]];
+					sums[2] += weight(e + 2) * shares_[in_sources_[e + 2]];
+					sums[3] += weight(e + 3) * shares_[in_sources_[e + 3]];
+				}
+				for (; e < last; ++e)
+					sums[0] += weight(e) * shares_[in_sources_[e]];
+				return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+			}
+
+			// Both run on one thread while the others wait at the barrier
+			auto sum_dangling() noexcept -> void {
+				dangling_total_ = 0.0;
+				for (auto const d : dangling_)
+					dangling_total_ += d;
+			}
+
+			auto end_iteration() noexcept -> void {
+				auto change = 0.0;
+				for (auto const c : change_)
+					change += c;
+				std::swap(scores_, next_);
+				++iterations_;
+				converged_ = change < tolerance_;
+				done_ = converged_ || iterations_ == max_iterations_;
+			}
+		};
+
+		template<typename N, typename E>
+		auto pagerank(csr_graph<N, E> const& g, pagerank_options<N> const& options)
+		   -> pagerank_result<N> {
+			if (!(options.damping >= 0.0 && options.damping <= 1.0)) {
+				throw std::runtime_error("Cannot call gdwg::pagerank with a damping factor outside "
+				                         "[0, 1]");
+			}
+			auto const n = g.node_count();
+			auto const weighted = arithmetic<E> && options.weighted;
+
+			auto jump = std::vector<double>(n, n == 0 ? 0.0 : 1.0 / static_cast<double>(n));
+			if (!options.personalization.empty()) {
+				std::fill(jump.begin(), jump.end(), 0.0);
+				auto total = 0.0;
+				for (auto const& [value, weight] : options.personalization) {
+					auto const index = g.index_of(value);
+					if (index == csr_graph<N, E>::npos || !(weight >= 0.0)) {
+						throw std::runtime_error("Cannot call gdwg::pagerank with a personalization "
+						                         "entry that isn't a node with a weight >= 0");
+					}
+					jump[index] += weight;
+					total += weight;
+				}
+				if (!(total > 0.0)) {
+					throw std::runtime_error("Cannot call gdwg::pagerank with personalization "
+					                         "weights that add up to 0");
+				}
+				for (auto& j : jump)
+					j /= total;
+			}
+
+			auto const reverse = g.transposed();
+			auto in_weights = std::vector<double>{};
+			auto inverse_out_weights = std::vector<double>(n, 0.0);
+			auto const offsets = g.offsets();
+			if constexpr (arithmetic<E>) {
+				if (weighted) {
+					auto const weights = reverse.edge_weights();
+					in_weights.reserve(weights.size());
+					for (auto const w : weights) {
+						if (w < E{0}) {
+							throw std::runtime_error("Cannot call gdwg::pagerank with negative edge "
+							                         "weights");
+						}
+						in_weights.push_back(static_cast<double>(w));
+					}
+					auto const out_weights = g.edge_weights();
+					for (auto u = std::size_t{0}; u < n; ++u) {
+						auto total = 0.0;
+						for (auto e = offsets[u]; e < offsets[u + 1]; ++e)
+							total += static_cast<double>(out_weights[e]);
+						inverse_out_weights[u] = total > 0.0 ? 1.0 / total : 0.0;
+					}
+				}
+			}
+			if (!weighted) {
+				for (auto u = std::size_t{0}; u < n; ++u) {
+					auto const degree = offsets[u + 1] - offsets[u];
+					inverse_out_weights[u] = degree > 0 ? 1.0 / static_cast<double>(degree) : 0.0;
+				}
+			}
+
+			auto const threads = worker_count(options.threads, n);
+
+			auto iteration = pagerank_iteration(reverse.offsets(),
+			                                    reverse.targets(),
+			                                    in_weights,
+			                                    std::move(inverse_out_weights),
+			                                    std::move(jump));
+			auto [scores, iterations] =
+			   iteration.run(options.damping, options.tolerance, options.max_iterations, threads);
+			return pagerank_result<N>(g.nodes(), std::move(scores), iterations, iteration.converged());
+		}
+	} // namespace detail
+
+	// PageRank by power iteration: the long run share of time a random walk spends at each node,
+	// when at every step it follows an edge out of its node with probability options.damping and
+	// otherwise jumps, by default to any node. Walks stuck at a node without out-edges jump too.
+	// Personalised PageRank jumps only to the nodes in options.personalization.
+	// The graph is converted to compressed-sparse-row form once, up front.
+	template<typename N, typename E>
+	auto pagerank(graph<N, E> const& g, pagerank_options<N> const& options = {})
+	   -> pagerank_result<N> {
+		return detail::pagerank(csr_graph<N, E>(g), options);
+	}
+
+	template<typename N, typename E>
+	auto pagerank(csr_graph<N, E> const& g, pagerank_options<N> const& options = {})
+	   -> pagerank_result<N> {
+		return detail::pagerank(g, options);
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_PAGERANK_HPP
@@ -0,0 +1,269 @@
+#ifndef GDWG_PARALLEL_BFS_HPP
+#define GDWG_PARALLEL_BFS_HPP
+
+#include "gdwg/csr_graph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+	namespace detail {
+		// Direction optimising breadth first search (Beamer, Asanovic and Patterson). While the
+		// frontier is small, each frontier node claims its unvisited dsts (top-down). Once the
+		// frontier grows to where the edges out of it outnumber those into unvisited nodes by
+		// alpha, each unvisited node instead looks for a parent in the frontier and stops at the
+		// first one (bottom-up), until the frontier shrinks below 1 / beta of the graph again.
+		// The threads stay up for the whole search and meet at a barrier after every level, where
+		// one of them swaps the frontiers and picks the next direction.
+		class parallel_bfs_search {
+		public:
+			using size_type = std::size_t;
+			static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+			parallel_bfs_search(std::span<size_type const> out_offsets,
+			                    std::span<size_type const> out_targets,
+			                    std::span<size_type const> in_offsets,
+			                    std::span<size_type const> in_sources)
+			: out_offsets_{out_offsets}
+			, out_targets_{out_targets}
+			, in_offsets_{in_offsets}
+			, in_sources_{in_sources}
+			, node_count_{out_offsets.size() - 1}
+			, word_count_{(node_count_ + word_bits - 1) / word_bits} {}
+
+			auto run(size_type src, size_type threads) -> std::vector<size_type> {
+				parents_.assign(node_count_, npos);
+				parents_[src] = src;
+				frontier_.assign(node_count_, 0);
+				next_.assign(node_count_, 0);
+				frontier_[0] = src;
+				frontier_size_ = 1;
+				frontier_bits_.assign(word_count_, 0);
+				next_bits_.assign(word_count_, 0);
+				bottom_up_ = false;
+				done_ = false;
+				unexplored_edges_ = in_sources_.size() - in_degree(src);
+
+				auto level_done = [this]() noexcept { end_level(); };
+				auto sync = std::barrier(static_cast<std::ptrdiff_t>(threads), level_done);
+				auto work = [&] {
+					auto found = std::vector<size_type>{};
+					while (true) {
+						if (bottom_up_)
+							bottom_up_step();
+						else
+							top_down_step(found);
+						sync.arrive_and_wait();
+						if (done_)
+							return;
+					}
+				};
+
+				{
+					auto helpers = std::vector<std::jthread>{};
+					helpers.reserve(threads - 1);
+					for (auto i = size_type{1}; i < threads; ++i)
+						helpers.emplace_back(work);
+					work();
+				}
+				return std::move(parents_);
+			}
+
+		private:
+			static constexpr size_type word_bits = 64;
+			static constexpr size_type alpha = 15;
+			static constexpr size_type beta = 18;
+			// Frontier nodes a thread takes at a time going top-down, and bitmap words going
+			// bottom-up. Whole words keep every next_bits_ word and parent written by one thread.
+			static constexpr size_type top_down_chunk = 64;
+			static constexpr size_type bottom_up_chunk = 16;
+
+			std::span<size_type const> out_offsets_;
+			std::span<size_type const> out_targets_;
+			std::span<size_type const> in_offsets_;
+			std::span<size_type const> in_sources_;
+			size_type node_count_;
+			size_type word_count_;
+
+			std::vector<size_type> parents_;
+			// Top-down frontiers are node lists, bottom-up ones bitmaps
+			std::vector<size_type> frontier_;
+			std::vector<size_type> next_;
+			size_type frontier_size_ = 0;
+			std::vector<std::uint64_t> frontier_bits_;
+			std::vector<std::uint64_t> next_bits_;
+			bool bottom_up_ = false;
+			bool done_ = false;
+			// Edges into nodes that haven't been reached, which a bottom-up step may have to check
+			size_type unexplored_edges_ = 0;
+
+			// Shared by the threads during a level and reset by end_level
+			std::atomic<size_type> next_chunk_ = 0;
+			std::atomic<size_type> next_size_ = 0;
+			std::atomic<size_type> found_out_edges_ = 0;
+			std::atomic<size_type> found_in_edges_ = 0;
+
+			[[nodiscard]] auto out_degree(size_type u) const noexcept -> size_type {
+				return out_offsets_[u + 1] - out_offsets_[u];
+			}
+			[[nodiscard]] auto in_degree(size_type u) const noexcept -> size_type {
+				return in_offsets_[u + 1] - in_offsets_[u];
+			}
+
+			auto top_down_step(std::vector<size_type>& found) -> void {
+				auto out_edges = size_type{0};
+				auto in_edges = size_type{0};
+				for (auto first = next_chunk_.fetch_add(top_down_chunk, std::memory_order_relaxed);
+				     first < frontier_size_;
+				     first = next_chunk_.fetch_add(top_down_chunk, std::memory_order_relaxed))
+				{
+					auto const last = std::min(first + top_down_chunk, frontier_size_);
+					for (auto i = first; i < last; ++i) {
+						auto const u = frontier_[i];
+						for (auto e = out_offsets_[u]; e < out_offsets_[u + 1]; ++e) {
+							auto const v = out_targets_[e];
+							auto parent = std::atomic_ref<size_type>(parents_[v]);
+							auto unvisited = npos;
+							if (parent.load(std::memory_order_relaxed) == npos
+							    && parent.compare_exchange_strong(unvisited,
+							                                      u,
+							                                      std::memory_order_relaxed))
+							{
+								found.push_back(v);
+								out_edges += out_degree(v);
+								in_edges += in_degree(v);
+							}
+						}
+					}
+				}
+
+				auto const pos = next_size_.fetch_add(found.size(), std::memory_order_relaxed);
+				std::copy(found.begin(), found.end(), next_.begin() + static_cast<std::ptrdiff_t>(pos));
+				found.clear();
+				found_out_edges_.fetch_add(out_edges, std::memory_order_relaxed);
+				found_in_edges_.fetch_add(in_edges, std::memory_order_relaxed);
+			}
+
+			auto bottom_up_step() -> void {
+				auto count = size_type{0};
+				auto out_edges = size_type{0};
+				auto in_edges = size_type{0};
+				for (auto first = next_chunk_.fetch_add(bottom_up_chunk, std::memory_order_relaxed);
+				     first < word_count_;
+				     first = next_chunk_.fetch_add(bottom_up_chunk, std::memory_order_relaxed))
+				{
+					auto const last = std::min(first + bottom_up_chunk, word_count_);
+					for (auto w = first; w < last; ++w) {
+						auto bits = std::uint64_t{0};
+						auto const end = std::min((w + 1) * word_bits, node_count_);
+						for (auto v = w * word_bits; v < end; ++v) {
+							if (parents_[v] != npos)
+								continue;
+							for (auto e = in_offsets_[v]; e < in_offsets_[v + 1]; ++e) {
+								auto const u = in_sources_[e];
+								if ((frontier_bits_[u / word_bits] >> (u % word_bits)) & 1) {
+									parents_[v] = u;
+									bits |= std::uint64_t{1} << (v % word_bits);
+									out_edges += out_degree(v);
+									in_edges += in_degree(v);
+									++count;
+									break;
+								}
+							}
+						}
+						next_bits_[w] = bits;
+					}
+				}
+
+				next_size_.fetch_add(count, std::memory_order_relaxed);
+				found_out_edges_.fetch_add(out_edges, std::memory_order_relaxed);
+				found_in_edges_.fetch_add(in_edges, std::memory_order_relaxed);
+			}
+
+			// Runs on one thread while the others wait at the barrier
+			auto end_level() noexcept -> void {
+				auto const found = next_size_.exchange(0, std::memory_order_relaxed);
+				auto const frontier_edges = found_out_edges_.exchange(0, std::memory_order_relaxed);
+				unexplored_edges_ -= found_in_edges_.exchange(0, std::memory_order_relaxed);
+				next_chunk_.store(0, std::memory_order_relaxed);
+				done_ = found == 0;
+				if (done_)
+					return;
+
+				// In either direction frontier_size_ counts the nodes in the frontier
+				auto const growing = found > frontier_size_;
+				frontier_size_ = found;
+				if (!bottom_up_) {
+					std::swap(frontier_, next_);
+					if (growing && frontier_edges > unexplored_edges_ / alpha) {
+						std::fill(frontier_bits_.begin(), frontier_bits_.end(), 0);
+						for (auto i = size_type{0}; i < frontier_size_; ++i) {
+							auto const v = frontier_[i];
+							frontier_bits_[v / word_bits] |= std::uint64_t{1} << (v % word_bits);
+						}
+						bottom_up_ = true;
+					}
+				}
+				else {
+					std::swap(frontier_bits_, next_bits_);
+					if (!growing && found < node_count_ / beta) {
+						frontier_size_ = 0;
+						for (auto w = size_type{0}; w < word_count_; ++w) {
+							for (auto bits = frontier_bits_[w]; bits != 0; bits &= bits - 1) {
+								frontier_[frontier_size_++] =
+								   w * word_bits + static_cast<size_type>(std::countr_zero(bits));
+							}
+						}
+						bottom_up_ = false;
+					}
+				}
+			}
+		};
+	} // namespace detail
+
+	// Multi-threaded breadth first search from src. Returns the parent of every node in a breadth
+	// first search tree, by node index in g; src is its own parent and nodes that weren't reached
+	// have csr_graph<N, E>::npos. Which parent a node gets may vary from run to run.
+	// reverse must be g.transposed(); pass it in to reuse it across searches. A thread count of 0
+	// means std::thread::hardware_concurrency().
+	template<typename N, typename E>
+	auto parallel_bfs(csr_graph<N, E> const& g,
+	                  csr_graph<N, E> const& reverse,
+	                  N const& src,
+	                  std::size_t threads = 0) -> std::vector<std::size_t> {
+		auto const src_index = g.index_of(src);
+		if (src_index == csr_graph<N, E>::npos) {
+			throw std::runtime_error("Cannot call gdwg::parallel_bfs if src doesn't exist in the "
+			                         "graph");
+		}
+		if (reverse.node_count() != g.node_count() || reverse.edge_count() != g.edge_count()) {
+			throw std::runtime_error("Cannot call gdwg::parallel_bfs if reverse isn't the "
+			                         "transposed graph");
+		}
+
+		threads = detail::worker_count(threads, g.node_count());
+		auto search =
+		   detail::parallel_bfs_search(g.offsets(), g.targets(), reverse.offsets(), reverse.targets());
+		return search.run(src_index, threads);
+	}
+
+	template<typename N, typename E>
+	auto parallel_bfs(csr_graph<N, E> const& g, N const& src, std::size_t threads = 0)
+	   -> std::vector<std::size_t> {
+		return parallel_bfs(g, g.transposed(), src, threads);
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_PARALLEL_BFS_HPP
@@ -0,0 +1,636 @@
+#ifndef GDWG_SHORTEST_PATHS_HPP
+#define GDWG_SHORTEST_PATHS_HPP
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/graph.hpp"
+#include "gdwg/heaps.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+	// Shortest path tree found by gdwg::shortest_paths.
+	// Nodes are addressed either by value or by their index in nodes(), which is the sorted node
+	// list of the graph that was searched. Only nodes that were reached have a distance; when the
+	// search stopped early at a target, that is every node no further away than the target.
+	template<typename N, typename E>
+	class shortest_paths_result {
+	public:
+		using size_type = std::size_t;
+		static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+		shortest_paths_result(std::vector<N> nodes,
+		                      size_type source,
+		                      std::vector<E> distances,
+		                      std::vector<size_type> predecessors,
+		                      std::vector<bool> reached)
+		: nodes_(std::move(nodes))
+		, distances_(std::move(distances))
+		, predecessors_(std::move(predecessors))
+		, reached_(std::move(reached))
+		, source_{source} {}
+
+		[[nodiscard]] auto source() const noexcept -> N const& {
+			return nodes_[source_];
+		}
+
+		[[nodiscard]] auto reached(N const& value) const noexcept -> bool {
+			auto index = index_of(value);
+			return index != npos && reached_[index];
+		}
+
+		[[nodiscard]] auto distance(N const& value) const -> E {
+			return distances_[reached_index(value, "distance")];
+		}
+
+		// The node before value on a shortest path, or nothing for the source
+		[[nodiscard]] auto predecessor(N const& value) const -> std::optional<N> {
+			auto pred = predecessors_[reached_index(value, "predecessor")];
+			return pred == npos ? std::nullopt : std::optional<N>(nodes_[pred]);
+		}
+
+		// Nodes on a shortest path from the source to value, both included. Empty if value wasn't
+		// reached.
+		[[nodiscard]] auto path_to(N const& value) const -> std::vector<N> {
+			auto path = std::vector<N>{};
+			auto index = index_of(value);
+			if (index == npos || !reached_[index])
+				return path;
+
+			for (; index != npos; index = predecessors_[index]) {
+				path.push_back(nodes_[index]);
+			}
+			std::reverse(path.begin(), path.end());
+			return path;
+		}
+
+		[[nodiscard]] auto nodes() const noexcept -> std::span<N const> {
+			return nodes_;
+		}
+		[[nodiscard]] auto index_of(N const& value) const noexcept -> size_type {
+			auto it = std::lower_bound(nodes_.begin(), nodes_.end(), value);
+			return (it != nodes_.end() && !(value < *it)) ? static_cast<size_type>(it - nodes_.begin())
+			                                              : npos;
+		}
+		[[nodiscard]] auto reached(size_type index) const noexcept -> bool {
+			return reached_[index];
+		}
+		// Distances and predecessor indices by node index, only meaningful for reached nodes
+		[[nodiscard]] auto distances() const noexcept -> std::span<E const> {
+			return distances_;
+		}
+		[[nodiscard]] auto predecessors() const noexcept -> std::span<size_type const> {
+			return predecessors_;
+		}
+
+	private:
+		std::vector<N> nodes_;
+		std::vector<E> distances_;
+		std::vector<size_type> predecessors_;
+		std::vector<bool> reached_;
+		size_type source_;
+
+		[[nodiscard]] auto reached_index(N const& value, char const* function) const -> size_type {
+			auto index = index_of(value);
+			if (index == npos || !reached_[index]) {
+				throw std::runtime_error(std::string("Cannot call gdwg::shortest_paths_result<N, E>::")
+				                         + function + " on a node that wasn't reached");
+			}
+			return index;
+		}
+	};
+
+	// Path found by gdwg::shortest_path between one pair of nodes
+	template<typename N, typename E>
+	class shortest_path_result {
+	public:
+		using size_type = std::size_t;
+
+		shortest_path_result(std::vector<N> path, E distance, size_type settled)
+		: path_(std::move(path))
+		, distance_(std::move(distance))
+		, settled_{settled} {}
+
+		explicit shortest_path_result(size_type settled)
+		: settled_{settled} {}
+
+		[[nodiscard]] auto found() const noexcept -> bool {
+			return distance_.has_value();
+		}
+
+		[[nodiscard]] auto distance() const -> E {
+			if (!distance_) {
+				throw std::runtime_error("Cannot call gdwg::shortest_path_result<N, E>::distance when "
+				                         "there is no path");
+			}
+			return *distance_;
+		}
+
+		// Nodes on the path from src to dst, both included. Empty if there is no path.
+		[[nodiscard]] auto path() const noexcept -> std::vector<N> const& {
+			return path_;
+		}
+
+		// How many nodes the search settled, counting both directions of a bidirectional search
+		[[nodiscard]] auto settled() const noexcept -> size_type {
+			return settled_;
+		}
+
+	private:
+		std::vector<N> path_;
+		std::optional<E> distance_;
+		size_type settled_;
+	};
+
+	namespace detail {
+		template<typename E>
+		struct dijkstra_state {
+			std::vector<E> distances;
+			std::vector<std::size_t> predecessors;
+			std::vector<bool> settled;
+		};
+
+		// Dijkstra's algorithm over dense node indices. for_each_edge(u, f) calls f(v, weight) for
+		// every edge out of node u. The search stops once target is settled, unless target is npos.
+		template<template<typename> class Heap, typename E, typename ForEachEdge>
+		auto dijkstra(std::size_t node_count,
+		              std::size_t source,
+		              std::size_t target,
+		              ForEachEdge&& for_each_edge) -> dijkstra_state<E> {
+			using size_type = std::size_t;
+			constexpr auto npos = std::numeric_limits<size_type>::max();
+
+			auto state = dijkstra_state<E>{std::vector<E>(node_count),
+			                               std::vector<size_type>(node_count, npos),
+			                               std::vector<bool>(node_count, false)};
+			auto& dist = state.distances;
+			auto& pred = state.predecessors;
+			auto& settled = state.settled;
+			// Nodes that have a tentative distance, settled or not
+			auto seen = std::vector<bool>(node_count, false);
+
+			auto heap = Heap<E>{};
+			heap.reset(node_count);
+			dist[source] = E{};
+			seen[source] = true;
+			heap.push(source, E{});
+
+			while (!heap.empty()) {
+				auto const [d, u] = heap.pop();
+				if (settled[u] || dist[u] < d)
+					continue;
+				settled[u] = true;
+				if (u == target)
+					break;
+
+				for_each_edge(u, [&](size_type v, E const& weight) {
+					if (weight < E{}) {
+						throw std::runtime_error("Cannot call gdwg::shortest_paths on a graph with "
+						                         "negative weights");
+					}
+					auto const candidate = static_cast<E>(d + weight);
+					if (!settled[v] && (!seen[v] || candidate < dist[v])) {
+						seen[v] = true;
+						dist[v] = candidate;
+						pred[v] = u;
+						heap.push(v, candidate);
+					}
+				});
+			}
+
+			// Only settled nodes count as reached, so predecessor chains never pass a tentative node
+			for (auto v = size_type{0}; v < node_count; ++v) {
+				if (!settled[v])
+					pred[v] = npos;
+			}
+			return state;
+		}
+
+		template<typename N, typename E>
+		auto make_result(std::vector<N> nodes, std::size_t source, dijkstra_state<E> state)
+		   -> shortest_paths_result<N, E> {
+			return shortest_paths_result<N, E>(std::move(nodes),
+			                                   source,
+			                                   std::move(state.distances),
+			                                   std::move(state.predecessors),
+			                                   std::move(state.settled));
+		}
+
+		template<typename N>
+		auto find_endpoints(std::vector<N> const& nodes,
+		                    N const& src,
+		                    N const* dst,
+		                    char const* message = "Cannot call gdwg::shortest_paths if src or dst "
+		                                          "node don't exist in the graph")
+		   -> std::pair<std::size_t, std::size_t> {
+			constexpr auto npos = std::numeric_limits<std::size_t>::max();
+			auto index_of = [&](N const& value) {
+				auto it = std::lower_bound(nodes.begin(), nodes.end(), value);
+				return (it != nodes.end() && !(value < *it))
+				          ? static_cast<std::size_t>(it - nodes.begin())
+				          : npos;
+			};
+
+			auto const src_index = index_of(src);
+			auto const dst_index = dst ? index_of(*dst) : npos;
+			if (src_index == npos || (dst && dst_index == npos))
+				throw std::runtime_error(message);
+			return {src_index, dst_index};
+		}
+
+		template<template<typename> class Heap, typename N, typename E>
+		auto shortest_paths(graph<N, E> const& g, N const& src, N const* dst)
+		   -> shortest_paths_result<N, E> {
+			auto nodes = g.nodes();
+			auto const [src_index, dst_index] = find_endpoints(nodes, src, dst);
+
+			auto for_each_edge = [&](std::size_t u, auto&& relax) {
+				for (auto const& [to, weight] : g.out_edges(nodes[u])) {
+					auto const v = std::lower_bound(nodes.begin(), nodes.end(), to) - nodes.begin();
+					relax(static_cast<std::size_t>(v), weight);
+				}
+			};
+			auto state = dijkstra<Heap, E>(nodes.size(), src_index, dst_index, for_each_edge);
+			return make_result(std::move(nodes), src_index, std::move(state));
+		}
+
+		template<template<typename> class Heap, typename N, typename E>
+		auto shortest_paths(csr_graph<N, E> const& g, N const& src, N const* dst)
+		   -> shortest_paths_result<N, E> {
+			auto nodes = g.nodes();
+			auto const [src_index, dst_index] = find_endpoints(nodes, src, dst);
+
+			auto const offsets = g.offsets();
+			auto const targets = g.targets();
+			auto const weights = g.edge_weights();
+			auto for_each_edge = [&](std::size_t u, auto&& relax) {
+				for (auto e = offsets[u]; e < offsets[u + 1]; ++e) {
+					relax(targets[e], weights[e]);
+				}
+			};
+			auto state = dijkstra<Heap, E>(nodes.size(), src_index, dst_index, for_each_edge);
+			return make_result(std::move(nodes), src_index, std::move(state));
+		}
+
+		template<typename E>
+		struct path_state {
+			// Node indices from source to target, empty if there is no path
+			std::vector<std::size_t> path;
+			E distance{};
+			std::size_t settled = 0;
+		};
+
+		// One side of a bidirectional search: Dijkstra from its start along out-edges for the
+		// forward search, or along in-edges for the backward one
+		template<template<typename> class Heap, typename E>
+		struct search_side {
+			std::vector<E> dist;
+			// The node before each one on the way from start, whichever way the edges point
+			std::vector<std::size_t> pred;
+			std::vector<bool> seen;
+			std::vector<bool> settled;
+			Heap<E> heap;
+			// The last distance settled, which bounds every distance still in the heap
+			E radius{};
+
+			search_side(std::size_t node_count, std::size_t start)
+			: dist(node_count)
+			, pred(node_count, std::numeric_limits<std::size_t>::max())
+			, seen(node_count, false)
+			, settled(node_count, false) {
+				heap.reset(node_count);
+				dist[start] = E{};
+				seen[start] = true;
+				heap.push(start, E{});
+			}
+		};
+
+		// Bidirectional Dijkstra: one search forward from source and one backward from target,
+		// each stepping the side that has settled less distance so far. Every edge either search
+		// relaxes towards a node the other has seen closes a candidate path. Once the two radii
+		// add up to the best candidate, no path through unsettled nodes can beat it.
+		// for_each_out_edge(u, f) and for_each_in_edge(v, f) call f(w, weight) for every edge
+		// u -> w and w -> v respectively.
+		template<template<typename> class Heap,
+		         typename E,
+		         typename ForEachOutEdge,
+		         typename ForEachInEdge>
+		auto bidirectional_dijkstra(std::size_t node_count,
+		                            std::size_t source,
+		                            std::size_t target,
+		                            ForEachOutEdge&& for_each_out_edge,
+		                            ForEachInEdge&& for_each_in_edge) -> path_state<E> {
+			using size_type = std::size_t;
+			constexpr auto npos = std::numeric_limits<size_type>::max();
+
+			auto state = path_state<E>{};
+			if (source == target) {
+				state.path.push_back(source);
+				return state;
+			}
+
+			auto forward = search_side<Heap, E>(node_count, source);
+			auto backward = search_side<Heap, E>(node_count, target);
+			auto best = std::optional<E>{};
+			// The edge where the best path crosses from the forward search to the backward one
+			auto meet_from = npos;
+			auto meet_to = npos;
+
+			while (!forward.heap.empty() && !backward.heap.empty()) {
+				auto const is_forward = !(backward.radius < forward.radius);
+				auto& here = is_forward ? forward : backward;
+				auto& there = is_forward ? backward : forward;
+
+				auto const [d, u] = here.heap.pop();
+				if (here.settled[u] || here.dist[u] < d)
+					continue;
+				if (best && !(d + there.radius < *best))
+					break;
+				here.settled[u] = true;
+				here.radius = d;
+				++state.settled;
+
+				auto relax = [&](size_type v, E const& weight) {
+					if (weight < E{}) {
+						throw std::runtime_error("Cannot call gdwg::shortest_path on a graph with "
+						                         "negative weights");
+					}
+					auto const candidate = static_cast<E>(d + weight);
+					if (!here.settled[v] && (!here.seen[v] || candidate < here.dist[v])) {
+						here.seen[v] = true;
+						here.dist[v] = candidate;
+						here.pred[v] = u;
+						here.heap.push(v, candidate);
+					}
+					if (there.seen[v]) {
+						auto const through = static_cast<E>(candidate + there.dist[v]);
+						if (!best || through < *best) {
+							best = through;
+							meet_from = is_forward ? u : v;
+							meet_to = is_forward ? v : u;
+						}
+					}
+				};
+				if (is_forward)
+					for_each_out_edge(u, relax);
+				else
+					for_each_in_edge(u, relax);
+			}
+			if (!best)
+				return state;
+
+			for (auto v = meet_from; v != npos; v = forward.pred[v])
+				state.path.push_back(v);
+			std::reverse(state.path.begin(), state.path.end());
+			for (auto v = meet_to; v != npos; v = backward.pred[v])
+				state.path.push_back(v);
+			state.distance = *best;
+			return state;
+		}
+
+		// A* from source alone: nodes come off the heap by distance plus estimate(v), a lower
+		// bound on the distance from v to target. A node can be settled again if it is later
+		// reached by a shorter path, which only happens when the estimate isn't consistent, so the
+		// first path to target is the shortest as long as the estimate never overshoots.
+		template<template<typename> class Heap, typename E, typename ForEachEdge, typename Estimate>
+		auto a_star(std::size_t node_count,
+		            std::size_t source,
+		            std::size_t target,
+		            ForEachEdge&& for_each_edge,
+		            Estimate&& estimate) -> path_state<E> {
+			using size_type = std::size_t;
+			constexpr auto npos = std::numeric_limits<size_type>::max();
+
+			auto state = path_state<E>{};
+			auto dist = std::vector<E>(node_count);
+			auto pred = std::vector<size_type>(node_count, npos);
+			auto seen = std::vector<bool>(node_count, false);
+			// Worked out once, when a node is first seen
+			auto estimates = std::vector<E>(node_count);
+
+			auto heap = Heap<E>{};
+			heap.reset(node_count);
+			seen[source] = true;
+			estimates[source] = static_cast<E>(estimate(source));
+			heap.push(source, estimates[source]);
+
+			while (!heap.empty()) {
+				auto const [key, u] = heap.pop();
+				if (static_cast<E>(dist[u] + estimates[u]) < key)
+					continue;
+				++state.settled;
+				if (u == target) {
+					for (auto v = target; v != npos; v = pred[v])
+						state.path.push_back(v);
+					std::reverse(state.path.begin(), state.path.end());
+					state.distance = dist[target];
+					return state;
+				}
+
+				for_each_edge(u, [&](size_type v, E const& weight) {
+					if (weight < E{}) {
+						throw std::runtime_error("Cannot call gdwg::shortest_path on a graph with "
+						                         "negative weights");
+					}
+					auto const candidate = static_cast<E>(dist[u] + weight);
+					if (seen[v] && !(candidate < dist[v]))
+						return;
+					if (!seen[v]) {
+						seen[v] = true;
+						estimates[v] = static_cast<E>(estimate(v));
+					}
+					dist[v] = candidate;
+					pred[v] = u;
+					heap.push(v, static_cast<E>(candidate + estimates[v]));
+				});
+			}
+			return state;
+		}
+
+		// node(v) is the node with index v
+		template<typename N, typename E, typename NodeOf>
+		auto to_path_result(path_state<E> const& state, NodeOf&& node) -> shortest_path_result<N, E> {
+			if (state.path.empty())
+				return shortest_path_result<N, E>(state.settled);
+
+			auto path = std::vector<N>{};
+			path.reserve(state.path.size());
+			for (auto const v : state.path)
+				path.push_back(node(v));
+			return shortest_path_result<N, E>(std::move(path), state.distance, state.settled);
+		}
+
+		inline constexpr char const* missing_endpoint =
+		   "Cannot call gdwg::shortest_path if src or dst node don't exist in the graph";
+
+		// Searches g from src to dst by dense index. Weights are read where g stores them, and the
+		// backward search follows the reverse adjacency g keeps, through in_edges. estimate is
+		// nullptr for bidirectional Dijkstra.
+		template<template<typename> class Heap, typename N, typename E, typename Estimate>
+		auto shortest_path(graph<N, E> const& g, N const& src, N const& dst, Estimate const& estimate)
+		   -> shortest_path_result<N, E> {
+			auto const nodes = g.nodes();
+			auto const [source, target] = find_endpoints(nodes, src, &dst, missing_endpoint);
+			auto index_of = [&](N const& value) {
+				return static_cast<std::size_t>(std::lower_bound(nodes.begin(), nodes.end(), value)
+				                                - nodes.begin());
+			};
+			auto node = [&](std::size_t v) -> N const& { return nodes[v]; };
+
+			auto for_each_out_edge = [&](std::size_t u, auto&& relax) {
+				for (auto const& [to, weight] : g.out_edges(nodes[u]))
+					relax(index_of(to), weight);
+			};
+			if constexpr (std::is_null_pointer_v<Estimate>) {
+				auto for_each_in_edge = [&](std::size_t v, auto&& relax) {
+					for (auto const& [from, weight] : g.in_edges(nodes[v]))
+						relax(index_of(from), weight);
+				};
+				auto const state = bidirectional_dijkstra<Heap, E>(nodes.size(),
+				                                                   source,
+				                                                   target,
+				                                                   for_each_out_edge,
+				                                                   for_each_in_edge);
+				return to_path_result<N>(state, node);
+			}
+			else {
+				auto const state = a_star<Heap, E>(nodes.size(),
+				                                   source,
+				                                   target,
+				                                   for_each_out_edge,
+				                                   [&](std::size_t v) { return estimate(nodes[v]); });
+				return to_path_result<N>(state, node);
+			}
+		}
+
+		// reverse is g.transposed(); only bidirectional Dijkstra, where estimate is nullptr, uses it
+		template<template<typename> class Heap, typename N, typename E, typename Estimate>
+		auto shortest_path(csr_graph<N, E> const& g,
+		                   csr_graph<N, E> const* reverse,
+		                   N const& src,
+		                   N const& dst,
+		                   Estimate const& estimate) -> shortest_path_result<N, E> {
+			auto const source = g.index_of(src);
+			auto const target = g.index_of(dst);
+			if (source == g.npos || target == g.npos)
+				throw std::runtime_error(missing_endpoint);
+
+			auto edges_of = [](csr_graph<N, E> const& of) {
+				return [offsets = of.offsets(), targets = of.targets(), weights = of.edge_weights()](
+				          std::size_t u,
+				          auto&& relax) {
+					for (auto e = offsets[u]; e < offsets[u + 1]; ++e)
+						relax(targets[e], weights[e]);
+				};
+			};
+			auto node = [&](std::size_t v) -> N const& { return g.node(v); };
+			if constexpr (std::is_null_pointer_v<Estimate>) {
+				auto const state = bidirectional_dijkstra<Heap, E>(g.node_count(),
+				                                                   source,
+				                                                   target,
+				                                                   edges_of(g),
+				                                                   edges_of(*reverse));
+				return to_path_result<N>(state, node);
+			}
+			else {
+				auto const state = a_star<Heap, E>(g.node_count(),
+				                                   source,
+				                                   target,
+				                                   edges_of(g),
+				                                   [&](std::size_t v) { return estimate(g.node(v)); });
+				return to_path_result<N>(state, node);
+			}
+		}
+	} // namespace detail
+
+	// Single source shortest paths with Dijkstra's algorithm. Weights must not be negative.
+	// Heap picks the priority queue from heaps.hpp; radix_heap needs integral weights.
+	template<template<typename> class Heap = binary_heap, typename N, typename E>
+	requires arithmetic<E>
+	auto shortest_paths(graph<N, E> const& g, N const& src) -> shortest_paths_result<N, E> {
+		return detail::shortest_paths<Heap>(g, src, static_cast<N const*>(nullptr));
+	}
+
+	// As above, but stops as soon as the distance to dst is known
+	template<template<typename> class Heap = binary_heap, typename N, typename E>
+	requires arithmetic<E>
+	auto shortest_paths(graph<N, E> const& g, N const& src, N const& dst)
+	   -> shortest_paths_result<N, E> {
+		return detail::shortest_paths<Heap>(g, src, &dst);
+	}
+
+	template<template<typename> class Heap = binary_heap, typename N, typename E>
+	requires arithmetic<E>
+	auto shortest_paths(csr_graph<N, E> const& g, N const& src) -> shortest_paths_result<N, E> {
+		return detail::shortest_paths<Heap>(g, src, static_cast<N const*>(nullptr));
+	}
+
+	template<template<typename> class Heap = binary_heap, typename N, typename E>
+	requires arithmetic<E>
+	auto shortest_paths(csr_graph<N, E> const& g, N const& src, N const& dst)
+	   -> shortest_paths_result<N, E> {
+		return detail::shortest_paths<Heap>(g, src, &dst);
+	}
+
+	// Shortest path from src to dst alone, with bidirectional Dijkstra: a search forward from src
+	// and one backward from dst meet in the middle, which on road-like graphs settles a fraction
+	// of the nodes a search from src alone does. Weights must not be negative.
+	template<template<typename> class Heap = binary_heap, typename N, typename E>
+	requires arithmetic<E>
+	auto shortest_path(graph<N, E> const& g, N const& src, N const& dst)
+	   -> shortest_path_result<N, E> {
+		return detail::shortest_path<Heap>(g, src, dst, nullptr);
+	}
+
+	// As above, but with A* from src: heuristic(v) must never overestimate the distance from v to
+	// dst, such as the straight line distance between coordinates. The closer it comes, the fewer
+	// nodes are settled.
+	template<template<typename> class Heap = binary_heap, typename N, typename E, typename Heuristic>
+	requires arithmetic<E> && std::is_invocable_r_v<E, Heuristic const&, N const&>
+	auto shortest_path(graph<N, E> const& g, N const& src, N const& dst, Heuristic const& heuristic)
+	   -> shortest_path_result<N, E> {
+		return detail::shortest_path<Heap>(g, src, dst, heuristic);
+	}
+
+	// csr_graph keeps no reverse adjacency, so bidirectional search transposes g first. That
+	// takes as long as a pass over the edges, so for many queries on one graph, transpose it once
+	// and pass reverse = g.transposed().
+	template<template<typename> class Heap = binary_heap, typename N, typename E>
+	requires arithmetic<E>
+	auto shortest_path(csr_graph<N, E> const& g, N const& src, N const& dst)
+	   -> shortest_path_result<N, E> {
+		auto const reverse = g.transposed();
+		return detail::shortest_path<Heap>(g, &reverse, src, dst, nullptr);
+	}
+
+	template<template<typename> class Heap = binary_heap, typename N, typename E>
+	requires arithmetic<E>
+	auto shortest_path(csr_graph<N, E> const& g,
+	                   csr_graph<N, E> const& reverse,
+	                   N const& src,
+	                   N const& dst) -> shortest_path_result<N, E> {
+		return detail::shortest_path<Heap>(g, &reverse, src, dst, nullptr);
+	}
+
+	template<template<typename> class Heap = binary_heap, typename N, typename E, typename Heuristic>
+	requires arithmetic<E> && std::is_invocable_r_v<E, Heuristic const&, N const&>
+	auto shortest_path(csr_graph<N, E> const& g,
+	                   N const& src,
+	                   N const& dst,
+	                   Heuristic const& heuristic) -> shortest_path_result<N, E> {
+		auto const no_reverse = static_cast<csr_graph<N, E> const*>(nullptr);
+		return detail::shortest_path<Heap>(g, no_reverse, src, dst, heuristic);
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_SHORTEST_PATHS_HPP
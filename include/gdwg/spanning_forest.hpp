@@ -0,0 +1,208 @@
+#ifndef GDWG_SPANNING_FOREST_HPP
+#define GDWG_SPANNING_FOREST_HPP
+
+#include "gdwg/components.hpp"
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/graph.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace gdwg {
+
+	// Picks the algorithm for minimum_spanning_forest. Kruskal's sorts the edges once and suits
+	// sparse graphs; Prim's grows one tree at a time in O(nodes^2 + edges) without a heap, which
+	// wins once most pairs of nodes are connected.
+	struct kruskal_t {
+		explicit kruskal_t() = default;
+	};
+	inline constexpr kruskal_t kruskal{};
+
+	struct prim_t {
+		explicit prim_t() = default;
+	};
+	inline constexpr prim_t prim{};
+
+	template<typename T>
+	concept spanning_forest_algorithm = std::same_as<T, kruskal_t> || std::same_as<T, prim_t>;
+
+	namespace detail {
+		// An edge by the positions of its nodes in the graph's sorted node list
+		template<typename E>
+		struct indexed_edge {
+			std::size_t from;
+			std::size_t to;
+			E weight;
+		};
+
+		// The cheapest edge between each pair of connected nodes, in either direction, ignoring
+		// self loops. Every bucket's weights are sorted, so the cheapest is the first. Edges come
+		// grouped by src with their dsts in order, so when an edge leads back to an earlier src the
+		// edge the other way, if any, is found by binary search and the lighter of the two kept.
+		// Graphs that store every connection both ways then hand the sort half as many edges.
+		template<typename N, typename E>
+		auto lightest_edges(graph<N, E> const& g, std::span<N const> nodes)
+		   -> std::vector<indexed_edge<E>> {
+			auto edges = std::vector<indexed_edge<E>>{};
+			// Where each src's edges start in edges, and the dst they were added with, which keeps
+			// them searchable when the lighter reverse edge replaces one
+			auto starts = std::vector<std::size_t>(nodes.size() + 1, 0);
+			auto dsts = std::vector<std::size_t>{};
+			auto started = std::size_t{0};
+			auto previous = std::pair<std::size_t, std::size_t>(0, 0);
+
+			for_each_indexed_edge(g, nodes, [&](std::size_t src, std::size_t dst, auto const& edge) {
+				if (src == dst || previous == std::pair(src, dst))
+					return;
+				previous = {src, dst};
+				while (started < src)
+					starts[++started] = edges.size();
+
+				if (dst < src) {
+					auto const first = dsts.begin() + static_cast<std::ptrdiff_t>(starts[dst]);
+					auto const last = dsts.begin() + static_cast<std::ptrdiff_t>(starts[dst + 1]);
+					auto const it = std::lower_bound(first, last, src);
+					if (it != last && *it == src) {
+						auto& reverse = edges[static_cast<std::size_t>(it - dsts.begin())];
+						if (edge.weight < reverse.weight)
+							reverse = indexed_edge<E>{src, dst, edge.weight};
+						return;
+					}
+				}
+				edges.push_back(indexed_edge<E>{src, dst, edge.weight});
+				dsts.push_back(dst);
+			});
+			return edges;
+		}
+
+		template<typename E>
+		auto spanning_forest(kruskal_t, std::size_t node_count, std::vector<indexed_edge<E>> edges)
+		   -> std::vector<indexed_edge<E>> {
+			// Equal weights keep the graph's (src, dst) order
+			std::sort(edges.begin(), edges.end(), [](auto const& a, auto const& b) {
+				if (a.weight < b.weight || b.weight < a.weight)
+					return a.weight < b.weight;
+				return std::pair(a.from, a.to) < std::pair(b.from, b.to);
+			});
+
+			auto sets = disjoint_sets(node_count);
+			auto forest = std::vector<indexed_edge<E>>{};
+			for (auto const& edge : edges) {
+				if (sets.unite(edge.from, edge.to)) {
+					forest.push_back(edge);
+					if (forest.size() + 1 == node_count)
+						break;
+				}
+			}
+			return forest;
+		}
+
+		template<typename E>
+		auto spanning_forest(prim_t, std::size_t node_count, std::vector<indexed_edge<E>> edges)
+		   -> std::vector<indexed_edge<E>> {
+			constexpr auto none = std::numeric_limits<std::size_t>::max();
+
+			// Every edge from both of its ends
+			auto offsets = std::vector<std::size_t>(node_count + 1, 0);
+			for (auto const& edge : edges) {
+				++offsets[edge.from + 1];
+				++offsets[edge.to + 1];
+			}
+			std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+			auto incident = std::vector<std::size_t>(offsets.back());
+			auto next = std::vector<std::size_t>(offsets.begin(), offsets.end() - 1);
+			for (auto e = std::size_t{0}; e < edges.size(); ++e) {
+				incident[next[edges[e].from]++] = e;
+				incident[next[edges[e].to]++] = e;
+			}
+
+			// The cheapest edge joining each node outside the tree to it, if any
+			auto best = std::vector<std::size_t>(node_count, none);
+			auto in_tree = std::vector<bool>(node_count, false);
+			auto forest = std::vector<indexed_edge<E>>{};
+			auto root = std::size_t{0};
+			for (auto added = std::size_t{0}; added < node_count; ++added) {
+				auto u = none;
+				for (auto v = std::size_t{0}; v < node_count; ++v) {
+					if (!in_tree[v] && best[v] != none
+					    && (u == none || edges[best[v]].weight < edges[best[u]].weight))
+					{
+						u = v;
+					}
+				}
+				if (u == none) {
+					// Nothing left reaches the tree, so a new one starts
+					while (in_tree[root])
+						++root;
+					u = root;
+				}
+				else {
+					forest.push_back(edges[best[u]]);
+				}
+
+				in_tree[u] = true;
+				for (auto i = offsets[u]; i < offsets[u + 1]; ++i) {
+					auto const e = incident[i];
+					auto const v = edges[e].from == u ? edges[e].to : edges[e].from;
+					if (!in_tree[v] && (best[v] == none || edges[e].weight < edges[best[v]].weight))
+						best[v] = e;
+				}
+			}
+			return forest;
+		}
+
+		template<typename N, typename E>
+		auto to_values(std::span<N const> nodes, std::vector<indexed_edge<E>> forest)
+		   -> std::vector<graph_value_type<N, E>> {
+			std::sort(forest.begin(), forest.end(), [](auto const& a, auto const& b) {
+				return std::pair(a.from, a.to) < std::pair(b.from, b.to);
+			});
+			auto result = std::vector<graph_value_type<N, E>>{};
+			result.reserve(forest.size());
+			for (auto const& edge : forest)
+				result.emplace_back(nodes[edge.from], nodes[edge.to], edge.weight);
+			return result;
+		}
+
+		template<typename N, typename E, typename Algorithm>
+		auto minimum_spanning_edges(graph<N, E> const& g,
+		                            std::vector<N> const& nodes,
+		                            Algorithm algorithm) -> std::vector<graph_value_type<N, E>> {
+			auto const span = std::span<N const>(nodes);
+			auto forest = spanning_forest(algorithm, nodes.size(), lightest_edges(g, span));
+			return to_values(span, std::move(forest));
+		}
+	} // namespace detail
+
+	// A minimum spanning forest of g with every edge taken as undirected: one minimum spanning
+	// tree for each weakly connected component. Each edge keeps the direction it has in g, and
+	// of several edges between the same two nodes only the lightest can be picked. Returned in
+	// the graph's (src, dst) order.
+	template<typename N, typename E, spanning_forest_algorithm Algorithm = kruskal_t>
+	requires arithmetic<E>
+	auto minimum_spanning_edges(graph<N, E> const& g, Algorithm algorithm = kruskal)
+	   -> std::vector<graph_value_type<N, E>> {
+		return detail::minimum_spanning_edges(g, g.nodes(), algorithm);
+	}
+
+	// As above, as a graph with all the nodes of g
+	template<typename N, typename E, spanning_forest_algorithm Algorithm = kruskal_t>
+	requires arithmetic<E>
+	auto minimum_spanning_forest(graph<N, E> const& g, Algorithm algorithm = kruskal)
+	   -> graph<N, E> {
+		auto const nodes = g.nodes();
+		auto const edges = detail::minimum_spanning_edges(g, nodes, algorithm);
+		auto forest = graph<N, E>(nodes.begin(), nodes.end());
+		forest.insert_edges(edges.begin(), edges.end());
+		return forest;
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_SPANNING_FOREST_HPP
@@ -0,0 +1,303 @@
+#ifndef GDWG_TRAVERSAL_HPP
+#define GDWG_TRAVERSAL_HPP
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/graph.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Breadth and depth first traversals that report what they do to a visitor. A visitor is any
+// object with some of these member functions; the ones it doesn't have are skipped at compile time.
+//     discover(n)                  n is reached for the first time
+//     examine_edge(from, to, w)    an edge out of a discovered node is looked at
+//     tree_edge(from, to, w)       an examined edge that leads to an undiscovered node, just before
+//                                  that node is discovered
+//     finish(n)                    every edge out of n was examined, and for dfs every node
+//                                  discovered through them is finished too
+// Edges out of a node are examined in the graph's (dst, weight) order. A hook may return bool,
+// and returning false stops the traversal straight away.
+namespace gdwg {
+
+	namespace detail {
+		// Numbers the nodes of a graph in the order a traversal discovers them, so that the
+		// traversal's per node state fits in vectors and nodes it never reaches cost nothing.
+		// edges(u) is a range over the edges out of node u whose iterators don't depend on the range
+		// object. visit(edge) gives the index of the edge's dst and whether this is its discovery.
+		template<typename N, typename E>
+		class graph_walk {
+		public:
+			using size_type = std::size_t;
+
+			graph_walk(graph<N, E> const& g, N const& src, char const* function)
+			: g_{g}
+			, nodes_{&src} {
+				if (!g.is_node(src)) {
+					throw std::runtime_error(std::string("Cannot call gdwg::") + function
+					                         + " if src doesn't exist in the graph");
+				}
+				if constexpr (flat_storable<N, E>)
+					index_.emplace(src, 0);
+			}
+
+			[[nodiscard]] static constexpr auto source() noexcept -> size_type {
+				return 0;
+			}
+			[[nodiscard]] auto node(size_type u) const noexcept -> N const& {
+				return *nodes_[u];
+			}
+			[[nodiscard]] auto edges(size_type u) const {
+				return g_.out_edges(*nodes_[u]);
+			}
+			auto visit(out_edge_ref<N, E> const& edge) -> std::pair<size_type, bool> {
+				auto [it, discovered] = index_.try_emplace(key_of(edge.to), nodes_.size());
+				if (discovered) {
+					if constexpr (!flat_storable<N, E>) {
+						if (!source_keyed_ && edge.to == *nodes_[0]) {
+							source_keyed_ = true;
+							it->second = 0;
+							return {0, false};
+						}
+					}
+					nodes_.push_back(&edge.to);
+				}
+				return {it->second, discovered};
+			}
+			[[nodiscard]] static auto to(out_edge_ref<N, E> const& edge) noexcept -> N const& {
+				return edge.to;
+			}
+			[[nodiscard]] static auto weight(out_edge_ref<N, E> const& edge) noexcept -> E const& {
+				return edge.weight;
+			}
+
+		private:
+			// The pointer based graph stores each node once, so like its copy constructor this
+			// tells nodes apart by address. src is the caller's copy rather than the stored node, so
+			// it gets its key the first time an edge leads back to it. Flat graphs keep copies of
+			// nodes in their edge lists, so there nodes are told apart by value.
+			using key_type = std::conditional_t<flat_storable<N, E>, N, N const*>;
+			using index_type = std::conditional_t<hashable<key_type>,
+			                                      std::unordered_map<key_type, size_type>,
+			                                      std::map<key_type, size_type>>;
+
+			graph<N, E> const& g_;
+			std::vector<N const*> nodes_;
+			index_type index_;
+			bool source_keyed_ = false;
+
+			[[nodiscard]] static auto key_of(N const& stored) noexcept -> key_type {
+				if constexpr (flat_storable<N, E>)
+					return stored;
+				else
+					return &stored;
+			}
+		};
+
+		// The same for a csr_graph, which already numbers its nodes. Its edges are positions in the
+		// packed arrays.
+		template<typename N, typename E>
+		class csr_walk {
+		public:
+			using size_type = std::size_t;
+
+			csr_walk(csr_graph<N, E> const& g, N const& src, char const* function)
+			: g_{g}
+			, offsets_{g.offsets()}
+			, targets_{g.targets()}
+			, weights_{g.edge_weights()}
+			, source_{g.index_of(src)} {
+				if (source_ == csr_graph<N, E>::npos) {
+					throw std::runtime_error(std::string("Cannot call gdwg::") + function
+					                         + " if src doesn't exist in the graph");
+				}
+				visited_.assign(g.node_count(), false);
+				visited_[source_] = true;
+			}
+
+			[[nodiscard]] auto source() const noexcept -> size_type {
+				return source_;
+			}
+			[[nodiscard]] auto node(size_type u) const noexcept -> N const& {
+				return g_.node(u);
+			}
+			[[nodiscard]] auto edges(size_type u) const noexcept {
+				return std::views::iota(offsets_[u], offsets_[u + 1]);
+			}
+			auto visit(size_type edge) -> std::pair<size_type, bool> {
+				auto const v = targets_[edge];
+				auto const discovered = !visited_[v];
+				visited_[v] = true;
+				return {v, discovered};
+			}
+			[[nodiscard]] auto to(size_type edge) const noexcept -> N const& {
+				return g_.node(targets_[edge]);
+			}
+			[[nodiscard]] auto weight(size_type edge) const noexcept -> E const& {
+				return weights_[edge];
+			}
+
+		private:
+			csr_graph<N, E> const& g_;
+			std::span<size_type const> offsets_;
+			std::span<size_type const> targets_;
+			std::span<E const> weights_;
+			size_type source_;
+			std::vector<bool> visited_;
+		};
+
+		// Runs a hook and tells whether the traversal should go on
+		template<typename Hook>
+		auto proceed(Hook&& hook) -> bool {
+			if constexpr (std::is_void_v<std::invoke_result_t<Hook>>) {
+				hook();
+				return true;
+			}
+			else {
+				return static_cast<bool>(hook());
+			}
+		}
+
+		template<typename Visitor, typename N>
+		auto discover(Visitor& vis, N const& n) -> bool {
+			if constexpr (requires { vis.discover(n); })
+				return proceed([&] { return vis.discover(n); });
+			else
+				return true;
+		}
+
+		template<typename Visitor, typename N, typename E>
+		auto examine_edge(Visitor& vis, N const& from, N const& to, E const& weight) -> bool {
+			if constexpr (requires { vis.examine_edge(from, to, weight); })
+				return proceed([&] { return vis.examine_edge(from, to, weight); });
+			else
+				return true;
+		}
+
+		template<typename Visitor, typename N, typename E>
+		auto tree_edge(Visitor& vis, N const& from, N const& to, E const& weight) -> bool {
+			if constexpr (requires { vis.tree_edge(from, to, weight); })
+				return proceed([&] { return vis.tree_edge(from, to, weight); });
+			else
+				return true;
+		}
+
+		template<typename Visitor, typename N>
+		auto finish(Visitor& vis, N const& n) -> bool {
+			if constexpr (requires { vis.finish(n); })
+				return proceed([&] { return vis.finish(n); });
+			else
+				return true;
+		}
+
+		template<typename Walk, typename Visitor>
+		auto bfs(Walk& walk, Visitor& vis) -> void {
+			// Nodes are appended as they are discovered and examined from head onwards
+			auto queue = std::vector<std::size_t>{walk.source()};
+			if (!discover(vis, walk.node(walk.source())))
+				return;
+
+			for (auto head = std::size_t{0}; head < queue.size(); ++head) {
+				auto const u = queue[head];
+				auto const& from = walk.node(u);
+				for (auto&& edge : walk.edges(u)) {
+					if (!examine_edge(vis, from, walk.to(edge), walk.weight(edge)))
+						return;
+					auto const [v, discovered] = walk.visit(edge);
+					if (!discovered)
+						continue;
+					if (!tree_edge(vis, from, walk.to(edge), walk.weight(edge))
+					    || !discover(vis, walk.node(v)))
+						return;
+					queue.push_back(v);
+				}
+				if (!finish(vis, from))
+					return;
+			}
+		}
+
+		// Iterative, so that long paths can't overflow the call stack. Each frame holds the node
+		// and where it is up to in its edges.
+		template<typename Walk, typename Visitor>
+		auto dfs(Walk& walk, Visitor& vis) -> void {
+			using edge_range = decltype(walk.edges(walk.source()));
+			struct frame {
+				std::size_t node;
+				std::ranges::iterator_t<edge_range> next;
+				std::ranges::sentinel_t<edge_range> last;
+			};
+
+			auto stack = std::vector<frame>{};
+			auto push = [&](std::size_t u) {
+				auto edges = walk.edges(u);
+				stack.push_back(frame{u, std::ranges::begin(edges), std::ranges::end(edges)});
+			};
+
+			if (!discover(vis, walk.node(walk.source())))
+				return;
+			push(walk.source());
+
+			while (!stack.empty()) {
+				auto& top = stack.back();
+				auto const u = top.node;
+				if (top.next == top.last) {
+					stack.pop_back();
+					if (!finish(vis, walk.node(u)))
+						return;
+					continue;
+				}
+
+				auto&& edge = *top.next;
+				++top.next;
+				auto const& from = walk.node(u);
+				if (!examine_edge(vis, from, walk.to(edge), walk.weight(edge)))
+					return;
+				auto const [v, discovered] = walk.visit(edge);
+				if (!discovered)
+					continue;
+				if (!tree_edge(vis, from, walk.to(edge), walk.weight(edge))
+				    || !discover(vis, walk.node(v)))
+					return;
+				push(v);
+			}
+		}
+	} // namespace detail
+
+	// Visits the nodes reachable from src in breadth first order
+	template<typename N, typename E, typename Visitor>
+	auto bfs(graph<N, E> const& g, N const& src, Visitor&& vis) -> void {
+		auto walk = detail::graph_walk<N, E>(g, src, "bfs");
+		detail::bfs(walk, vis);
+	}
+
+	template<typename N, typename E, typename Visitor>
+	auto bfs(csr_graph<N, E> const& g, N const& src, Visitor&& vis) -> void {
+		auto walk = detail::csr_walk<N, E>(g, src, "bfs");
+		detail::bfs(walk, vis);
+	}
+
+	// Visits the nodes reachable from src in depth first order
+	template<typename N, typename E, typename Visitor>
+	auto dfs(graph<N, E> const& g, N const& src, Visitor&& vis) -> void {
+		auto walk = detail::graph_walk<N, E>(g, src, "dfs");
+		detail::dfs(walk, vis);
+	}
+
+	template<typename N, typename E, typename Visitor>
+	auto dfs(csr_graph<N, E> const& g, N const& src, Visitor&& vis) -> void {
+		auto walk = detail::csr_walk<N, E>(g, src, "dfs");
+		detail::dfs(walk, vis);
+	}
+
+} // namespace gdwg
+
+#endif // GDWG_TRAVERSAL_HPP
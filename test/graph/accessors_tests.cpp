@@ -98,6 +98,14 @@ TEST_CASE("weights() test") {
 		CHECK(g.weights(3, 1) == std::vector<int>{7});
 		CHECK(g.weights(3, 2) == std::vector<int>{7, 8});
 	}
+
+	SECTION("weights() between unconnected nodes is empty test") {
+		auto s = gdwg::graph<std::string, int>{"a", "b"};
+		s.insert_edge("a", "b", 1);
+
+		CHECK(g.weights(1, 2).empty());
+		CHECK(s.weights("b", "a").empty());
+	}
 }
 
 TEST_CASE("connections() test") {
@@ -206,4 +214,199 @@ TEST_CASE("connections() test") {
 		CHECK(g.connections(5) == std::vector<int>{1});
 		CHECK(g.connections(6) == std::vector<int>{1, 2, 3, 4, 5, 6});
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("in_connections() test") {
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5, 6};
+
+	SECTION("in_connections() throws exception test") {
+		CHECK_THROWS_MATCHES(g.in_connections(7),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::graph<N, E>::in_connections if dst "
+		                                    "doesn't exist in the graph"));
+	}
+
+	SECTION("in_connections() on graph with no edges test") {
+		CHECK(g.in_connections(1) == std::vector<int>{});
+	}
+
+	SECTION("in_connections() on graph with incoming, outgoing and self edges test") {
+		g.insert_edge(1, 2, 5);
+		g.insert_edge(1, 2, 6);
+		g.insert_edge(2, 1, 7);
+		g.insert_edge(2, 2, 2);
+		g.insert_edge(6, 2, 2);
+		g.insert_edge(3, 2, 7);
+
+		CHECK(g.in_connections(1) == std::vector<int>{2});
+		CHECK(g.in_connections(2) == std::vector<int>{1, 2, 3, 6});
+		CHECK(g.in_connections(6) == std::vector<int>{});
+	}
+}
+
+TEST_CASE("in_degree() test") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+
+	CHECK_THROWS_MATCHES(g.in_degree(7),
+	                     std::runtime_error,
+	                     Catch::Message("Cannot call gdwg::graph<N, E>::in_degree if dst doesn't "
+	                                    "exist in the graph"));
+
+	CHECK(g.in_degree(2) == 0);
+
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(1, 2, 6);
+	g.insert_edge(2, 2, 1);
+	g.insert_edge(3, 1, 1);
+
+	CHECK(g.in_degree(1) == 1);
+	CHECK(g.in_degree(2) == 3);
+	CHECK(g.in_degree(3) == 0);
+}
+
+TEST_CASE("out_edges() test") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	auto s = gdwg::graph<std::string, std::string>{"a", "b", "c"};
+
+	SECTION("out_edges() throws exception test") {
+		CHECK_THROWS_MATCHES(g.out_edges(7),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::graph<N, E>::out_edges if src doesn't "
+		                                    "exist in the graph"));
+		CHECK_THROWS_MATCHES(s.out_edges("z"),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::graph<N, E>::out_edges if src doesn't "
+		                                    "exist in the graph"));
+	}
+
+	SECTION("out_edges() on node without edges test") {
+		g.insert_edge(2, 1, 4);
+		s.insert_edge("b", "a", "x");
+
+		CHECK(std::ranges::empty(g.out_edges(1)));
+		CHECK(std::ranges::empty(s.out_edges("a")));
+		CHECK(std::ranges::empty(s.out_edges("c")));
+	}
+
+	SECTION("out_edges() refers to the stored edges in order test") {
+		g.insert_edge(2, 3, 1);
+		g.insert_edge(2, 1, 7);
+		g.insert_edge(2, 1, 4);
+		g.insert_edge(1, 2, 5);
+		g.insert_edge(3, 2, 5);
+
+		auto tos = std::vector<int>{};
+		auto weights = std::vector<int>{};
+		for (auto const& [to, weight] : g.out_edges(2)) {
+			tos.push_back(to);
+			weights.push_back(weight);
+		}
+		CHECK(tos == std::vector<int>{1, 1, 3});
+		CHECK(weights == std::vector<int>{4, 7, 1});
+
+		s.insert_edge("b", "c", "y");
+		s.insert_edge("b", "a", "z");
+		s.insert_edge("b", "a", "x");
+		s.insert_edge("a", "b", "x");
+		s.insert_edge("c", "b", "x");
+
+		auto s_tos = std::vector<std::string>{};
+		auto s_weights = std::vector<std::string>{};
+		for (auto const& [to, weight] : s.out_edges("b")) {
+			s_tos.push_back(to);
+			s_weights.push_back(weight);
+		}
+		CHECK(s_tos == std::vector<std::string>{"a", "a", "c"});
+		CHECK(s_weights == std::vector<std::string>{"x", "z", "y"});
+
+		// Each call refers to the same stored node and weight rather than to copies
+		CHECK(&(*s.out_edges("b").begin()).to == &(*s.out_edges("b").begin()).to);
+		CHECK(&(*g.out_edges(2).begin()).weight == &(*g.out_edges(2).begin()).weight);
+	}
+}
+
+TEST_CASE("in_edges() test") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	auto s = gdwg::graph<std::string, std::string>{"a", "b", "c"};
+
+	SECTION("in_edges() throws exception test") {
+		CHECK_THROWS_MATCHES(g.in_edges(7),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::graph<N, E>::in_edges if dst doesn't "
+		                                    "exist in the graph"));
+		CHECK_THROWS_MATCHES(s.in_edges("z"),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::graph<N, E>::in_edges if dst doesn't "
+		                                    "exist in the graph"));
+	}
+
+	SECTION("in_edges() on node without edges test") {
+		g.insert_edge(1, 2, 4);
+		s.insert_edge("a", "b", "x");
+
+		CHECK(std::ranges::empty(g.in_edges(1)));
+		CHECK(std::ranges::empty(s.in_edges("a")));
+		CHECK(std::ranges::empty(s.in_edges("c")));
+	}
+
+	SECTION("in_edges() refers to the stored edges in order test") {
+		g.insert_edge(3, 2, 1);
+		g.insert_edge(1, 2, 7);
+		g.insert_edge(1, 2, 4);
+		g.insert_edge(2, 1, 5);
+		g.insert_edge(2, 3, 5);
+
+		auto froms = std::vector<int>{};
+		auto weights = std::vector<int>{};
+		for (auto const& [from, weight] : g.in_edges(2)) {
+			froms.push_back(from);
+			weights.push_back(weight);
+		}
+		CHECK(froms == std::vector<int>{1, 1, 3});
+		CHECK(weights == std::vector<int>{4, 7, 1});
+
+		s.insert_edge("c", "b", "y");
+		s.insert_edge("a", "b", "z");
+		s.insert_edge("a", "b", "x");
+		s.insert_edge("b", "a", "x");
+		s.insert_edge("b", "b", "w");
+
+		auto s_froms = std::vector<std::string>{};
+		auto s_weights = std::vector<std::string>{};
+		for (auto const& [from, weight] : s.in_edges("b")) {
+			s_froms.push_back(from);
+			s_weights.push_back(weight);
+		}
+		CHECK(s_froms == std::vector<std::string>{"a", "a", "b", "c"});
+		CHECK(s_weights == std::vector<std::string>{"x", "z", "w", "y"});
+
+		// The same stored weights that out_edges hands out
+		CHECK(&(*s.in_edges("a").begin()).weight == &(*s.out_edges("b").begin()).weight);
+		CHECK(&(*g.in_edges(3).begin()).weight == &(*std::next(g.out_edges(2).begin())).weight);
+	}
+}
+
+TEST_CASE("weights_view() test") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	auto s = gdwg::graph<std::string, int>{"a", "b"};
+
+	CHECK_THROWS_MATCHES(g.weights_view(1, 7),
+	                     std::runtime_error,
+	                     Catch::Message("Cannot call gdwg::graph<N, E>::weights_view if src or dst "
+	                                    "node don't exist in the graph"));
+
+	g.insert_edge(1, 2, 7);
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(1, 3, 6);
+	g.insert_edge(2, 2, 1);
+	s.insert_edge("a", "b", 3);
+	s.insert_edge("a", "b", 2);
+
+	auto const weights = g.weights_view(1, 2);
+	CHECK(std::vector<int>(weights.begin(), weights.end()) == g.weights(1, 2));
+	CHECK(std::ranges::empty(g.weights_view(2, 1)));
+
+	auto const s_weights = s.weights_view("a", "b");
+	CHECK(std::vector<int>(s_weights.begin(), s_weights.end()) == std::vector<int>{2, 3});
+	CHECK(std::ranges::empty(s.weights_view("b", "a")));
+}
@@ -0,0 +1,129 @@
+#include "gdwg/all_pairs_shortest_paths.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+	// 1 -> 2 -> 3 -> 4 with a shortcut 1 -> 3, a way back 4 -> 1, and 5 that nothing reaches
+	auto make_graph() -> gdwg::graph<int, int> {
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5};
+		g.insert_edge(1, 2, 2);
+		g.insert_edge(2, 3, 3);
+		g.insert_edge(1, 3, 7);
+		g.insert_edge(1, 3, 4);
+		g.insert_edge(3, 4, 1);
+		g.insert_edge(4, 1, 6);
+		g.insert_edge(5, 1, 1);
+		return g;
+	}
+
+	// Every algorithm has to agree with single source Dijkstra from every node
+	template<typename E>
+	auto check_against_dijkstra(gdwg::graph<int, E> const& g, gdwg::distance_matrix<int, E> const& d)
+	   -> void {
+		auto const nodes = g.nodes();
+		REQUIRE(d.size() == nodes.size());
+		for (auto const src : nodes) {
+			auto const tree = gdwg::shortest_paths(g, src);
+			for (auto const dst : nodes) {
+				REQUIRE(d.reachable(src, dst) == tree.reached(dst));
+				if (tree.reached(dst))
+					REQUIRE(d.distance(src, dst) == Approx(tree.distance(dst)));
+			}
+		}
+	}
+} // namespace
+
+TEST_CASE("all_pairs_shortest_paths() test") {
+	auto const g = make_graph();
+
+	SECTION("all_pairs_shortest_paths() with Floyd-Warshall test") {
+		auto const d = gdwg::all_pairs_shortest_paths(g, gdwg::floyd_warshall);
+		CHECK(d.distance(1, 4) == 5);
+		CHECK(d.distance(4, 3) == 10);
+		CHECK(d.distance(5, 4) == 6);
+		CHECK(d.distance(2, 2) == 0);
+		CHECK(!d.reachable(1, 5));
+		CHECK(d.at(0, 4) == gdwg::distance_matrix<int, int>::unreachable);
+		check_against_dijkstra(g, d);
+	}
+
+	SECTION("all_pairs_shortest_paths() with repeated Dijkstra test") {
+		auto const d = gdwg::all_pairs_shortest_paths(g, gdwg::repeated_dijkstra);
+		CHECK(d.data().size() == 25);
+		CHECK(d.row(0)[3] == 5);
+		check_against_dijkstra(g, d);
+		CHECK(d.data().size() == gdwg::all_pairs_shortest_paths(g).data().size());
+	}
+
+	SECTION("all_pairs_shortest_paths() algorithms agree across blocks and threads test") {
+		// More than two 64 node blocks, so every phase has several blocks to share out
+		auto const random = gdwg::erdos_renyi<int, double>(150, 2000, 5, 10.0);
+		auto const floyd = gdwg::all_pairs_shortest_paths(random, gdwg::floyd_warshall);
+		check_against_dijkstra(random, floyd);
+
+		auto const threaded = gdwg::all_pairs_shortest_paths(random, gdwg::floyd_warshall, 3);
+		CHECK(threaded.data().size() == floyd.data().size());
+		for (auto i = std::size_t{0}; i < floyd.data().size(); ++i)
+			REQUIRE(threaded.data()[i] == floyd.data()[i]);
+
+		auto const dijkstra = gdwg::all_pairs_shortest_paths(random, gdwg::repeated_dijkstra, 3);
+		for (auto i = std::size_t{0}; i < floyd.data().size(); ++i)
+			REQUIRE(dijkstra.data()[i] == Approx(floyd.data()[i]));
+	}
+
+	SECTION("all_pairs_shortest_paths() with negative weights test") {
+		auto negative = make_graph();
+		negative.insert_edge(2, 4, -3);
+		auto const d = gdwg::all_pairs_shortest_paths(negative);
+		CHECK(d.distance(1, 4) == -1);
+		CHECK(d.distance(5, 4) == 0);
+		CHECK(!d.reachable(4, 5));
+		CHECK_THROWS_MATCHES(gdwg::all_pairs_shortest_paths(negative, gdwg::repeated_dijkstra),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::all_pairs_shortest_paths with "
+		                                    "repeated_dijkstra on a graph with negative weights"));
+
+		negative.insert_edge(4, 2, -1);
+		CHECK_THROWS_MATCHES(gdwg::all_pairs_shortest_paths(negative),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::all_pairs_shortest_paths on a graph "
+		                                    "with a negative cycle"));
+	}
+
+	SECTION("all_pairs_shortest_paths() on floating point weights test") {
+		auto f = gdwg::graph<std::string, double>{"a", "b", "c"};
+		f.insert_edge("a", "b", 0.5);
+		f.insert_edge("b", "c", 0.25);
+		auto const d = gdwg::all_pairs_shortest_paths(gdwg::csr_graph<std::string, double>(f),
+		                                              gdwg::floyd_warshall);
+		CHECK(d.distance("a", "c") == 0.75);
+		CHECK(d.at(2, 0) == std::numeric_limits<double>::infinity());
+	}
+
+	SECTION("all_pairs_shortest_paths() on an empty graph test") {
+		auto const d = gdwg::all_pairs_shortest_paths(gdwg::graph<int, int>{});
+		CHECK(d.size() == 0);
+		CHECK(d.data().empty());
+	}
+
+	SECTION("distance_matrix<N, E> throws exception test") {
+		auto const d = gdwg::all_pairs_shortest_paths(g);
+		CHECK_THROWS_MATCHES(d.distance(1, 5),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::distance_matrix<N, E>::distance if "
+		                                    "there is no path from src to dst"));
+		CHECK_THROWS_MATCHES(d.distance(1, 6),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::distance_matrix<N, E>::distance if "
+		                                    "there is no path from src to dst"));
+	}
+}
@@ -0,0 +1,213 @@
+#include "gdwg/bellman_ford.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+
+#include "graph_fixtures.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	// 1 -> 2 -> 3 -> 4 where the long way round beats the direct edges once the negative weights
+	// are counted, and 5 that nothing reaches
+	auto make_graph() -> gdwg::graph<int, int> {
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5};
+		g.insert_edge(1, 2, 4);
+		g.insert_edge(1, 3, 5);
+		g.insert_edge(1, 4, 6);
+		g.insert_edge(2, 3, -3);
+		g.insert_edge(3, 4, -2);
+		g.insert_edge(3, 4, 7);
+		g.insert_edge(4, 2, 8);
+		g.insert_edge(5, 1, 1);
+		return g;
+	}
+
+	// Signed weights without negative cycles: every edge is worth at least the difference of
+	// its nodes' potentials, which any cycle cancels out
+	auto signed_graph(std::size_t node_count, std::size_t edge_count, std::uint64_t seed)
+	   -> gdwg::graph<int, int> {
+		auto g = gdwg::erdos_renyi<int, int>(node_count, edge_count, seed, 20);
+		auto rng = std::mt19937_64{seed};
+		auto potential = std::uniform_int_distribution<int>(0, 50);
+		auto potentials = std::vector<int>(node_count);
+		for (auto& p : potentials)
+			p = potential(rng);
+
+		auto const nodes = g.nodes();
+		auto result = gdwg::graph<int, int>(nodes.begin(), nodes.end());
+		for (auto const& [from, to, weight] : g) {
+			auto const shift = potentials[static_cast<std::size_t>(from)]
+			                   - potentials[static_cast<std::size_t>(to)];
+			result.insert_edge(from, to, weight + shift);
+		}
+		return result;
+	}
+
+	auto check_against_reference(gdwg::graph<int, int> const& g,
+	                             gdwg::bellman_ford_result<int, int> const& result,
+	                             int src) -> void {
+		REQUIRE_FALSE(result.has_negative_cycle());
+		auto const expected = fixtures::reference_distances(g, src);
+		auto const& paths = result.paths();
+		for (auto n = 0; n < static_cast<int>(expected.size()); ++n) {
+			REQUIRE(paths.reached(n) == expected[static_cast<std::size_t>(n)].has_value());
+			if (!paths.reached(n))
+				continue;
+			CHECK(paths.distance(n) == *expected[static_cast<std::size_t>(n)]);
+
+			// The path adds up to the distance
+			auto const path = paths.path_to(n);
+			auto total = 0;
+			for (auto i = std::size_t{1}; i < path.size(); ++i)
+				total += g.weights(path[i - 1], path[i]).front();
+			CHECK(total == paths.distance(n));
+		}
+	}
+
+	// A cycle of edges in g, each leading on from the one before, with negative total weight
+	auto check_negative_cycle(gdwg::graph<int, int> const& g,
+	                          gdwg::bellman_ford_result<int, int> const& result) -> void {
+		REQUIRE(result.has_negative_cycle());
+		auto const& cycle = result.negative_cycle();
+		REQUIRE_FALSE(cycle.empty());
+		auto total = 0;
+		for (auto i = std::size_t{0}; i < cycle.size(); ++i) {
+			CHECK(cycle[i].to == cycle[(i + 1) % cycle.size()].from);
+			CHECK(cycle[i].weight == g.weights(cycle[i].from, cycle[i].to).front());
+			total += cycle[i].weight;
+		}
+		CHECK(total < 0);
+	}
+} // namespace
+
+TEST_CASE("bellman_ford() test") {
+	auto const g = make_graph();
+	auto const csr = gdwg::csr_graph<int, int>(g);
+
+	SECTION("bellman_ford() distances and paths with negative weights test") {
+		for (auto const& result :
+		     {gdwg::bellman_ford(g, 1), gdwg::bellman_ford(csr, 1), gdwg::bellman_ford(g, 1, 2)})
+		{
+			REQUIRE_FALSE(result.has_negative_cycle());
+			CHECK(result.negative_cycle().empty());
+			auto const& paths = result.paths();
+			CHECK(paths.source() == 1);
+			CHECK(paths.distance(1) == 0);
+			CHECK(paths.distance(2) == 4);
+			CHECK(paths.distance(3) == 1);
+			CHECK(paths.distance(4) == -1);
+			CHECK(paths.path_to(4) == std::vector<int>{1, 2, 3, 4});
+			CHECK(paths.reached(5) == false);
+		}
+	}
+
+	SECTION("bellman_ford() finds a negative cycle test") {
+		auto cyclic = g;
+		cyclic.insert_edge(4, 3, 1);
+		cyclic.insert_edge(4, 3, 3);
+		auto const cyclic_csr = gdwg::csr_graph<int, int>(cyclic);
+
+		for (auto const& result : {gdwg::bellman_ford(cyclic, 1),
+		                           gdwg::bellman_ford(cyclic_csr, 1),
+		                           gdwg::bellman_ford(cyclic_csr, 1, 1),
+		                           gdwg::bellman_ford(cyclic_csr, 1, 3)})
+		{
+			check_negative_cycle(cyclic, result);
+			CHECK(result.negative_cycle().size() == 2);
+		}
+
+		// 5 reaches the cycle, but nothing on it reaches 5
+		CHECK(gdwg::bellman_ford(cyclic, 5).has_negative_cycle());
+	}
+
+	SECTION("bellman_ford() ignores negative cycles it can't reach test") {
+		auto cyclic = g;
+		cyclic.insert_node(6);
+		cyclic.insert_node(7);
+		cyclic.insert_edge(6, 7, 1);
+		cyclic.insert_edge(7, 6, -2);
+		cyclic.insert_edge(6, 1, 0);
+
+		for (auto const& result : {gdwg::bellman_ford(cyclic, 1), gdwg::bellman_ford(cyclic, 1, 2)}) {
+			REQUIRE_FALSE(result.has_negative_cycle());
+			CHECK(result.paths().distance(4) == -1);
+			CHECK(result.paths().reached(6) == false);
+		}
+	}
+
+	SECTION("bellman_ford() on a negative self loop test") {
+		auto looped = gdwg::graph<int, int>{1, 2};
+		looped.insert_edge(1, 2, 3);
+		looped.insert_edge(2, 2, -1);
+
+		for (auto const& result : {gdwg::bellman_ford(looped, 1), gdwg::bellman_ford(looped, 1, 2)}) {
+			REQUIRE(result.has_negative_cycle());
+			CHECK(result.negative_cycle() == std::vector<gdwg::graph<int, int>::value_type>{{2, 2, -1}});
+		}
+	}
+
+	SECTION("bellman_ford() on string nodes and double weights test") {
+		auto s = gdwg::graph<std::string, double>{"a", "b", "c"};
+		s.insert_edge("a", "b", 0.5);
+		s.insert_edge("b", "c", -0.25);
+		s.insert_edge("a", "c", 1.0);
+
+		auto const result = gdwg::bellman_ford(s, std::string("a"));
+		CHECK(result.paths().distance("c") == 0.25);
+		CHECK(result.paths().path_to("c") == std::vector<std::string>{"a", "b", "c"});
+	}
+
+	SECTION("bellman_ford() throws exception test") {
+		CHECK_THROWS_MATCHES(gdwg::bellman_ford(g, 7),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::bellman_ford if src doesn't exist in the "
+		                                    "graph"));
+		CHECK_THROWS_MATCHES(gdwg::bellman_ford(csr, 7, 2),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::bellman_ford if src doesn't exist in the "
+		                                    "graph"));
+
+		auto cyclic = g;
+		cyclic.insert_edge(4, 3, 1);
+		CHECK_THROWS_MATCHES(gdwg::bellman_ford(cyclic, 1).paths(),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::bellman_ford_result<N, E>::paths when "
+		                                    "there is a negative cycle"));
+	}
+}
+
+TEST_CASE("bellman_ford() agrees with relaxing every edge test") {
+	auto const g = signed_graph(300, 1200, 11);
+	auto const csr = gdwg::csr_graph<int, int>(g);
+
+	for (auto const src : {0, 42, 299}) {
+		check_against_reference(g, gdwg::bellman_ford(g, src), src);
+		check_against_reference(g, gdwg::bellman_ford(csr, src), src);
+		for (auto const threads : {std::size_t{1}, std::size_t{2}, std::size_t{5}})
+			check_against_reference(g, gdwg::bellman_ford(csr, src, threads), src);
+	}
+}
+
+TEST_CASE("bellman_ford() finds negative cycles in random graphs test") {
+	for (auto const seed : {std::uint64_t{1}, std::uint64_t{2}, std::uint64_t{3}}) {
+		auto g = signed_graph(200, 800, seed);
+		// A long cycle through most of the graph that only just comes out negative
+		auto total = 0;
+		for (auto n = 10; n < 190; ++n) {
+			g.insert_edge(n, n + 1, 1);
+			++total;
+		}
+		g.insert_edge(190, 10, -total - 1);
+
+		check_negative_cycle(g, gdwg::bellman_ford(g, 0));
+		for (auto const threads : {std::size_t{1}, std::size_t{4}})
+			check_negative_cycle(g, gdwg::bellman_ford(g, 0, threads));
+	}
+}
@@ -0,0 +1,239 @@
+#include "gdwg/components.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	// {1, 2, 3} and {4, 5} are cycles, 3 -> 4 joins them, 5 -> 6 leads out and 7 is on its own
+	auto make_graph() -> gdwg::graph<int, int> {
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5, 6, 7};
+		g.insert_edge(1, 2, 1);
+		g.insert_edge(2, 3, 2);
+		g.insert_edge(3, 1, 3);
+		g.insert_edge(3, 4, 4);
+		g.insert_edge(4, 5, 5);
+		g.insert_edge(5, 4, 6);
+		g.insert_edge(5, 6, 7);
+		g.insert_edge(2, 5, 8);
+		g.insert_edge(6, 6, 9);
+		return g;
+	}
+} // namespace
+
+TEST_CASE("strongly_connected_components() test") {
+	auto const g = make_graph();
+	auto const scc = gdwg::strongly_connected_components(g);
+
+	SECTION("strongly_connected_components() groups nodes test") {
+		CHECK(scc.count() == 4);
+		CHECK(scc.component(1) == scc.component(2));
+		CHECK(scc.component(1) == scc.component(3));
+		CHECK(scc.component(4) == scc.component(5));
+		CHECK(scc.component(1) != scc.component(4));
+		CHECK(scc.members(scc.component(2)) == std::vector<int>{1, 2, 3});
+		CHECK(scc.members(scc.component(5)) == std::vector<int>{4, 5});
+		CHECK(scc.members(scc.component(6)) == std::vector<int>{6});
+	}
+
+	SECTION("strongly_connected_components() numbers components in topological order test") {
+		for (auto const& [from, to, weight] : g) {
+			CHECK(scc.component(from) <= scc.component(to));
+		}
+		CHECK(scc.component(1) < scc.component(4));
+		CHECK(scc.component(4) < scc.component(6));
+	}
+
+	SECTION("strongly_connected_components() on a csr_graph gives the same components test") {
+		CHECK(gdwg::strongly_connected_components(gdwg::csr_graph<int, int>(g)) == scc);
+	}
+
+	SECTION("strongly_connected_components() on string nodes test") {
+		auto s = gdwg::graph<std::string, int>{"a", "b", "c"};
+		s.insert_edge("a", "b", 1);
+		s.insert_edge("b", "a", 1);
+		s.insert_edge("b", "c", 1);
+		auto const string_scc = gdwg::strongly_connected_components(s);
+		CHECK(string_scc.count() == 2);
+		CHECK(string_scc.members(0) == std::vector<std::string>{"a", "b"});
+		CHECK(string_scc.component("c") == 1);
+	}
+
+	SECTION("strongly_connected_components() follows long paths without recursion test") {
+		// Every edge of a grid goes both ways, so one long row is one component
+		auto const path = gdwg::grid<int, int>(1, 200000, 1);
+		auto const path_scc = gdwg::strongly_connected_components(path);
+		CHECK(path_scc.count() == 1);
+		CHECK(path_scc.members(0).size() == 200000);
+	}
+
+	SECTION("strongly_connected_components() on an empty graph test") {
+		auto const empty = gdwg::strongly_connected_components(gdwg::graph<int, int>{});
+		CHECK(empty.count() == 0);
+		CHECK(empty.nodes().empty());
+	}
+
+	SECTION("components<N> throws exception test") {
+		CHECK_THROWS_MATCHES(scc.component(8),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::components<N>::component if value "
+		                                    "doesn't exist in the graph"));
+		CHECK_THROWS_MATCHES(scc.members(4),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::components<N>::members if id isn't a "
+		                                    "component"));
+	}
+}
+
+TEST_CASE("condensation() test") {
+	auto const g = make_graph();
+	auto const scc = gdwg::strongly_connected_components(g);
+
+	SECTION("condensation() merges components test") {
+		auto const dag = gdwg::condensation(g, scc);
+		auto const a = scc.component(1);
+		auto const b = scc.component(4);
+		auto const c = scc.component(6);
+
+		auto expected = gdwg::graph<std::size_t, int>{0, 1, 2, 3};
+		expected.insert_edge(a, b, 4);
+		expected.insert_edge(a, b, 8);
+		expected.insert_edge(b, c, 7);
+		CHECK(dag == expected);
+	}
+
+	SECTION("condensation() of a csr_graph gives the same graph test") {
+		CHECK(gdwg::condensation(gdwg::csr_graph<int, int>(g), scc) == gdwg::condensation(g, scc));
+	}
+
+	SECTION("condensation() of a graph without cycles is the same shape test") {
+		auto dag = gdwg::graph<int, int>{};
+		for (auto const& [from, to, weight] : gdwg::grid<int, int>(4, 4, 1)) {
+			dag.insert_node(from);
+			dag.insert_node(to);
+			if (from < to)
+				dag.insert_edge(from, to, weight);
+		}
+		auto const dag_scc = gdwg::strongly_connected_components(dag);
+		CHECK(dag_scc.count() == 16);
+		auto edges = std::size_t{0};
+		for (auto const& [from, to, weight] : gdwg::condensation(dag, dag_scc)) {
+			CHECK(from < to);
+			++edges;
+		}
+		CHECK(edges == 24);
+	}
+
+	SECTION("condensation() throws exception test") {
+		auto other = make_graph();
+		other.insert_node(8);
+		CHECK_THROWS_MATCHES(gdwg::condensation(other, scc),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::condensation if scc doesn't partition "
+		                                    "the nodes of g"));
+	}
+}
+
+TEST_CASE("weak_components() test") {
+	auto const g = make_graph();
+
+	SECTION("weak_components() ignores edge direction test") {
+		auto const weak = gdwg::weak_components(g);
+		CHECK(weak.count() == 2);
+		CHECK(weak.members(0) == std::vector<int>{1, 2, 3, 4, 5, 6});
+		CHECK(weak.members(1) == std::vector<int>{7});
+		CHECK(weak.component(7) == 1);
+	}
+
+	SECTION("weak_components() on a csr_graph gives the same components test") {
+		CHECK(gdwg::weak_components(gdwg::csr_graph<int, int>(g)) == gdwg::weak_components(g));
+	}
+
+	SECTION("weak_components() agrees with strongly_connected_components() on a grid test") {
+		auto const grid = gdwg::grid<int, int>(30, 30, 1);
+		CHECK(gdwg::weak_components(grid).count() == 1);
+		CHECK(gdwg::strongly_connected_components(grid).count() == 1);
+	}
+
+	SECTION("weak_components() on string nodes test") {
+		auto s = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+		s.insert_edge("d", "b", 1);
+		auto const weak = gdwg::weak_components(s);
+		CHECK(weak.count() == 3);
+		CHECK(weak.members(weak.component("b")) == std::vector<std::string>{"b", "d"});
+	}
+}
+
+TEST_CASE("incremental_components<N, E> test") {
+	auto tracker = gdwg::incremental_components<int, int>(make_graph());
+
+	SECTION("incremental_components<N, E> starts from the graph test") {
+		CHECK(tracker.as_graph() == make_graph());
+		CHECK(tracker.count() == 2);
+		CHECK(tracker.connected(1, 6));
+		CHECK(tracker.connected(6, 1));
+		CHECK(!tracker.connected(1, 7));
+	}
+
+	SECTION("incremental_components<N, E> follows inserts test") {
+		CHECK(tracker.insert_node(8));
+		CHECK(!tracker.insert_node(8));
+		CHECK(tracker.as_graph().is_node(8));
+		CHECK(tracker.count() == 3);
+		CHECK(tracker.insert_edge(2, 6, 1));
+		CHECK(!tracker.insert_edge(2, 6, 1));
+		CHECK(tracker.count() == 3);
+		CHECK(tracker.insert_edge(8, 7, 2));
+		CHECK(tracker.connected(7, 8));
+		CHECK(tracker.insert_edge(7, 1, 3));
+		CHECK(tracker.connected(8, 5));
+		CHECK(tracker.count() == 1);
+		CHECK(tracker.as_graph().weights(8, 7) == std::vector<int>{2});
+
+		tracker.clear();
+		CHECK(tracker.as_graph().empty());
+		CHECK(tracker.count() == 0);
+	}
+
+	SECTION("incremental_components<N, E> matches weak_components() as it grows test") {
+		auto rng = std::mt19937{3};
+		auto pick = std::uniform_int_distribution<int>{0, 199};
+		auto grown = gdwg::incremental_components<int, int>{};
+		for (auto i = 0; i < 200; ++i)
+			grown.insert_node(i);
+		for (auto i = 0; i < 150; ++i) {
+			grown.insert_edge(pick(rng), pick(rng), i);
+
+			auto const weak = gdwg::weak_components(grown.as_graph());
+			REQUIRE(grown.count() == weak.count());
+			auto const a = pick(rng);
+			auto const b = pick(rng);
+			CHECK(grown.connected(a, b) == (weak.component(a) == weak.component(b)));
+		}
+	}
+
+	SECTION("incremental_components<N, E> on string nodes test") {
+		auto strings = gdwg::incremental_components<std::string, int>{"a", "b"};
+		CHECK(!strings.connected("a", "b"));
+		strings.insert_edge("b", "a", 1);
+		CHECK(strings.connected("a", "b"));
+	}
+
+	SECTION("incremental_components<N, E> throws exception test") {
+		CHECK_THROWS_MATCHES(tracker.insert_edge(1, 8, 1),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::incremental_components<N, E>::"
+		                                    "insert_edge when either src or dst node does not exist"));
+		CHECK_THROWS_MATCHES((void)tracker.connected(8, 1),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::incremental_components<N, E>::connected "
+		                                    "if either node doesn't exist"));
+		CHECK(tracker.as_graph() == make_graph());
+	}
+}
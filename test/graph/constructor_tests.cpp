@@ -128,6 +128,59 @@ TEST_CASE("graph(InputIt , InputIt) constructor test") {
 	}
 }
 
+TEST_CASE("graph(from_edges_t, EdgeRange&&) constructor test") {
+	SECTION("graph from empty edge range test") {
+		auto g = gdwg::graph<int, int>(gdwg::from_edges, std::vector<vt>{});
+
+		CHECK(g.empty() == true);
+		CHECK(g == gdwg::graph<int, int>{});
+	}
+
+	SECTION("graph from unsorted edges with duplicates test") {
+		auto const edges = std::vector<vt>{
+		   {4, 1, -4},
+		   {3, 2, 2},
+		   {2, 4, 2},
+		   {2, 1, 1},
+		   {3, 2, 2},
+		   {2, 1, 3},
+		   {1, 1, 2},
+		};
+		auto g = gdwg::graph<int, int>(gdwg::from_edges, edges);
+
+		auto expected = gdwg::graph<int, int>{1, 2, 3, 4};
+		for (auto const& [from, to, weight] : edges) {
+			expected.insert_edge(from, to, weight);
+		}
+
+		CHECK(g.nodes() == std::vector<int>{1, 2, 3, 4});
+		CHECK(g == expected);
+		CHECK(g.in_connections(1) == std::vector<int>{1, 2, 4});
+		CHECK(g.weights(2, 1) == std::vector<int>{1, 3});
+	}
+
+	SECTION("graph from non-vector range test") {
+		auto const edges = std::list<vt>{{2, 1, 1}, {1, 2, 5}};
+		auto g = gdwg::graph<int, int>(gdwg::from_edges, edges);
+
+		auto it = g.begin();
+		CHECK(vt(1, 2, 5) == *it);
+		CHECK(vt(2, 1, 1) == *++it);
+		CHECK(g.end() == ++it);
+	}
+
+	SECTION("graph from edges is modifiable afterwards test") {
+		auto g = gdwg::graph<std::string, int>(
+		   gdwg::from_edges,
+		   std::vector<gdwg::graph<std::string, int>::value_type>{{"b", "a", 1}, {"a", "b", 1}});
+
+		CHECK(g.replace_node("a", "c") == true);
+		CHECK(g.erase_edge("b", "c", 1) == true);
+		CHECK(g.insert_edge("c", "b", 2) == true);
+		CHECK(g.weights("c", "b") == std::vector<int>{1, 2});
+	}
+}
+
 TEST_CASE("graph(graph&) constructor test") {
 	auto g = gdwg::graph<int, int>{1, 2, 3};
 	g.insert_edge(1, 2, 5);
@@ -214,6 +267,32 @@ TEST_CASE("graph(graph&) constructor test") {
 	}
 }
 
+TEST_CASE("graph(graph&) copy is independent of the original test") {
+	auto g = gdwg::graph<std::string, int>{"a", "b", "c", "d"};
+	g.insert_edge("a", "b", 1);
+	g.insert_edge("a", "c", 1);
+	g.insert_edge("c", "a", 2);
+	g.insert_edge("d", "d", 2);
+	g.merge_replace_node("d", "c");
+
+	auto copy = g;
+	CHECK(copy == g);
+	CHECK(copy.in_connections("a") == std::vector<std::string>{"c"});
+	CHECK(copy.in_connections("c") == std::vector<std::string>{"a", "c"});
+
+	CHECK(copy.replace_node("c", "e") == true);
+	CHECK(copy.erase_edge("a", "b", 1) == true);
+	CHECK(copy.insert_edge("b", "e", 1) == true);
+	CHECK(copy.in_connections("e") == std::vector<std::string>{"a", "b", "e"});
+
+	CHECK(g.nodes() == std::vector<std::string>{"a", "b", "c"});
+	CHECK(g.in_connections("c") == std::vector<std::string>{"a", "c"});
+	CHECK(g.is_connected("a", "b") == true);
+
+	g.clear();
+	CHECK(copy.weights("e", "a") == std::vector<int>{2});
+}
+
 TEST_CASE("graph(graph&&) constructor test") {
 	auto g = gdwg::graph<int, int>{1, 2, 3};
 	g.insert_edge(1, 2, 5);
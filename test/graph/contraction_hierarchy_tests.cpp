@@ -0,0 +1,193 @@
+#include "gdwg/contraction_hierarchy.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include "graph_fixtures.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST_CASE("contraction_hierarchy test") {
+	auto g = fixtures::dijkstra_example<double>();
+	g.insert_edge(5, 5, 1);
+	auto const ch = gdwg::contraction_hierarchy<int, double>(g);
+
+	SECTION("contraction_hierarchy shortest_path() distance and path test") {
+		for (auto const& hierarchy : {ch,
+		                              gdwg::contraction_hierarchy<int, double>(
+		                                 gdwg::csr_graph<int, double>(g)),
+		                              gdwg::contraction_hierarchy<int, double>(g, 3)})
+		{
+			auto const result = hierarchy.shortest_path(1, 5);
+			REQUIRE(result.found());
+			CHECK(result.distance() == 20);
+			CHECK(result.path() == std::vector<int>{1, 3, 6, 5});
+			CHECK(result.settled() > 0);
+		}
+		CHECK(ch.node_count() == 6);
+		CHECK(std::vector<int>(ch.nodes().begin(), ch.nodes().end())
+		      == std::vector<int>{1, 2, 3, 4, 5, 6});
+	}
+
+	SECTION("contraction_hierarchy shortest_path() from a node to itself test") {
+		auto const result = ch.shortest_path(5, 5);
+		CHECK(result.distance() == 0);
+		CHECK(result.path() == std::vector<int>{5});
+	}
+
+	SECTION("contraction_hierarchy shortest_path() without a path test") {
+		auto const result = ch.shortest_path(5, 1);
+		CHECK(result.found() == false);
+		CHECK(result.path().empty());
+	}
+
+	SECTION("contraction_hierarchy on string nodes test") {
+		auto s = gdwg::graph<std::string, double>{"a", "b", "c", "d"};
+		s.insert_edge("a", "b", 0.5);
+		s.insert_edge("b", "c", 0.25);
+		s.insert_edge("a", "c", 1.0);
+		s.insert_edge("c", "d", 0.5);
+
+		auto const ch = gdwg::contraction_hierarchy<std::string, double>(s);
+		auto const result = ch.shortest_path("a", "d");
+		CHECK(result.distance() == 1.25);
+		CHECK(result.path() == std::vector<std::string>{"a", "b", "c", "d"});
+	}
+
+	SECTION("contraction_hierarchy save() and load() test") {
+		auto stream = std::stringstream{};
+		ch.save(stream);
+		auto const loaded = gdwg::contraction_hierarchy<int, double>::load(stream);
+		CHECK(loaded == ch);
+		CHECK(loaded.shortest_path(1, 5).path() == std::vector<int>{1, 3, 6, 5});
+	}
+
+	SECTION("contraction_hierarchy save() and load() without nodes test") {
+		using hierarchy = gdwg::contraction_hierarchy<int, double>;
+		for (auto const& empty : {hierarchy(), hierarchy(gdwg::graph<int, double>{})}) {
+			auto stream = std::stringstream{};
+			empty.save(stream);
+			auto const loaded = hierarchy::load(stream);
+			CHECK(loaded == empty);
+			CHECK(loaded.node_count() == 0);
+		}
+		CHECK(hierarchy() == hierarchy(gdwg::graph<int, double>{}));
+	}
+
+	SECTION("contraction_hierarchy throws exception test") {
+		using hierarchy = gdwg::contraction_hierarchy<int, double>;
+		CHECK_THROWS_MATCHES(ch.shortest_path(1, 7),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::contraction_hierarchy<N, E>::"
+		                                    "shortest_path if src or dst node don't exist in the "
+		                                    "graph"));
+
+		auto negative = g;
+		negative.insert_edge(2, 1, -1);
+		CHECK_THROWS_MATCHES(hierarchy(negative),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot construct gdwg::contraction_hierarchy<N, E> "
+		                                    "from a graph with negative weights"));
+
+		auto const message = Catch::Message("Cannot call gdwg::contraction_hierarchy<N, E>::load "
+		                                    "on a stream that doesn't hold a saved hierarchy of "
+		                                    "this type");
+		auto saved = std::stringstream{};
+		ch.save(saved);
+		auto const bytes = saved.str();
+
+		auto truncated = std::stringstream(bytes.substr(0, bytes.size() - 1));
+		CHECK_THROWS_MATCHES(hierarchy::load(truncated), std::runtime_error, message);
+		using float_hierarchy = gdwg::contraction_hierarchy<int, float>;
+		auto other_weights = std::stringstream(bytes);
+		CHECK_THROWS_MATCHES(float_hierarchy::load(other_weights), std::runtime_error, message);
+		auto garbage = std::stringstream("not a hierarchy at all");
+		CHECK_THROWS_MATCHES(hierarchy::load(garbage), std::runtime_error, message);
+
+		// A header that claims far more nodes than follow
+		auto const huge = std::array<std::uint64_t, 3>{sizeof(int), sizeof(double), 0xffffffff};
+		auto oversized = std::stringstream{};
+		oversized.write("gdwg-ch1", 8);
+		oversized.write(reinterpret_cast<char const*>(huge.data()), sizeof(huge));
+		CHECK_THROWS_MATCHES(hierarchy::load(oversized), std::runtime_error, message);
+	}
+
+	SECTION("contraction_hierarchy load() rejects arcs that don't follow the ranks test") {
+		auto two = gdwg::graph<int, double>{1, 2};
+		two.insert_edge(1, 2, 1);
+		two.insert_edge(2, 1, 1);
+		auto saved = std::stringstream{};
+		gdwg::contraction_hierarchy<int, double>(two).save(saved);
+
+		// The forward arc of the node ranked 0 comes after the magic, the header, two nodes, two
+		// ranks and three offsets
+		auto const arc = std::size_t{8 + 3 * 8 + 2 * sizeof(int) + 2 * 8 + 3 * 8};
+		auto with_field = [&](std::size_t offset, std::uint64_t value) {
+			auto bytes = saved.str();
+			std::memcpy(bytes.data() + offset, &value, sizeof(value));
+			return std::stringstream(bytes);
+		};
+		auto unchanged = with_field(arc, 1);
+		CHECK(gdwg::contraction_hierarchy<int, double>::load(unchanged).shortest_path(1, 2).distance()
+		      == 1);
+
+		auto const message = Catch::Message("Cannot call gdwg::contraction_hierarchy<N, E>::load "
+		                                    "on a stream that doesn't hold a saved hierarchy of "
+		                                    "this type");
+		using hierarchy = gdwg::contraction_hierarchy<int, double>;
+		auto downward = with_field(arc, 0);
+		CHECK_THROWS_MATCHES(hierarchy::load(downward), std::runtime_error, message);
+		auto own_middle = with_field(arc + 8, 0);
+		CHECK_THROWS_MATCHES(hierarchy::load(own_middle), std::runtime_error, message);
+	}
+}
+
+TEST_CASE("contraction_hierarchy agrees with Dijkstra test") {
+	auto const road = gdwg::geometric<int, int>(1500, 3, 5, 1000.0);
+	auto const random = gdwg::erdos_renyi<int, int>(400, 1600, 3, 50);
+	auto const ch = gdwg::contraction_hierarchy<int, int>(road);
+	auto saved = std::stringstream{};
+	ch.save(saved);
+
+	// Built serially, over threads, after save() and load(), and on a graph with one-way edges.
+	// Every pair asked about has the same distance as Dijkstra on the original graph.
+	auto const cases = {std::pair{&road, ch},
+	                    std::pair{&road,
+	                              gdwg::contraction_hierarchy<int, int>(
+	                                 gdwg::csr_graph<int, int>(road), 4)},
+	                    std::pair{&road, gdwg::contraction_hierarchy<int, int>::load(saved)},
+	                    std::pair{&random, gdwg::contraction_hierarchy<int, int>(random, 2)}};
+	for (auto const& [g, hierarchy] : cases) {
+		auto const node_count = static_cast<int>(g->nodes().size());
+		for (auto src = 0; src < node_count; src += 97) {
+			auto const tree = gdwg::shortest_paths(*g, src);
+			for (auto dst = 3; dst < node_count; dst += 61) {
+				auto const result = hierarchy.shortest_path(src, dst);
+				REQUIRE(result.found() == tree.reached(dst));
+				if (!result.found())
+					continue;
+				CHECK(result.distance() == tree.distance(dst));
+				fixtures::check_path(*g, result.path(), src, dst, result.distance());
+			}
+		}
+	}
+
+	// Queries only go up the hierarchy, so settle far less than Dijkstra from both ends
+	auto settled = std::size_t{0};
+	auto bidirectional_settled = std::size_t{0};
+	for (auto src = 0; src < 1500; src += 97) {
+		settled += ch.shortest_path(src, 1499 - src).settled();
+		bidirectional_settled += gdwg::shortest_path(road, src, 1499 - src).settled();
+	}
+	CHECK(4 * settled < bidirectional_settled);
+}
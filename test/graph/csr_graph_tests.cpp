@@ -0,0 +1,165 @@
+#include "gdwg/csr_graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+
+using vt = typename gdwg::graph<int, int>::value_type;
+
+namespace {
+	auto make_graph() -> gdwg::graph<int, int> {
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5, 64};
+		g.insert_edge(4, 1, -4);
+		g.insert_edge(3, 2, 2);
+		g.insert_edge(2, 4, 2);
+		g.insert_edge(2, 1, 1);
+		g.insert_edge(2, 1, 3);
+		g.insert_edge(3, 3, 10);
+		g.insert_edge(1, 5, -1);
+		g.insert_edge(4, 5, 3);
+		return g;
+	}
+} // namespace
+
+TEST_CASE("csr_graph construction test") {
+	SECTION("csr_graph of an empty graph test") {
+		auto csr = gdwg::csr_graph<int, int>(gdwg::graph<int, int>{});
+
+		CHECK(csr.empty() == true);
+		CHECK(csr.begin() == csr.end());
+		CHECK(csr.node_count() == 0);
+		CHECK(csr.edge_count() == 0);
+		CHECK(csr == gdwg::csr_graph<int, int>{});
+	}
+
+	SECTION("csr_graph of a graph with no edges test") {
+		auto csr = gdwg::csr_graph<int, int>(gdwg::graph<int, int>{3, 1, 2});
+
+		CHECK(csr.nodes() == std::vector<int>{1, 2, 3});
+		CHECK(csr.begin() == csr.end());
+		CHECK(csr.connections(2).empty());
+	}
+
+	SECTION("csr_graph packs nodes and edges in graph order test") {
+		auto const g = make_graph();
+		auto csr = gdwg::csr_graph<int, int>(g);
+
+		CHECK(csr.nodes() == g.nodes());
+		CHECK(csr.node_count() == 6);
+		CHECK(csr.edge_count() == 8);
+		CHECK(std::vector<std::size_t>(csr.offsets().begin(), csr.offsets().end())
+		      == std::vector<std::size_t>{0, 1, 4, 6, 8, 8, 8});
+		CHECK(std::vector<std::size_t>(csr.targets().begin(), csr.targets().end())
+		      == std::vector<std::size_t>{4, 0, 0, 3, 1, 2, 0, 4});
+		CHECK(std::vector<int>(csr.edge_weights().begin(), csr.edge_weights().end())
+		      == std::vector<int>{-1, 1, 3, 2, 2, 10, -4, 3});
+	}
+}
+
+TEST_CASE("csr_graph accessors test") {
+	auto const g = make_graph();
+	auto csr = gdwg::csr_graph<int, int>(g);
+
+	SECTION("is_node() and index_of() test") {
+		CHECK(csr.is_node(64) == true);
+		CHECK(csr.is_node(6) == false);
+		CHECK(csr.index_of(4) == 3);
+		CHECK(csr.node(csr.index_of(4)) == 4);
+		CHECK(csr.index_of(6) == gdwg::csr_graph<int, int>::npos);
+	}
+
+	SECTION("is_connected() test") {
+		CHECK(csr.is_connected(2, 1) == true);
+		CHECK(csr.is_connected(3, 3) == true);
+		CHECK(csr.is_connected(1, 2) == false);
+		CHECK_THROWS_MATCHES(csr.is_connected(1, 6),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::csr_graph<N, E>::is_connected if src "
+		                                    "or dst node don't exist in the graph"));
+	}
+
+	SECTION("weights() test") {
+		CHECK(csr.weights(2, 1) == g.weights(2, 1));
+		CHECK(csr.weights(2, 1) == std::vector<int>{1, 3});
+		CHECK(csr.weights(1, 2).empty());
+		CHECK_THROWS_MATCHES(csr.weights(6, 1),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::csr_graph<N, E>::weights if src or "
+		                                    "dst node don't exist in the graph"));
+	}
+
+	SECTION("connections() test") {
+		CHECK(csr.connections(2) == g.connections(2));
+		CHECK(csr.connections(2) == std::vector<int>{1, 4});
+		CHECK(csr.connections(64).empty());
+		CHECK_THROWS_MATCHES(csr.connections(6),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::csr_graph<N, E>::connections if src "
+		                                    "doesn't exist in the graph"));
+	}
+
+	SECTION("find() test") {
+		CHECK(*csr.find(2, 1, 3) == vt(2, 1, 3));
+		CHECK(csr.find(2, 1, 2) == csr.end());
+		CHECK(csr.find(6, 1, 2) == csr.end());
+		CHECK(*++csr.find(2, 1, 3) == vt(2, 4, 2));
+	}
+}
+
+TEST_CASE("csr_graph iterator test") {
+	auto const g = make_graph();
+	auto csr = gdwg::csr_graph<int, int>(g);
+
+	SECTION("forward iteration matches graph iteration test") {
+		CHECK(std::equal(csr.begin(), csr.end(), g.begin(), g.end()));
+	}
+
+	SECTION("backward iteration matches graph iteration test") {
+		auto r = std::vector<vt>(gdwg::csr_graph<int, int>::reverse_iterator(csr.end()),
+		                         gdwg::csr_graph<int, int>::reverse_iterator(csr.begin()));
+		CHECK(std::equal(r.begin(),
+		                 r.end(),
+		                 gdwg::graph<int, int>::reverse_iterator(g.end()),
+		                 gdwg::graph<int, int>::reverse_iterator(g.begin())));
+	}
+}
+
+TEST_CASE("csr_graph transposed() test") {
+	auto const g = make_graph();
+	auto const csr = gdwg::csr_graph<int, int>(g);
+
+	SECTION("transposed() reverses every edge test") {
+		auto reversed = gdwg::graph<int, int>{1, 2, 3, 4, 5, 64};
+		for (auto const& [from, to, weight] : g) {
+			reversed.insert_edge(to, from, weight);
+		}
+		CHECK(csr.transposed() == gdwg::csr_graph<int, int>(reversed));
+	}
+
+	SECTION("transposed() twice gives the graph back test") {
+		CHECK(csr.transposed().transposed() == csr);
+	}
+}
+
+TEST_CASE("csr_graph stream output (<<) operator test") {
+	auto const g = make_graph();
+	auto csr = gdwg::csr_graph<int, int>(g);
+
+	auto expected = std::ostringstream{};
+	expected << g;
+	auto out = std::ostringstream{};
+	out << csr;
+	CHECK(out.str() == expected.str());
+}
+
+TEST_CASE("csr_graph with std::string test") {
+	auto g = gdwg::graph<std::string, std::string>{"a", "b", "c"};
+	g.insert_edge("a", "b", "x");
+	g.insert_edge("c", "a", "y");
+	auto csr = gdwg::csr_graph<std::string, std::string>(g);
+
+	CHECK(std::equal(csr.begin(), csr.end(), g.begin(), g.end()));
+	CHECK(csr.is_connected("c", "a") == true);
+	CHECK(csr.weights("a", "b") == std::vector<std::string>{"x"});
+}
@@ -0,0 +1,180 @@
+#include "gdwg/dag.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+	// Checks that every edge of g goes forwards in order, which has every node exactly once
+	template<typename N, typename E>
+	auto is_topological(gdwg::graph<N, E> const& g, std::vector<N> const& order) -> bool {
+		auto position = std::map<N, std::size_t>{};
+		for (auto i = std::size_t{0}; i < order.size(); ++i)
+			position.emplace(order[i], i);
+		auto sorted = order;
+		std::sort(sorted.begin(), sorted.end());
+		if (sorted != g.nodes())
+			return false;
+		for (auto const& [from, to, weight] : g) {
+			if (!(position[from] < position[to]))
+				return false;
+		}
+		return true;
+	}
+} // namespace
+
+TEST_CASE("topological_order() test") {
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5};
+	g.insert_edge(4, 2, 1);
+	g.insert_edge(2, 1, 1);
+	g.insert_edge(4, 3, 1);
+	g.insert_edge(3, 1, 2);
+	g.insert_edge(3, 1, 1);
+
+	SECTION("topological_order() orders edges forwards test") {
+		CHECK(gdwg::topological_order(g) == std::vector<int>{4, 5, 2, 3, 1});
+	}
+
+	SECTION("topological_order() on a csr_graph gives the same order test") {
+		CHECK(gdwg::topological_order(gdwg::csr_graph<int, int>(g)) == gdwg::topological_order(g));
+	}
+
+	SECTION("topological_order() on string nodes test") {
+		auto s = gdwg::graph<std::string, int>{"a", "b", "c"};
+		s.insert_edge("c", "a", 1);
+		s.insert_edge("b", "c", 1);
+		CHECK(gdwg::topological_order(s) == std::vector<std::string>{"b", "c", "a"});
+	}
+
+	SECTION("topological_order() on an empty graph test") {
+		CHECK(gdwg::topological_order(gdwg::graph<int, int>{}).empty());
+	}
+
+	SECTION("topological_order() throws exception test") {
+		g.insert_edge(1, 4, 1);
+		CHECK_THROWS_MATCHES(gdwg::topological_order(g),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::topological_order if the graph has a "
+		                                    "cycle"));
+		CHECK_THROWS_MATCHES(gdwg::topological_order(gdwg::csr_graph<int, int>(g)),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::topological_order if the graph has a "
+		                                    "cycle"));
+	}
+}
+
+TEST_CASE("dag<N, E> test") {
+	auto d = gdwg::dag<int, int>{1, 2, 3, 4, 5};
+
+	SECTION("dag<N, E>::insert_edge() reorders nodes test") {
+		CHECK(d.insert_edge(4, 2, 1));
+		CHECK(d.insert_edge(2, 1, 1));
+		CHECK(d.insert_edge(5, 4, 1));
+		CHECK(!d.insert_edge(5, 4, 1));
+		CHECK(d.topological_order() == std::vector<int>{5, 4, 3, 2, 1});
+		CHECK(is_topological(d.as_graph(), d.topological_order()));
+		CHECK(d.as_graph().is_connected(5, 4));
+	}
+
+	SECTION("dag<N, E>::insert_edge() rejects cycles test") {
+		d.insert_edge(1, 2, 1);
+		d.insert_edge(2, 3, 1);
+		d.insert_edge(3, 4, 1);
+		auto const before = d;
+		CHECK_THROWS_MATCHES(d.insert_edge(4, 1, 1),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::dag<N, E>::insert_edge if the edge "
+		                                    "would create a cycle"));
+		CHECK_THROWS_MATCHES(d.insert_edge(2, 2, 1),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::dag<N, E>::insert_edge if the edge "
+		                                    "would create a cycle"));
+		CHECK(d == before);
+		CHECK(d.topological_order() == before.topological_order());
+		CHECK(d.insert_edge(1, 4, 1));
+	}
+
+	SECTION("dag<N, E>::insert_edge() keeps random inserts ordered test") {
+		auto rng = std::mt19937{7};
+		auto pick = std::uniform_int_distribution<int>{0, 29};
+		auto random = gdwg::dag<int, int>{};
+		for (auto i = 0; i < 30; ++i)
+			random.insert_node(i);
+
+		auto rejected = 0;
+		for (auto i = 0; i < 300; ++i) {
+			auto const src = pick(rng);
+			auto const dst = pick(rng);
+			auto reaches = false;
+			// The edge closes a cycle exactly when dst already reaches src
+			auto copy = random.as_graph();
+			copy.insert_edge(src, dst, 0);
+			try {
+				(void)gdwg::topological_order(copy);
+			} catch (std::runtime_error const&) {
+				reaches = true;
+			}
+
+			if (reaches) {
+				CHECK_THROWS(random.insert_edge(src, dst, 0));
+				++rejected;
+			}
+			else {
+				random.insert_edge(src, dst, 0);
+			}
+			REQUIRE(is_topological(random.as_graph(), random.topological_order()));
+		}
+		CHECK(rejected > 0);
+	}
+
+	SECTION("dag<N, E> from a graph test") {
+		auto g = gdwg::graph<int, int>{1, 2, 3};
+		g.insert_edge(3, 1, 1);
+		auto from_graph = gdwg::dag<int, int>(g);
+		CHECK(from_graph.topological_order() == std::vector<int>{2, 3, 1});
+		CHECK(from_graph.as_graph() == g);
+
+		g.insert_edge(1, 3, 1);
+		CHECK_THROWS_MATCHES((gdwg::dag<int, int>(g)),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot construct gdwg::dag<N, E> from a graph with a "
+		                                    "cycle"));
+	}
+
+	SECTION("dag<N, E> modifiers keep the order test") {
+		d.insert_edge(3, 1, 1);
+		d.insert_edge(1, 2, 1);
+		CHECK(d.replace_node(1, 6));
+		CHECK(d.topological_order() == std::vector<int>{3, 6, 2, 4, 5});
+		CHECK(d.erase_edge(3, 6, 1));
+		CHECK(d.erase_node(2));
+		CHECK(!d.erase_node(2));
+		CHECK(d.topological_order() == std::vector<int>{3, 6, 4, 5});
+		d.clear();
+		CHECK(d.as_graph().empty());
+		CHECK(d.topological_order().empty());
+	}
+
+	SECTION("dag<N, E> on string nodes test") {
+		auto s = gdwg::dag<std::string, int>{"a", "b", "c"};
+		s.insert_edge("c", "a", 1);
+		s.insert_edge("b", "c", 1);
+		CHECK(s.topological_order() == std::vector<std::string>{"b", "c", "a"});
+		CHECK_THROWS(s.insert_edge("a", "b", 1));
+	}
+
+	SECTION("dag<N, E>::insert_edge() throws exception test") {
+		CHECK_THROWS_MATCHES(d.insert_edge(1, 6, 1),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::dag<N, E>::insert_edge when either src "
+		                                    "or dst node does not exist"));
+	}
+}
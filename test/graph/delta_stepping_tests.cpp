@@ -0,0 +1,153 @@
+#include "gdwg/delta_stepping.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+
+#include "graph_fixtures.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+	auto options(int delta, std::size_t threads) -> gdwg::delta_stepping_options<int> {
+		return {.delta = delta, .threads = threads};
+	}
+} // namespace
+
+TEST_CASE("delta_stepping() test") {
+	auto g = fixtures::dijkstra_example<int>();
+	g.insert_node(7);
+	g.insert_edge(7, 1, 1);
+	auto const csr = gdwg::csr_graph<int, int>(g);
+
+	SECTION("delta_stepping() distances and paths test") {
+		for (auto const& result : {gdwg::delta_stepping(g, 1),
+		                           gdwg::delta_stepping(csr, 1, options(1, 1)),
+		                           gdwg::delta_stepping(csr, 1, options(5, 3)),
+		                           gdwg::delta_stepping(csr, 1, options(100, 2))})
+		{
+			CHECK(result.source() == 1);
+			CHECK(result.distance(1) == 0);
+			CHECK(result.distance(4) == 20);
+			CHECK(result.distance(5) == 20);
+			CHECK(result.path_to(5) == std::vector<int>{1, 3, 6, 5});
+			CHECK(result.reached(7) == false);
+		}
+	}
+
+	SECTION("delta_stepping() with zero weight edges test") {
+		auto zeros = gdwg::graph<int, int>{1, 2, 3, 4};
+		zeros.insert_edge(1, 2, 3);
+		zeros.insert_edge(2, 3, 0);
+		zeros.insert_edge(3, 2, 0);
+		zeros.insert_edge(3, 4, 0);
+		zeros.insert_edge(4, 3, 0);
+
+		for (auto const threads : {std::size_t{1}, std::size_t{2}}) {
+			auto const result = gdwg::delta_stepping(zeros, 1, options(2, threads));
+			CHECK(result.distance(4) == 3);
+			CHECK(result.path_to(4) == std::vector<int>{1, 2, 3, 4});
+		}
+	}
+
+	SECTION("delta_stepping() on string nodes and double weights test") {
+		auto s = gdwg::graph<std::string, double>{"a", "b", "c"};
+		s.insert_edge("a", "b", 0.5);
+		s.insert_edge("b", "c", 0.25);
+		s.insert_edge("a", "c", 1.0);
+
+		auto const result = gdwg::delta_stepping(s, std::string("a"), {.delta = 0.3, .threads = 2});
+		CHECK(result.distance("c") == 0.75);
+		CHECK(result.path_to("c") == std::vector<std::string>{"a", "b", "c"});
+	}
+
+	SECTION("delta_stepping() with distances far beyond delta test") {
+		// Billions of buckets between the nodes, which all have to share a few slots
+		auto far = gdwg::graph<int, long long>{1, 2, 3, 4};
+		far.insert_edge(1, 2, 4000000000);
+		far.insert_edge(2, 3, 4000000000);
+		far.insert_edge(1, 4, 3);
+		far.insert_edge(4, 3, 7999999999);
+
+		for (auto const threads : {std::size_t{1}, std::size_t{2}}) {
+			auto const result = gdwg::delta_stepping(far, 1, {.delta = 1, .threads = threads});
+			CHECK(result.distance(2) == 4000000000);
+			CHECK(result.distance(3) == 8000000000);
+			CHECK(result.distance(4) == 3);
+			CHECK(result.path_to(3) == std::vector<int>{1, 2, 3});
+		}
+	}
+
+	SECTION("delta_stepping() throws exception test") {
+		CHECK_THROWS_MATCHES(gdwg::delta_stepping(csr, 8),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::delta_stepping if src doesn't exist in "
+		                                    "the graph"));
+		CHECK_THROWS_MATCHES(gdwg::delta_stepping(csr, 1, options(-1, 1)),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::delta_stepping with a negative delta"));
+
+		auto negative = g;
+		negative.insert_edge(2, 1, -1);
+		CHECK_THROWS_MATCHES(gdwg::delta_stepping(negative, 1),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::delta_stepping on a graph with negative "
+		                                    "weights"));
+	}
+}
+
+TEST_CASE("delta_stepping() agrees with shortest_paths() test") {
+	SECTION("delta_stepping() on R-MAT graphs test") {
+		auto const g = gdwg::rmat<int, int>(11, 8, 5);
+		auto const csr = gdwg::csr_graph<int, int>(g);
+		for (auto const threads : {std::size_t{1}, std::size_t{2}, std::size_t{4}}) {
+			for (auto const delta : {0, 1, 20, 1000}) {
+				auto const result = gdwg::delta_stepping(csr, 0, options(delta, threads));
+				fixtures::check_against_dijkstra(g, 0, result);
+			}
+		}
+	}
+
+	SECTION("delta_stepping() on grid graphs test") {
+		auto const g = gdwg::grid<int, int>(40, 50, 9);
+		auto const csr = gdwg::csr_graph<int, int>(g);
+		for (auto const threads : {std::size_t{1}, std::size_t{3}}) {
+			for (auto const src : {0, 1234}) {
+				auto const result = gdwg::delta_stepping(csr, src, options(0, threads));
+				fixtures::check_against_dijkstra(g, src, result);
+			}
+		}
+	}
+
+	SECTION("delta_stepping() with double weights test") {
+		auto const g = gdwg::geometric<int, double>(3000, 3, 4);
+		auto const csr = gdwg::csr_graph<int, double>(g);
+		for (auto const threads : {std::size_t{1}, std::size_t{4}}) {
+			auto const result = gdwg::delta_stepping(csr, 7, {.threads = threads});
+			fixtures::check_against_dijkstra(g, 7, result);
+		}
+	}
+
+	SECTION("delta_stepping() with a delta much smaller than the weights test") {
+		// Far more buckets than slots, so entries for later turns of the ring share slots
+		auto const g = gdwg::erdos_renyi<int, int>(300, 2000, 6, 100000);
+		auto const csr = gdwg::csr_graph<int, int>(g);
+		for (auto const threads : {std::size_t{1}, std::size_t{4}}) {
+			auto const result = gdwg::delta_stepping(csr, 0, options(7, threads));
+			fixtures::check_against_dijkstra(g, 0, result);
+		}
+	}
+
+	SECTION("delta_stepping() with few distinct weights test") {
+		// Many ties, which leave a choice of predecessors
+		auto const g = gdwg::erdos_renyi<int, int>(500, 3000, 2, 3);
+		auto const csr = gdwg::csr_graph<int, int>(g);
+		for (auto const threads : {std::size_t{1}, std::size_t{4}}) {
+			auto const result = gdwg::delta_stepping(csr, 0, options(2, threads));
+			fixtures::check_against_dijkstra(g, 0, result);
+		}
+	}
+}
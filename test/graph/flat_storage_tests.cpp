@@ -0,0 +1,191 @@
+#include "gdwg/graph.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	// Same values as int, but kept out of flat storage so both backends can be compared
+	struct tree_int {
+		int value = 0;
+
+		auto operator<=>(tree_int const&) const = default;
+
+		friend auto operator<<(std::ostream& os, tree_int const& v) -> std::ostream& {
+			return os << v.value;
+		}
+	};
+} // namespace
+
+template<>
+inline constexpr bool gdwg::enable_flat_storage<tree_int> = false;
+
+namespace {
+	using flat = gdwg::graph<int, int>;
+	using tree = gdwg::graph<tree_int, tree_int>;
+
+	template<typename G>
+	auto to_string(G const& g) -> std::string {
+		auto os = std::ostringstream{};
+		os << g;
+		return os.str();
+	}
+
+	auto in_connections(flat const& g, int dst) -> std::vector<int> {
+		return g.in_connections(dst);
+	}
+
+	auto in_connections(tree const& g, int dst) -> std::vector<int> {
+		auto v = std::vector<int>{};
+		for (auto const& src : g.in_connections(tree_int{dst})) {
+			v.push_back(src.value);
+		}
+		return v;
+	}
+} // namespace
+
+TEST_CASE("flat storage selection test") {
+	CHECK(gdwg::flat_storable<int, int>);
+	CHECK(gdwg::flat_storable<char, double>);
+	CHECK_FALSE(gdwg::flat_storable<std::string, int>);
+	CHECK_FALSE(gdwg::flat_storable<int, std::vector<int>>);
+	CHECK_FALSE(gdwg::flat_storable<tree_int, int>);
+}
+
+TEST_CASE("flat storage iterators test") {
+	auto g = flat{1, 2, 3};
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(1, 3, 7);
+	g.insert_edge(3, 1, 1);
+
+	SECTION("iterators survive a move of the graph") {
+		auto it = g.find(1, 3, 7);
+		auto moved = flat(std::move(g));
+		CHECK(*it == gdwg::graph_value_type<int, int>{1, 3, 7});
+		CHECK(++it == moved.find(3, 1, 1));
+	}
+
+	SECTION("iterators find their edge again after inserts before it") {
+		auto it = g.find(3, 1, 1);
+		g.insert_node(0);
+		g.insert_edge(0, 1, 4);
+		g.insert_edge(1, 2, 4);
+		CHECK(it == g.find(3, 1, 1));
+		CHECK(--it == g.find(1, 3, 7));
+	}
+
+	SECTION("iterators to an erased edge move on to the next edge") {
+		auto it = g.find(1, 3, 7);
+		g.erase_edge(1, 3, 7);
+		CHECK(++it == g.end());
+	}
+}
+
+TEST_CASE("flat storage matches tree storage test") {
+	auto rng = std::mt19937(1337);
+	auto value = std::uniform_int_distribution<int>(0, 15);
+	auto op = std::uniform_int_distribution<int>(0, 13);
+
+	auto f = flat{};
+	auto t = tree{};
+	for (auto step = 0; step < 4000; ++step) {
+		auto a = value(rng);
+		auto b = value(rng);
+		auto w = value(rng);
+		auto ta = tree_int{a};
+		auto tb = tree_int{b};
+		switch (op(rng)) {
+		case 0:
+		case 1: CHECK(f.insert_node(a) == t.insert_node(ta)); break;
+		case 2:
+		case 3:
+		case 4:
+			if (f.is_node(a) && f.is_node(b)) {
+				CHECK(f.insert_edge(a, b, w) == t.insert_edge(ta, tb, tree_int{w}));
+			}
+			break;
+		case 5:
+			if (f.is_node(a) && f.is_node(b)) {
+				CHECK(f.erase_edge(a, b, w) == t.erase_edge(ta, tb, tree_int{w}));
+			}
+			break;
+		case 6: CHECK(f.erase_node(a) == t.erase_node(ta)); break;
+		case 7:
+			if (f.is_node(a)) {
+				CHECK(f.replace_node(a, b) == t.replace_node(ta, tb));
+			}
+			break;
+		case 8:
+			if (f.is_node(a) && f.is_node(b)) {
+				f.merge_replace_node(a, b);
+				t.merge_replace_node(ta, tb);
+			}
+			break;
+		case 9:
+			if (auto nodes = f.nodes(); nodes.size() > 1) {
+				auto pick = std::uniform_int_distribution<std::size_t>(0, nodes.size() - 1);
+				auto f_edges = std::vector<gdwg::graph_value_type<int, int>>{};
+				auto t_edges = std::vector<gdwg::graph_value_type<tree_int, tree_int>>{};
+				for (auto e = 0; e < 8; ++e) {
+					auto from = nodes[pick(rng)];
+					auto to = nodes[pick(rng)];
+					auto weight = value(rng);
+					f_edges.emplace_back(from, to, weight);
+					t_edges.emplace_back(tree_int{from}, tree_int{to}, tree_int{weight});
+				}
+				CHECK(f.insert_edges(f_edges.begin(), f_edges.end())
+				      == t.insert_edges(t_edges.begin(), t_edges.end()));
+			}
+			break;
+		case 10:
+			CHECK(f.erase_nodes(std::vector<int>{a, b})
+			      == t.erase_nodes(std::vector<tree_int>{ta, tb}));
+			break;
+		case 11:
+			CHECK(f.erase_nodes_if([&](int n) { return (n + a) % 7 == 0; })
+			      == t.erase_nodes_if([&](tree_int const& n) { return (n.value + a) % 7 == 0; }));
+			break;
+		case 12: {
+			// Copies have to be independent of the graphs they came from
+			auto f_copy = f;
+			auto t_copy = t;
+			REQUIRE(to_string(f_copy) == to_string(t_copy));
+			REQUIRE(to_string(t_copy) == to_string(t));
+			t_copy.clear();
+			f_copy.clear();
+			CHECK(t_copy.empty());
+			CHECK(to_string(f_copy) == to_string(t_copy));
+			CHECK(t_copy.insert_node(ta));
+			break;
+		}
+		default:
+			if (auto f_it = f.find(a, b, w); f_it != f.end()) {
+				f_it = f.erase_edge(f_it);
+				auto t_it = t.erase_edge(t.find(ta, tb, tree_int{w}));
+				REQUIRE((f_it == f.end()) == (t_it == t.end()));
+				if (f_it != f.end()) {
+					auto const [from, to, weight] = *t_it;
+					CHECK(*f_it == gdwg::graph_value_type<int, int>{from.value, to.value, weight.value});
+				}
+			}
+			break;
+		}
+
+		if (step % 1000 == 999) {
+			f.clear();
+			t.clear();
+			CHECK(t.empty());
+		}
+
+		REQUIRE(to_string(f) == to_string(t));
+		if (f.is_node(b)) {
+			REQUIRE(in_connections(f, b) == in_connections(t, b));
+			CHECK(f.in_degree(b) == t.in_degree(tb));
+		}
+	}
+}
@@ -68,4 +68,87 @@ TEST_CASE("stream output (<<) operator tests") {
 
 		CHECK(out.str() == expected_output);
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("print_edges() test") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+	g.insert_edge(1, 2, 4);
+	g.insert_edge(2, 1, 1);
+	g.insert_edge(2, 3, 2);
+	g.insert_edge(2, 3, 1);
+
+	auto out = std::ostringstream{};
+	print_edges(2, out, g);
+	CHECK(out.str() == "  1 | 1\n  3 | 1\n  3 | 2\n");
+
+	out.str("");
+	print_edges(3, out, g);
+	CHECK(out.str() == "");
+}
+
+TEST_CASE("buffered_writer output tests") {
+	SECTION("write() matches << operator test") {
+		auto g = gdwg::graph<int, int>{1, 2, 3, 64};
+		g.insert_edge(1, 2, -4);
+		g.insert_edge(2, 2, 7);
+		g.insert_edge(3, 1, 10);
+		g.insert_edge(3, 1, 2);
+
+		auto expected = std::ostringstream{};
+		expected << g;
+
+		auto out = std::ostringstream{};
+		{
+			auto writer = gdwg::buffered_writer(out);
+			g.write(writer);
+		}
+		CHECK(out.str() == expected.str());
+	}
+
+	SECTION("write() flushes in blocks and on flush() test") {
+		auto g = gdwg::graph<int, int>{1, 2};
+		g.insert_edge(1, 2, 3);
+
+		auto expected = std::ostringstream{};
+		expected << g << g;
+
+		auto out = std::ostringstream{};
+		auto writer = gdwg::buffered_writer(out, 4);
+		g.write(writer);
+		CHECK(out.str().size() >= 4);
+		g.write(writer);
+		writer.flush();
+		CHECK(out.str() == expected.str());
+	}
+
+	SECTION("write() formats floating point like std::ostream test") {
+		auto g = gdwg::graph<double, double>{0.1, 2.5, 1e10};
+		g.insert_edge(0.1, 2.5, 1.0 / 3.0);
+		g.insert_edge(1e10, 0.1, -0.0001234);
+
+		auto expected = std::ostringstream{};
+		expected << g;
+
+		auto out = std::ostringstream{};
+		{
+			auto writer = gdwg::buffered_writer(out);
+			g.write(writer);
+		}
+		CHECK(out.str() == expected.str());
+	}
+
+	SECTION("write() formats non-arithmetic types through operator<< test") {
+		auto g = gdwg::graph<std::string, std::vector<int>>{"a", "b"};
+		g.insert_edge("a", "b", std::vector<int>{1, 2});
+
+		auto expected = std::ostringstream{};
+		expected << g;
+
+		auto out = std::ostringstream{};
+		{
+			auto writer = gdwg::buffered_writer(out);
+			g.write(writer);
+		}
+		CHECK(out.str() == expected.str());
+	}
+}
@@ -0,0 +1,138 @@
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+namespace {
+	template<typename N, typename E>
+	auto edge_count(gdwg::graph<N, E> const& g) -> std::size_t {
+		return static_cast<std::size_t>(std::distance(g.begin(), g.end()));
+	}
+} // namespace
+
+TEST_CASE("erdos_renyi() test") {
+	auto g = gdwg::erdos_renyi<int, int>(100, 400, 7);
+
+	SECTION("erdos_renyi() is deterministic for a seed test") {
+		CHECK(g == gdwg::erdos_renyi<int, int>(100, 400, 7));
+		CHECK_FALSE(g == gdwg::erdos_renyi<int, int>(100, 400, 8));
+	}
+
+	SECTION("erdos_renyi() keeps isolated nodes and has no self-loops test") {
+		CHECK(g.nodes().size() == 100);
+		CHECK(edge_count(g) <= 400);
+		CHECK(edge_count(g) > 390);
+		for (auto const& [from, to, weight] : g) {
+			CHECK(from != to);
+			CHECK(weight >= 1);
+			CHECK(weight <= 100);
+		}
+	}
+
+	SECTION("erdos_renyi() with character weights test") {
+		auto const small = gdwg::erdos_renyi<int, unsigned char>(20, 50, 7, 9);
+		for (auto const& [from, to, weight] : small) {
+			CHECK(weight >= 1);
+			CHECK(weight <= 9);
+		}
+	}
+
+	SECTION("erdos_renyi() throws exception test") {
+		CHECK_THROWS_MATCHES((gdwg::erdos_renyi<int, int>(1, 1, 7)),
+		                     std::invalid_argument,
+		                     Catch::Message("Cannot call gdwg::erdos_renyi with edges on fewer than two "
+		                                    "nodes"));
+	}
+}
+
+TEST_CASE("barabasi_albert() test") {
+	auto g = gdwg::barabasi_albert<int, double>(500, 3, 11, 1.0);
+
+	SECTION("barabasi_albert() adds edges_per_node edges per node test") {
+		CHECK(g.nodes().size() == 500);
+		CHECK(edge_count(g) == 4 + (500 - 4) * 3);
+		CHECK(g.connections(499).size() == 3);
+	}
+
+	SECTION("barabasi_albert() attaches preferentially test") {
+		auto max_in_degree = std::size_t{0};
+		for (auto n : g.nodes()) {
+			max_in_degree = std::max(max_in_degree, g.in_degree(n));
+		}
+		CHECK(max_in_degree > 30);
+	}
+
+	SECTION("barabasi_albert() throws exception test") {
+		CHECK_THROWS_MATCHES((gdwg::barabasi_albert<int, int>(3, 3, 11)),
+		                     std::invalid_argument,
+		                     Catch::Message("Cannot call gdwg::barabasi_albert with edges_per_node == 0 "
+		                                    "or not fewer than node_count"));
+	}
+}
+
+TEST_CASE("rmat() test") {
+	auto g = gdwg::rmat<int, int>(8, 8, 3);
+
+	CHECK(g.nodes().size() == 256);
+	CHECK(edge_count(g) <= 256 * 8);
+	CHECK(g == gdwg::rmat<int, int>(8, 8, 3));
+	CHECK_THROWS_MATCHES((gdwg::rmat<int, int>(8, 8, 3, {0.5, 0.5, 0.5})),
+	                     std::invalid_argument,
+	                     Catch::Message("Cannot call gdwg::rmat with quadrant probabilities that aren't "
+	                                    "a distribution"));
+}
+
+TEST_CASE("grid() test") {
+	auto g = gdwg::grid<int, int>(3, 4, 5);
+
+	CHECK(g.nodes().size() == 12);
+	CHECK(edge_count(g) == 2 * (3 * 3 + 2 * 4));
+	CHECK(g.connections(0) == std::vector<int>{1, 4});
+	CHECK(g.connections(5) == std::vector<int>{1, 4, 6, 9});
+	CHECK(g.in_connections(11) == std::vector<int>{7, 10});
+}
+
+TEST_CASE("geometric() test") {
+	auto const points = gdwg::random_points(300, 13);
+	auto g = gdwg::geometric<int, long>(points, 3);
+
+	SECTION("geometric() joins every point to at least its k nearest test") {
+		CHECK(g.nodes().size() == 300);
+		for (auto n : g.nodes()) {
+			CHECK(g.connections(n).size() >= 3);
+		}
+	}
+
+	SECTION("geometric() edges go both ways with the distance as weight test") {
+		for (auto const& [from, to, weight] : g) {
+			CHECK(g.weights(to, from) == std::vector<long>{weight});
+		}
+	}
+
+	SECTION("geometric() joins each point to its nearest points test") {
+		auto const& p = points[0];
+		auto by_distance = std::vector<int>(points.size() - 1);
+		std::iota(by_distance.begin(), by_distance.end(), 1);
+		std::sort(by_distance.begin(), by_distance.end(), [&](int a, int b) {
+			return std::hypot(points[a].x - p.x, points[a].y - p.y)
+			       < std::hypot(points[b].x - p.x, points[b].y - p.y);
+		});
+
+		auto const neighbours = g.connections(0);
+		for (auto i = 0; i < 3; ++i) {
+			CHECK(std::binary_search(neighbours.begin(), neighbours.end(), by_distance[i]));
+		}
+	}
+
+	SECTION("geometric() with k == 0 has no edges test") {
+		auto const unconnected = gdwg::geometric<int, int>(50, 0, 1, 10.0);
+		CHECK(unconnected.nodes().size() == 50);
+		CHECK(edge_count(unconnected) == 0);
+	}
+}
@@ -0,0 +1,87 @@
+#ifndef GDWG_TEST_GRAPH_FIXTURES_HPP
+#define GDWG_TEST_GRAPH_FIXTURES_HPP
+
+#include "gdwg/graph.hpp"
+#include "gdwg/shortest_paths.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+// Helpers shared by the graph algorithm tests
+namespace fixtures {
+	// The usual Dijkstra example. The shortest path from 1 to 5 is 1, 3, 6, 5 at a distance of 20,
+	// which ties with 1, 3, 4, 5 and beats the direct 6 -> 5 edge of weight 20.
+	template<typename E>
+	auto dijkstra_example() -> gdwg::graph<int, E> {
+		auto g = gdwg::graph<int, E>{1, 2, 3, 4, 5, 6};
+		g.insert_edge(1, 2, 7);
+		g.insert_edge(1, 3, 9);
+		g.insert_edge(1, 6, 14);
+		g.insert_edge(2, 3, 10);
+		g.insert_edge(2, 4, 15);
+		g.insert_edge(3, 4, 11);
+		g.insert_edge(3, 6, 2);
+		g.insert_edge(4, 5, 6);
+		g.insert_edge(6, 5, 9);
+		g.insert_edge(6, 5, 20);
+		return g;
+	}
+
+	// Checks that path runs from src to dst along edges of g whose weights add up to distance
+	template<typename E>
+	auto check_path(gdwg::graph<int, E> const& g,
+	                std::vector<int> const& path,
+	                int src,
+	                int dst,
+	                E distance) -> void {
+		REQUIRE(!path.empty());
+		REQUIRE(path.front() == src);
+		REQUIRE(path.back() == dst);
+		auto total = E{};
+		for (auto i = std::size_t{1}; i < path.size(); ++i)
+			total += g.weights(path[i - 1], path[i]).front();
+		CHECK(total == distance);
+	}
+
+	// Checks a search from src against Dijkstra on g: the same nodes reached at the same
+	// distances, with paths that add up to them
+	template<typename E>
+	auto check_against_dijkstra(gdwg::graph<int, E> const& g,
+	                            int src,
+	                            gdwg::shortest_paths_result<int, E> const& result) -> void {
+		auto const expected = gdwg::shortest_paths(g, src);
+		for (auto const v : g.nodes()) {
+			REQUIRE(result.reached(v) == expected.reached(v));
+			if (!result.reached(v))
+				continue;
+			CHECK(result.distance(v) == expected.distance(v));
+			check_path(g, result.path_to(v), src, v, result.distance(v));
+		}
+	}
+
+	// Shortest distances from src by relaxing every edge until nothing changes, as a slow but
+	// plain answer to check faster searches against. Nodes have to be 0 .. n - 1, and no cycle
+	// may have a negative weight.
+	inline auto reference_distances(gdwg::graph<int, int> const& g, int src)
+	   -> std::vector<std::optional<int>> {
+		auto dist = std::vector<std::optional<int>>(g.nodes().size());
+		dist[static_cast<std::size_t>(src)] = 0;
+		for (auto changed = true; changed;) {
+			changed = false;
+			for (auto const& [from, to, weight] : g) {
+				auto& d = dist[static_cast<std::size_t>(to)];
+				auto const& f = dist[static_cast<std::size_t>(from)];
+				if (f && (!d || *f + weight < *d)) {
+					d = *f + weight;
+					changed = true;
+				}
+			}
+		}
+		return dist;
+	}
+} // namespace fixtures
+
+#endif // GDWG_TEST_GRAPH_FIXTURES_HPP
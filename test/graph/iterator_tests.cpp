@@ -1,7 +1,13 @@
 #include "gdwg/graph.hpp"
 
+#include "gdwg/csr_graph.hpp"
+
 #include <catch2/catch.hpp>
 
+#include <iterator>
+#include <string>
+#include <vector>
+
 using vt = typename gdwg::graph<int, int>::value_type;
 
 TEST_CASE("Creating iterators through begin and end graph functions") {
@@ -288,3 +294,53 @@ TEST_CASE("Graph iterator operator--(int) test") {
 		CHECK(it == g.begin());
 	}
 }
+
+TEST_CASE("Graph iterator dereference refers into the graph test") {
+	static_assert(std::bidirectional_iterator<gdwg::graph<std::string, std::string>::iter>);
+	static_assert(std::bidirectional_iterator<gdwg::graph<int, int>::iter>);
+	static_assert(std::bidirectional_iterator<gdwg::csr_graph<std::string, int>::iter>);
+
+	auto g = gdwg::graph<std::string, std::string>{"a", "b"};
+	g.insert_edge("a", "b", "x");
+	g.insert_edge("b", "b", "y");
+	auto const& c = g;
+
+	SECTION("from, to and weight are the graph's own values test") {
+		auto const first = *c.begin();
+		auto const again = *c.begin();
+		CHECK(&first.from == &again.from);
+		CHECK(&first.to == &again.to);
+		CHECK(&first.weight == &again.weight);
+		CHECK(&first.to == &(*++c.begin()).from);
+		CHECK(&first.weight == &c.weights_view("a", "b").front());
+	}
+
+	SECTION("structured bindings test") {
+		auto const& [from, to, weight] = *c.begin();
+		CHECK(from == "a");
+		CHECK(to == "b");
+		CHECK(weight == "x");
+	}
+
+	SECTION("conversion to value_type outlives the graph test") {
+		auto copy = typename gdwg::graph<std::string, std::string>::value_type{};
+		{
+			auto h = g;
+			copy = *h.begin();
+		}
+		CHECK(copy.from == "a");
+		CHECK(copy.to == "b");
+		CHECK(copy.weight == "x");
+
+		auto const edges = std::vector<gdwg::graph<std::string, std::string>::value_type>(c.begin(),
+		                                                                                  c.end());
+		REQUIRE(edges.size() == 2);
+		CHECK(edges[1].from == "b");
+	}
+
+	SECTION("csr graphs refer into their storage test") {
+		auto const csr = gdwg::csr_graph<std::string, std::string>(g);
+		CHECK(&(*csr.begin()).from == &(*csr.begin()).from);
+		CHECK(*csr.begin() == *c.begin());
+	}
+}
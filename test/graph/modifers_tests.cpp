@@ -680,4 +680,147 @@ TEST_CASE("replace_merge_node() test") {
 		CHECK(vt(3, 3, 8) == *++it);
 		CHECK(g.end() == ++it);
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("modifiers keep in_connections() in sync test") {
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4};
+	g.insert_edge(1, 2, 5);
+	g.insert_edge(1, 2, 6);
+	g.insert_edge(3, 2, 1);
+	g.insert_edge(2, 2, 1);
+	g.insert_edge(2, 4, 1);
+
+	SECTION("erase_edge() removes src once its last weight is erased test") {
+		CHECK(g.erase_edge(1, 2, 5) == true);
+		CHECK(g.in_connections(2) == std::vector<int>{1, 2, 3});
+
+		CHECK(g.erase_edge(1, 2, 6) == true);
+		CHECK(g.in_connections(2) == std::vector<int>{2, 3});
+
+		g.erase_edge(g.find(3, 2, 1));
+		CHECK(g.in_connections(2) == std::vector<int>{2});
+	}
+
+	SECTION("erase_node() removes incoming and outgoing edges test") {
+		CHECK(g.erase_node(2) == true);
+		CHECK(g.in_connections(4) == std::vector<int>{});
+		CHECK(g.begin() == g.end());
+
+		CHECK(g.erase_node(4) == true);
+		CHECK(g.in_connections(1) == std::vector<int>{});
+	}
+
+	SECTION("replace_node() renames src and dst in reverse index test") {
+		CHECK(g.replace_node(2, 5) == true);
+		CHECK(g.in_connections(5) == std::vector<int>{1, 3, 5});
+		CHECK(g.in_connections(4) == std::vector<int>{5});
+		CHECK(g.in_degree(5) == 4);
+	}
+
+	SECTION("merge_replace_node() merges incoming edges test") {
+		g.merge_replace_node(2, 4);
+		CHECK(g.in_connections(4) == std::vector<int>{1, 3, 4});
+		CHECK(g.in_degree(4) == 4);
+
+		// edges moved onto 4 must follow it when it is renamed later
+		CHECK(g.replace_node(4, 0) == true);
+		CHECK(g.in_connections(0) == std::vector<int>{0, 1, 3});
+		CHECK(g.connections(1) == std::vector<int>{0});
+		CHECK(g.is_connected(0, 0) == true);
+	}
+
+	SECTION("clear() empties reverse index test") {
+		g.clear();
+		g.insert_node(2);
+		CHECK(g.in_connections(2) == std::vector<int>{});
+	}
+}
+
+TEST_CASE("insert_edges() test") {
+	auto g = gdwg::graph<int, int>{1, 2, 3};
+
+	SECTION("insert_edges() throws exception test") {
+		auto const edges = std::vector<vt>{{1, 2, 3}, {1, 4, 3}};
+		CHECK_THROWS_MATCHES(g.insert_edges(edges.begin(), edges.end()),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::graph<N, E>::insert_edges when either "
+		                                    "src or dst node does not exist"));
+		CHECK(g.begin() == g.end());
+	}
+
+	SECTION("insert_edges() merges with existing edges test") {
+		g.insert_edge(1, 2, 5);
+		g.insert_edge(3, 1, 1);
+
+		auto const edges = std::vector<vt>{{3, 1, 1}, {1, 2, 4}, {2, 2, 7}, {1, 2, 4}, {1, 2, 5}};
+		CHECK(g.insert_edges(edges.begin(), edges.end()) == 2);
+
+		auto it = g.begin();
+		CHECK(vt(1, 2, 4) == *it);
+		CHECK(vt(1, 2, 5) == *++it);
+		CHECK(vt(2, 2, 7) == *++it);
+		CHECK(vt(3, 1, 1) == *++it);
+		CHECK(g.end() == ++it);
+		CHECK(g.in_connections(2) == std::vector<int>{1, 2});
+
+		CHECK(g.insert_edges(edges.begin(), edges.end()) == 0);
+	}
+
+	SECTION("insert_edges() with no edges test") {
+		auto const edges = std::vector<vt>{};
+		CHECK(g.insert_edges(edges.begin(), edges.end()) == 0);
+
+		auto empty = gdwg::graph<int, int>{};
+		CHECK(empty.insert_edges(edges.begin(), edges.end()) == 0);
+		CHECK(empty.empty());
+	}
+}
+
+TEST_CASE("erase_nodes() and erase_nodes_if() test") {
+	auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5, 6};
+	g.insert_edge(1, 2, 7);
+	g.insert_edge(2, 1, 7);
+	g.insert_edge(2, 2, 9);
+	g.insert_edge(2, 3, 9);
+	g.insert_edge(3, 1, 9);
+	g.insert_edge(6, 1, 1);
+	g.insert_edge(6, 4, 1);
+
+	SECTION("erase_nodes() with no matching nodes test") {
+		CHECK(g.erase_nodes(std::vector<int>{7, 8}) == 0);
+		CHECK(g.nodes() == std::vector<int>{1, 2, 3, 4, 5, 6});
+	}
+
+	SECTION("erase_nodes() erases nodes and their incident edges test") {
+		CHECK(g.erase_nodes(std::vector<int>{2, 4, 7}) == 2);
+		CHECK(g.nodes() == std::vector<int>{1, 3, 5, 6});
+
+		auto it = g.begin();
+		CHECK(vt(3, 1, 9) == *it);
+		CHECK(vt(6, 1, 1) == *++it);
+		CHECK(g.end() == ++it);
+
+		CHECK(g.in_connections(1) == std::vector<int>{3, 6});
+		CHECK(g.in_connections(3) == std::vector<int>{});
+		CHECK(g.insert_edge(1, 3, 9) == true);
+		CHECK(g.weights(1, 3) == std::vector<int>{9});
+	}
+
+	SECTION("erase_nodes_if() erases nodes matching predicate test") {
+		CHECK(g.erase_nodes_if([](int n) { return n % 2 == 1; }) == 3);
+		CHECK(g.nodes() == std::vector<int>{2, 4, 6});
+
+		auto it = g.begin();
+		CHECK(vt(2, 2, 9) == *it);
+		CHECK(vt(6, 4, 1) == *++it);
+		CHECK(g.end() == ++it);
+
+		CHECK(g.in_connections(2) == std::vector<int>{2});
+		CHECK(g.in_connections(4) == std::vector<int>{6});
+	}
+
+	SECTION("erase_nodes_if() erasing every node test") {
+		CHECK(g.erase_nodes_if([](int) { return true; }) == 6);
+		CHECK(g == gdwg::graph<int, int>{});
+	}
+}
@@ -0,0 +1,176 @@
+#include "gdwg/pagerank.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+	// 1 -> 2 -> 3 -> 1, 1 -> 3, 4 -> 3 and 5 with no out-edges
+	auto make_graph() -> gdwg::graph<int, int> {
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5};
+		g.insert_edge(1, 2, 1);
+		g.insert_edge(2, 3, 2);
+		g.insert_edge(3, 1, 1);
+		g.insert_edge(1, 3, 3);
+		g.insert_edge(4, 3, 5);
+		g.insert_edge(3, 5, 1);
+		return g;
+	}
+
+	// Plain dense power iteration to check against
+	auto reference(gdwg::graph<int, int> const& g, bool weighted, std::vector<double> jump)
+	   -> std::vector<double> {
+		auto const nodes = g.nodes();
+		auto const n = nodes.size();
+		auto index = [&](int value) {
+			return static_cast<std::size_t>(std::lower_bound(nodes.begin(), nodes.end(), value)
+			                                - nodes.begin());
+		};
+		auto matrix = std::vector<std::vector<double>>(n, std::vector<double>(n, 0.0));
+		auto out = std::vector<double>(n, 0.0);
+		for (auto const& [from, to, weight] : g) {
+			auto const w = weighted ? static_cast<double>(weight) : 1.0;
+			matrix[index(to)][index(from)] += w;
+			out[index(from)] += w;
+		}
+
+		auto scores = jump;
+		for (auto iteration = 0; iteration < 1000; ++iteration) {
+			auto dangling = 0.0;
+			for (auto u = std::size_t{0}; u < n; ++u) {
+				if (out[u] == 0.0)
+					dangling += scores[u];
+			}
+			auto next = std::vector<double>(n, 0.0);
+			for (auto v = std::size_t{0}; v < n; ++v) {
+				next[v] = (0.15 + 0.85 * dangling) * jump[v];
+				for (auto u = std::size_t{0}; u < n; ++u) {
+					if (out[u] != 0.0)
+						next[v] += 0.85 * matrix[v][u] / out[u] * scores[u];
+				}
+			}
+			scores = next;
+		}
+		return scores;
+	}
+
+	auto tight() -> gdwg::pagerank_options<int> {
+		auto options = gdwg::pagerank_options<int>{};
+		options.tolerance = 1e-13;
+		options.max_iterations = 1000;
+		return options;
+	}
+
+	auto check_scores(std::span<double const> scores, std::vector<double> const& expected) -> void {
+		REQUIRE(scores.size() == expected.size());
+		for (auto i = std::size_t{0}; i < expected.size(); ++i)
+			CHECK(scores[i] == Approx(expected[i]).margin(1e-10));
+	}
+} // namespace
+
+TEST_CASE("pagerank() test") {
+	auto const g = make_graph();
+
+	SECTION("pagerank() splits along edge weights test") {
+		auto const result = gdwg::pagerank(g, tight());
+		CHECK(result.converged());
+		check_scores(result.scores(), reference(g, true, std::vector<double>(5, 0.2)));
+		CHECK(std::accumulate(result.scores().begin(), result.scores().end(), 0.0)
+		      == Approx(1.0));
+		CHECK(result.score(3) > result.score(4));
+	}
+
+	SECTION("pagerank() without weights test") {
+		auto options = tight();
+		options.weighted = false;
+		auto const result = gdwg::pagerank(g, options);
+		check_scores(result.scores(), reference(g, false, std::vector<double>(5, 0.2)));
+	}
+
+	SECTION("pagerank() of a cycle is uniform test") {
+		auto cycle = gdwg::graph<std::string, std::string>{"a", "b", "c"};
+		cycle.insert_edge("a", "b", "x");
+		cycle.insert_edge("b", "c", "y");
+		cycle.insert_edge("c", "a", "z");
+		auto const result = gdwg::pagerank(cycle);
+		CHECK(result.score("a") == Approx(1.0 / 3));
+		CHECK(result.score("b") == Approx(1.0 / 3));
+		CHECK(result.score("c") == Approx(1.0 / 3));
+	}
+
+	SECTION("pagerank() with personalization test") {
+		auto options = tight();
+		options.personalization = {{1, 3.0}, {4, 1.0}};
+		auto const result = gdwg::pagerank(g, options);
+		check_scores(result.scores(), reference(g, true, {0.75, 0.0, 0.0, 0.25, 0.0}));
+		CHECK(result.score(2) > 0.0);
+	}
+
+	SECTION("pagerank() on a csr_graph gives the same scores test") {
+		auto const result = gdwg::pagerank(gdwg::csr_graph<int, int>(g), tight());
+		check_scores(result.scores(), reference(g, true, std::vector<double>(5, 0.2)));
+	}
+
+	SECTION("pagerank() on several threads gives the same scores test") {
+		auto const big = gdwg::rmat<int, int>(10, 8, 42);
+		auto options = tight();
+		auto const one = gdwg::pagerank(big, options);
+		options.threads = 3;
+		auto const three = gdwg::pagerank(big, options);
+		check_scores(three.scores(), std::vector<double>(one.scores().begin(), one.scores().end()));
+	}
+
+	SECTION("pagerank() stops at max_iterations test") {
+		auto options = gdwg::pagerank_options<int>{};
+		options.max_iterations = 2;
+		auto const result = gdwg::pagerank(g, options);
+		CHECK(result.iterations() == 2);
+		CHECK(!result.converged());
+	}
+
+	SECTION("pagerank() on an empty graph test") {
+		auto const result = gdwg::pagerank(gdwg::graph<int, int>{});
+		CHECK(result.scores().empty());
+	}
+
+	SECTION("pagerank() throws exception test") {
+		auto options = gdwg::pagerank_options<int>{};
+		options.damping = 1.5;
+		CHECK_THROWS_MATCHES(gdwg::pagerank(g, options),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::pagerank with a damping factor outside "
+		                                    "[0, 1]"));
+
+		options = gdwg::pagerank_options<int>{};
+		options.personalization = {{6, 1.0}};
+		CHECK_THROWS_MATCHES(gdwg::pagerank(g, options),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::pagerank with a personalization entry "
+		                                    "that isn't a node with a weight >= 0"));
+
+		options.personalization = {{1, 0.0}};
+		CHECK_THROWS_MATCHES(gdwg::pagerank(g, options),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::pagerank with personalization weights "
+		                                    "that add up to 0"));
+
+		auto negative = make_graph();
+		negative.insert_edge(5, 1, -1);
+		CHECK_THROWS_MATCHES(gdwg::pagerank(negative),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::pagerank with negative edge weights"));
+
+		CHECK_THROWS_MATCHES(gdwg::pagerank(g).score(6),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::pagerank_result<N>::score on a node "
+		                                    "that doesn't exist in the graph"));
+	}
+}
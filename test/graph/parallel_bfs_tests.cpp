@@ -0,0 +1,113 @@
+#include "gdwg/parallel_bfs.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+#include "gdwg/traversal.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace {
+	constexpr auto npos = gdwg::csr_graph<int, int>::npos;
+
+	// Depth of every node from src by the sequential bfs, npos where it isn't reached
+	auto reference_depths(gdwg::csr_graph<int, int> const& g, int src) -> std::vector<std::size_t> {
+		struct depths {
+			gdwg::csr_graph<int, int> const& g;
+			std::vector<std::size_t> depth;
+
+			auto tree_edge(int from, int to, int) -> void {
+				depth[g.index_of(to)] = depth[g.index_of(from)] + 1;
+			}
+		};
+		auto vis = depths{g, std::vector<std::size_t>(g.node_count(), npos)};
+		vis.depth[g.index_of(src)] = 0;
+		gdwg::bfs(g, src, vis);
+		return vis.depth;
+	}
+
+	// parents has to reach exactly the nodes bfs does, and every parent has to be an edge from one
+	// level up
+	auto check_parents(gdwg::csr_graph<int, int> const& g,
+	                   int src,
+	                   std::vector<std::size_t> const& parents) -> void {
+		auto const depth = reference_depths(g, src);
+		REQUIRE(parents.size() == g.node_count());
+		CHECK(parents[g.index_of(src)] == g.index_of(src));
+
+		auto mismatches = 0;
+		for (auto v = std::size_t{0}; v < g.node_count(); ++v) {
+			if ((parents[v] == npos) != (depth[v] == npos)) {
+				++mismatches;
+				continue;
+			}
+			if (parents[v] == npos || v == g.index_of(src))
+				continue;
+
+			auto const p = parents[v];
+			auto const targets = g.targets();
+			auto const edge = std::find(targets.begin() + static_cast<std::ptrdiff_t>(g.offsets()[p]),
+			                            targets.begin() + static_cast<std::ptrdiff_t>(g.offsets()[p + 1]),
+			                            v);
+			if (edge == targets.begin() + static_cast<std::ptrdiff_t>(g.offsets()[p + 1])
+			    || depth[p] + 1 != depth[v])
+			{
+				++mismatches;
+			}
+		}
+		CHECK(mismatches == 0);
+	}
+} // namespace
+
+TEST_CASE("parallel_bfs() test") {
+	SECTION("parallel_bfs() on a small graph test") {
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5, 6};
+		g.insert_edge(1, 2, 1);
+		g.insert_edge(1, 3, 1);
+		g.insert_edge(2, 4, 1);
+		g.insert_edge(3, 4, 1);
+		g.insert_edge(4, 5, 1);
+		g.insert_edge(5, 1, 1);
+		auto const csr = gdwg::csr_graph<int, int>(g);
+
+		auto const parents = gdwg::parallel_bfs(csr, 2, 2);
+		CHECK(parents == std::vector<std::size_t>{4, 1, 0, 1, 3, npos});
+	}
+
+	SECTION("parallel_bfs() on a skewed graph, where it goes bottom-up test") {
+		auto const csr = gdwg::csr_graph<int, int>(gdwg::rmat<int, int>(12, 8, 3));
+		auto const reverse = csr.transposed();
+		auto hub = std::size_t{0};
+		for (auto u = std::size_t{0}; u < csr.node_count(); ++u) {
+			if (csr.offsets()[u + 1] - csr.offsets()[u] > csr.offsets()[hub + 1] - csr.offsets()[hub])
+				hub = u;
+		}
+
+		for (auto threads : {1, 2, 4}) {
+			check_parents(csr, csr.node(hub), gdwg::parallel_bfs(csr, reverse, csr.node(hub), threads));
+			check_parents(csr, 100, gdwg::parallel_bfs(csr, reverse, 100, threads));
+		}
+	}
+
+	SECTION("parallel_bfs() on a road-like graph test") {
+		auto const csr = gdwg::csr_graph<int, int>(gdwg::geometric<int, int>(3000, 3, 7));
+		for (auto threads : {1, 3}) {
+			check_parents(csr, 0, gdwg::parallel_bfs(csr, 0, threads));
+		}
+	}
+
+	SECTION("parallel_bfs() throws exception test") {
+		auto const csr = gdwg::csr_graph<int, int>(gdwg::grid<int, int>(2, 2, 1));
+		CHECK_THROWS_MATCHES(gdwg::parallel_bfs(csr, 9),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::parallel_bfs if src doesn't exist in the "
+		                                    "graph"));
+		CHECK_THROWS_MATCHES(gdwg::parallel_bfs(csr, gdwg::csr_graph<int, int>{}, 0),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::parallel_bfs if reverse isn't the "
+		                                    "transposed graph"));
+	}
+}
@@ -0,0 +1,253 @@
+#include "gdwg/shortest_paths.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+#include "gdwg/heaps.hpp"
+
+#include "graph_fixtures.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+	template<template<typename> class Heap, typename G>
+	auto check_against_reference(gdwg::graph<int, int> const& g, G const& searched) -> void {
+		for (auto src : {0, 17, 99}) {
+			auto const expected = fixtures::reference_distances(g, src);
+			auto const result = gdwg::shortest_paths<Heap>(searched, src);
+			for (auto n = 0; n < static_cast<int>(expected.size()); ++n) {
+				REQUIRE(result.reached(n) == expected[static_cast<std::size_t>(n)].has_value());
+				if (result.reached(n)) {
+					CHECK(result.distance(n) == *expected[static_cast<std::size_t>(n)]);
+				}
+			}
+		}
+	}
+} // namespace
+
+TEST_CASE("shortest_paths() test") {
+	auto const g = fixtures::dijkstra_example<int>();
+
+	SECTION("shortest_paths() distances and paths test") {
+		auto const result = gdwg::shortest_paths(g, 1);
+
+		CHECK(result.source() == 1);
+		CHECK(result.distance(1) == 0);
+		CHECK(result.distance(2) == 7);
+		CHECK(result.distance(3) == 9);
+		CHECK(result.distance(4) == 20);
+		CHECK(result.distance(5) == 20);
+		CHECK(result.distance(6) == 11);
+		CHECK(result.predecessor(1) == std::nullopt);
+		CHECK(result.predecessor(5) == 6);
+		CHECK(result.path_to(5) == std::vector<int>{1, 3, 6, 5});
+	}
+
+	SECTION("shortest_paths() leaves unreachable nodes unreached test") {
+		auto const result = gdwg::shortest_paths(g, 4);
+
+		CHECK(result.reached(5) == true);
+		CHECK(result.reached(1) == false);
+		CHECK(result.path_to(1).empty());
+		CHECK_THROWS_MATCHES(result.distance(1),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::shortest_paths_result<N, E>::distance on "
+		                                    "a node that wasn't reached"));
+	}
+
+	SECTION("shortest_paths() to a target stops early test") {
+		auto const result = gdwg::shortest_paths(g, 1, 3);
+
+		CHECK(result.distance(3) == 9);
+		CHECK(result.path_to(3) == std::vector<int>{1, 3});
+		CHECK(result.reached(5) == false);
+		CHECK(result.reached(4) == false);
+	}
+
+	SECTION("shortest_paths() throws exception test") {
+		CHECK_THROWS_MATCHES(gdwg::shortest_paths(g, 7),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::shortest_paths if src or dst node don't "
+		                                    "exist in the graph"));
+		CHECK_THROWS_MATCHES(gdwg::shortest_paths(g, 1, 7),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::shortest_paths if src or dst node don't "
+		                                    "exist in the graph"));
+
+		auto negative = g;
+		negative.insert_edge(2, 1, -1);
+		CHECK_THROWS_MATCHES(gdwg::shortest_paths(negative, 1),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::shortest_paths on a graph with negative "
+		                                    "weights"));
+	}
+
+	SECTION("shortest_paths() on string nodes and double weights test") {
+		auto s = gdwg::graph<std::string, double>{"a", "b", "c"};
+		s.insert_edge("a", "b", 0.5);
+		s.insert_edge("b", "c", 0.25);
+		s.insert_edge("a", "c", 1.0);
+
+		auto const result = gdwg::shortest_paths<gdwg::pairing_heap>(s, std::string("a"));
+		CHECK(result.distance("c") == 0.75);
+		CHECK(result.path_to("c") == std::vector<std::string>{"a", "b", "c"});
+	}
+}
+
+TEST_CASE("shortest_paths() heaps agree test") {
+	auto const road = gdwg::geometric<int, int>(200, 3, 5, 1000.0);
+	auto const random = gdwg::erdos_renyi<int, int>(200, 600, 5);
+
+	SECTION("binary_heap test") {
+		check_against_reference<gdwg::binary_heap>(road, road);
+		check_against_reference<gdwg::binary_heap>(random, gdwg::csr_graph<int, int>(random));
+	}
+
+	SECTION("pairing_heap test") {
+		check_against_reference<gdwg::pairing_heap>(road, road);
+		check_against_reference<gdwg::pairing_heap>(random, gdwg::csr_graph<int, int>(random));
+	}
+
+	SECTION("radix_heap test") {
+		check_against_reference<gdwg::radix_heap>(road, road);
+		check_against_reference<gdwg::radix_heap>(random, gdwg::csr_graph<int, int>(random));
+	}
+}
+
+TEST_CASE("shortest_path() test") {
+	auto const g = fixtures::dijkstra_example<int>();
+	auto const csr = gdwg::csr_graph<int, int>(g);
+	auto const reverse = csr.transposed();
+	auto const no_estimate = [](int) { return 0; };
+
+	SECTION("shortest_path() distance and path test") {
+		for (auto const& result : {gdwg::shortest_path(g, 1, 5),
+		                           gdwg::shortest_path(csr, 1, 5),
+		                           gdwg::shortest_path(csr, reverse, 1, 5),
+		                           gdwg::shortest_path<gdwg::pairing_heap>(g, 1, 5),
+		                           gdwg::shortest_path(g, 1, 5, no_estimate),
+		                           gdwg::shortest_path(csr, 1, 5, no_estimate)})
+		{
+			REQUIRE(result.found());
+			CHECK(result.distance() == 20);
+			CHECK(result.path() == std::vector<int>{1, 3, 6, 5});
+			CHECK(result.settled() > 0);
+		}
+	}
+
+	SECTION("shortest_path() from a node to itself test") {
+		auto const result = gdwg::shortest_path(g, 3, 3);
+		CHECK(result.distance() == 0);
+		CHECK(result.path() == std::vector<int>{3});
+	}
+
+	SECTION("shortest_path() without a path test") {
+		for (auto const& result : {gdwg::shortest_path(g, 4, 1),
+		                           gdwg::shortest_path(csr, reverse, 4, 1),
+		                           gdwg::shortest_path(csr, 4, 1, no_estimate)})
+		{
+			CHECK(result.found() == false);
+			CHECK(result.path().empty());
+			CHECK_THROWS_MATCHES(result.distance(),
+			                     std::runtime_error,
+			                     Catch::Message("Cannot call gdwg::shortest_path_result<N, E>::distance "
+			                                    "when there is no path"));
+		}
+	}
+
+	SECTION("shortest_path() with an estimate that isn't consistent test") {
+		// The estimate at 2 keeps it behind 3 until 3 has been settled the long way round
+		auto h = gdwg::graph<int, int>{1, 2, 3, 4};
+		h.insert_edge(1, 2, 1);
+		h.insert_edge(1, 3, 4);
+		h.insert_edge(2, 3, 1);
+		h.insert_edge(3, 4, 5);
+		auto const estimate = [](int v) { return v == 2 ? 5 : 0; };
+
+		auto const result = gdwg::shortest_path(h, 1, 4, estimate);
+		CHECK(result.distance() == 7);
+		CHECK(result.path() == std::vector<int>{1, 2, 3, 4});
+	}
+
+	SECTION("shortest_path() on string nodes and double weights test") {
+		auto s = gdwg::graph<std::string, double>{"a", "b", "c"};
+		s.insert_edge("a", "b", 0.5);
+		s.insert_edge("b", "c", 0.25);
+		s.insert_edge("a", "c", 1.0);
+
+		auto const result = gdwg::shortest_path(s, std::string("a"), std::string("c"));
+		CHECK(result.distance() == 0.75);
+		CHECK(result.path() == std::vector<std::string>{"a", "b", "c"});
+	}
+
+	SECTION("shortest_path() throws exception test") {
+		CHECK_THROWS_MATCHES(gdwg::shortest_path(g, 1, 7),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::shortest_path if src or dst node don't "
+		                                    "exist in the graph"));
+		CHECK_THROWS_MATCHES(gdwg::shortest_path(csr, 7, 1, no_estimate),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::shortest_path if src or dst node don't "
+		                                    "exist in the graph"));
+
+		auto negative = g;
+		negative.insert_edge(2, 1, -1);
+		CHECK_THROWS_MATCHES(gdwg::shortest_path(negative, 1, 5),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::shortest_path on a graph with negative "
+		                                    "weights"));
+	}
+}
+
+TEST_CASE("shortest_path() agrees with shortest_paths() test") {
+	auto const points = gdwg::random_points(2000, 8);
+	auto const road = gdwg::geometric<int, int>(points, 3, 1000.0);
+	auto const csr = gdwg::csr_graph<int, int>(road);
+	auto const reverse = csr.transposed();
+
+	// Weights are distances rounded up, so rounding the straight line distance down never
+	// overestimates
+	auto const dst = 1234;
+	auto const straight_line = [&](int v) {
+		auto const& a = points[static_cast<std::size_t>(v)];
+		auto const& b = points[static_cast<std::size_t>(dst)];
+		return static_cast<int>(std::hypot(a.x - b.x, a.y - b.y) * 1000.0);
+	};
+
+	auto settled = std::size_t{0};
+	auto bidirectional_settled = std::size_t{0};
+	auto a_star_settled = std::size_t{0};
+	for (auto src = 0; src < 2000; src += 37) {
+		auto const tree = gdwg::shortest_paths(road, src, dst);
+		for (auto v = 0; v < 2000; ++v)
+			settled += tree.reached(v) ? 1 : 0;
+
+		for (auto const& result : {gdwg::shortest_path(road, src, dst),
+		                           gdwg::shortest_path(csr, reverse, src, dst),
+		                           gdwg::shortest_path(road, src, dst, straight_line)})
+		{
+			REQUIRE(result.found() == tree.reached(dst));
+			if (!result.found())
+				continue;
+			CHECK(result.distance() == tree.distance(dst));
+
+			auto const& path = result.path();
+			REQUIRE(path.front() == src);
+			REQUIRE(path.back() == dst);
+			auto total = 0;
+			for (auto i = std::size_t{1}; i < path.size(); ++i)
+				total += road.weights(path[i - 1], path[i]).front();
+			CHECK(total == result.distance());
+		}
+		bidirectional_settled += gdwg::shortest_path(road, src, dst).settled();
+		a_star_settled += gdwg::shortest_path(road, src, dst, straight_line).settled();
+	}
+	CHECK(bidirectional_settled < settled);
+	CHECK(a_star_settled < settled);
+}
@@ -0,0 +1,103 @@
+#include "gdwg/spanning_forest.hpp"
+
+#include "gdwg/components.hpp"
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+	// Two components: a square 1 2 3 4 with a diagonal, and 5 - 6. 7 is on its own.
+	auto make_graph() -> gdwg::graph<int, int> {
+		auto g = gdwg::graph<int, int>{1, 2, 3, 4, 5, 6, 7};
+		g.insert_edge(1, 2, 4);
+		g.insert_edge(2, 1, 1);
+		g.insert_edge(2, 3, 2);
+		g.insert_edge(3, 4, 6);
+		g.insert_edge(4, 1, 3);
+		g.insert_edge(1, 3, 5);
+		g.insert_edge(1, 3, 9);
+		g.insert_edge(3, 3, 0);
+		g.insert_edge(6, 5, 7);
+		return g;
+	}
+
+	template<typename N, typename E>
+	auto total_weight(gdwg::graph<N, E> const& g) -> E {
+		auto total = E{0};
+		for (auto const& [from, to, weight] : g)
+			total += weight;
+		return total;
+	}
+} // namespace
+
+TEST_CASE("minimum_spanning_forest() test") {
+	auto const g = make_graph();
+	auto expected = gdwg::graph<int, int>{1, 2, 3, 4, 5, 6, 7};
+	expected.insert_edge(2, 1, 1);
+	expected.insert_edge(2, 3, 2);
+	expected.insert_edge(4, 1, 3);
+	expected.insert_edge(6, 5, 7);
+
+	SECTION("minimum_spanning_forest() with Kruskal's algorithm test") {
+		CHECK(gdwg::minimum_spanning_forest(g) == expected);
+		CHECK(gdwg::minimum_spanning_forest(g, gdwg::kruskal) == expected);
+	}
+
+	SECTION("minimum_spanning_forest() with Prim's algorithm test") {
+		CHECK(gdwg::minimum_spanning_forest(g, gdwg::prim) == expected);
+	}
+
+	SECTION("minimum_spanning_edges() returns edges in graph order test") {
+		using edge = gdwg::graph<int, int>::value_type;
+		CHECK(gdwg::minimum_spanning_edges(g, gdwg::prim)
+		      == std::vector<edge>{edge{2, 1, 1}, edge{2, 3, 2}, edge{4, 1, 3}, edge{6, 5, 7}});
+	}
+
+	SECTION("minimum_spanning_forest() algorithms agree on random graphs test") {
+		for (auto seed = 0U; seed < 10; ++seed) {
+			auto const random = gdwg::erdos_renyi<int, int>(60, 150, seed, 20);
+			auto const kruskal_forest = gdwg::minimum_spanning_forest(random, gdwg::kruskal);
+			auto const prim_forest = gdwg::minimum_spanning_forest(random, gdwg::prim);
+			CHECK(total_weight(kruskal_forest) == total_weight(prim_forest));
+
+			// A forest has one edge fewer than nodes in each component, and keeps them apart
+			auto const weak = gdwg::weak_components(random);
+			auto edges = std::size_t{0};
+			for (auto const& [from, to, weight] : kruskal_forest) {
+				CHECK(random.find(from, to, weight) != random.end());
+				++edges;
+			}
+			CHECK(edges == 60 - weak.count());
+			CHECK(gdwg::weak_components(kruskal_forest) == weak);
+			CHECK(gdwg::weak_components(prim_forest) == weak);
+		}
+	}
+
+	SECTION("minimum_spanning_forest() on a grid test") {
+		auto const grid = gdwg::grid<int, double>(10, 10, 3, 1.0);
+		auto const forest = gdwg::minimum_spanning_forest(grid);
+		CHECK(gdwg::weak_components(forest).count() == 1);
+		auto const prim_forest = gdwg::minimum_spanning_forest(grid, gdwg::prim);
+		CHECK(total_weight(forest) == Approx(total_weight(prim_forest)));
+	}
+
+	SECTION("minimum_spanning_forest() on string nodes test") {
+		auto s = gdwg::graph<std::string, double>{"a", "b", "c"};
+		s.insert_edge("a", "b", 2.5);
+		s.insert_edge("c", "b", 0.5);
+		s.insert_edge("a", "c", 1.0);
+		auto const forest = gdwg::minimum_spanning_forest(s);
+		CHECK(forest.is_connected("c", "b"));
+		CHECK(forest.is_connected("a", "c"));
+		CHECK(!forest.is_connected("a", "b"));
+	}
+
+	SECTION("minimum_spanning_forest() on an empty graph test") {
+		CHECK(gdwg::minimum_spanning_forest(gdwg::graph<int, int>{}).empty());
+		CHECK(gdwg::minimum_spanning_edges(gdwg::graph<int, int>{}, gdwg::prim).empty());
+	}
+}
@@ -0,0 +1,196 @@
+#include "gdwg/traversal.hpp"
+
+#include "gdwg/csr_graph.hpp"
+#include "gdwg/generators.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+	// 1 -> 2 -> 4, 1 -> 3 -> 4 -> 5, 3 -> 1, and 6 on its own
+	template<typename N = int>
+	auto make_graph() -> gdwg::graph<N, int> {
+		auto node = [](int n) {
+			if constexpr (std::is_same_v<N, std::string>)
+				return std::to_string(n);
+			else
+				return n;
+		};
+		auto g = gdwg::graph<N, int>{node(1), node(2), node(3), node(4), node(5), node(6)};
+		g.insert_edge(node(1), node(2), 1);
+		g.insert_edge(node(1), node(3), 1);
+		g.insert_edge(node(2), node(4), 1);
+		g.insert_edge(node(3), node(1), 1);
+		g.insert_edge(node(3), node(4), 2);
+		g.insert_edge(node(3), node(4), 1);
+		g.insert_edge(node(4), node(5), 1);
+		return g;
+	}
+
+	template<typename T>
+	auto text(T const& value) -> std::string {
+		auto os = std::ostringstream{};
+		os << value;
+		return os.str();
+	}
+
+	// Writes down every hook call, so that tests can check their order
+	struct recorder {
+		std::vector<std::string> events;
+
+		template<typename N>
+		auto discover(N const& n) -> void {
+			events.push_back("d" + text(n));
+		}
+		template<typename N>
+		auto examine_edge(N const& from, N const& to, int weight) -> void {
+			events.push_back("e" + text(from) + text(to) + text(weight));
+		}
+		template<typename N>
+		auto tree_edge(N const& from, N const& to, int) -> void {
+			events.push_back("t" + text(from) + text(to));
+		}
+		template<typename N>
+		auto finish(N const& n) -> void {
+			events.push_back("f" + text(n));
+		}
+	};
+
+	struct discovered {
+		std::vector<int> nodes;
+
+		auto discover(int n) -> void {
+			nodes.push_back(n);
+		}
+	};
+} // namespace
+
+TEST_CASE("bfs() test") {
+	auto const g = make_graph();
+
+	SECTION("bfs() hook order test") {
+		auto vis = recorder{};
+		gdwg::bfs(g, 1, vis);
+		CHECK(vis.events
+		      == std::vector<std::string>{"d1", "e121", "t12", "d2", "e131", "t13", "d3", "f1",
+		                                  "e241", "t24", "d4", "f2", "e311", "e341", "e342", "f3",
+		                                  "e451", "t45", "d5", "f4", "f5"});
+	}
+
+	SECTION("bfs() only visits reachable nodes test") {
+		auto vis = discovered{};
+		gdwg::bfs(g, 4, vis);
+		CHECK(vis.nodes == std::vector<int>{4, 5});
+	}
+
+	SECTION("bfs() stops when a hook returns false test") {
+		struct find_four {
+			std::vector<int> nodes;
+			auto discover(int n) -> bool {
+				nodes.push_back(n);
+				return n != 4;
+			}
+		};
+		auto vis = find_four{};
+		gdwg::bfs(g, 1, vis);
+		CHECK(vis.nodes == std::vector<int>{1, 2, 3, 4});
+	}
+
+	SECTION("bfs() on a csr_graph visits the same way test") {
+		auto vis = recorder{};
+		gdwg::bfs(g, 1, vis);
+		auto csr_vis = recorder{};
+		gdwg::bfs(gdwg::csr_graph<int, int>(g), 1, csr_vis);
+		CHECK(csr_vis.events == vis.events);
+	}
+
+	SECTION("bfs() on string nodes visits the same way test") {
+		auto vis = recorder{};
+		gdwg::bfs(g, 3, vis);
+		auto string_vis = recorder{};
+		gdwg::bfs(make_graph<std::string>(), std::string("3"), string_vis);
+		CHECK(string_vis.events == vis.events);
+	}
+
+	SECTION("bfs() throws exception test") {
+		CHECK_THROWS_MATCHES(gdwg::bfs(g, 7, discovered{}),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::bfs if src doesn't exist in the graph"));
+	}
+}
+
+TEST_CASE("dfs() test") {
+	auto const g = make_graph();
+
+	SECTION("dfs() hook order test") {
+		auto vis = recorder{};
+		gdwg::dfs(g, 1, vis);
+		CHECK(vis.events
+		      == std::vector<std::string>{"d1", "e121", "t12", "d2", "e241", "t24", "d4", "e451",
+		                                  "t45", "d5", "f5", "f4", "f2", "e131", "t13", "d3",
+		                                  "e311", "e341", "e342", "f3", "f1"});
+	}
+
+	SECTION("dfs() stops when a hook returns false test") {
+		struct stop_at_finish {
+			std::vector<int> finished;
+			auto finish(int n) -> bool {
+				finished.push_back(n);
+				return n != 4;
+			}
+		};
+		auto vis = stop_at_finish{};
+		gdwg::dfs(g, 1, vis);
+		CHECK(vis.finished == std::vector<int>{5, 4});
+	}
+
+	SECTION("dfs() on a csr_graph visits the same way test") {
+		auto vis = recorder{};
+		gdwg::dfs(g, 3, vis);
+		auto csr_vis = recorder{};
+		gdwg::dfs(gdwg::csr_graph<int, int>(g), 3, csr_vis);
+		CHECK(csr_vis.events == vis.events);
+	}
+
+	SECTION("dfs() on string nodes visits the same way test") {
+		auto vis = recorder{};
+		gdwg::dfs(g, 3, vis);
+		auto string_vis = recorder{};
+		gdwg::dfs(make_graph<std::string>(), std::string("3"), string_vis);
+		CHECK(string_vis.events == vis.events);
+	}
+
+	SECTION("dfs() follows long paths without recursion test") {
+		auto path = gdwg::grid<int, int>(1, 200000, 1);
+		auto vis = discovered{};
+		gdwg::dfs(path, 0, vis);
+		CHECK(vis.nodes.size() == 200000);
+		CHECK(vis.nodes.back() == 199999);
+	}
+
+	SECTION("dfs() on string nodes test") {
+		auto s = gdwg::graph<std::string, std::string>{"a", "b", "c"};
+		s.insert_edge("a", "c", "x");
+		s.insert_edge("c", "b", "y");
+
+		struct tree {
+			std::vector<std::string> weights;
+			auto tree_edge(std::string const&, std::string const&, std::string const& w) -> void {
+				weights.push_back(w);
+			}
+		};
+		auto vis = tree{};
+		gdwg::dfs(s, std::string("a"), vis);
+		CHECK(vis.weights == std::vector<std::string>{"x", "y"});
+	}
+
+	SECTION("dfs() throws exception test") {
+		CHECK_THROWS_MATCHES(gdwg::dfs(g, 0, discovered{}),
+		                     std::runtime_error,
+		                     Catch::Message("Cannot call gdwg::dfs if src doesn't exist in the graph"));
+	}
+}